@@ -0,0 +1,129 @@
+#ifndef BENCHMARK_HELPERS_HPP
+#define BENCHMARK_HELPERS_HPP
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_get_random_seed.hpp>
+
+// Number of vectors processed by every measured run. Large enough to leave the
+// L1 cache, so the numbers reflect batched throughput and not a single operation.
+inline constexpr std::size_t BENCHMARK_BATCH_SIZE = 1 << 14;
+
+template <typename T>
+[[nodiscard]] std::string typeName() {
+    if constexpr (std::is_same_v<T, int>)
+        return "int";
+    else if constexpr (std::is_same_v<T, float>)
+        return "float";
+    else if constexpr (std::is_same_v<T, double>)
+        return "double";
+    else
+        return "unknown";
+}
+
+// Seeded from the Catch2 seed (--rng-seed) so runs can be reproduced
+[[nodiscard]] inline std::mt19937 & benchmarkRng() {
+    static std::mt19937 rng{Catch::getSeed()};
+    return rng;
+}
+
+// Random non zero value in [-100, 100], small enough that integer dot products never overflow
+template <typename T>
+[[nodiscard]] T randomValue() {
+    T value{};
+    while(value == T{})
+    {
+        if constexpr (std::is_integral_v<T>)
+            value = std::uniform_int_distribution<T>{-100, 100}(benchmarkRng());
+        else
+            value = std::uniform_real_distribution<T>{-100, 100}(benchmarkRng());
+    }
+    return value;
+}
+
+// SET(vector, index, value) writes one component, so both Vector and VectorTuple can be filled
+template <typename VECTOR, std::size_t SIZE, typename SET>
+[[nodiscard]] std::vector<VECTOR> randomVectors(std::size_t count, SET set) {
+    using T = typename VECTOR::value_type;
+    std::vector<VECTOR> result(count);
+    for(auto & vector : result)
+    {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (set(vector, std::integral_constant<std::size_t, Is>{}, randomValue<T>()), ...);
+        }(std::make_index_sequence<SIZE>());
+    }
+    return result;
+}
+
+// Registers one benchmark per operator, all of them over the same random batch.
+// The results are written to memory the optimizer has to assume is read, so no
+// operation can be folded away.
+template <typename VECTOR>
+void benchmarkOperators(const std::string & name, const std::vector<VECTOR> & lhs, const std::vector<VECTOR> & rhs) {
+    using T = typename VECTOR::value_type;
+    using Catch::Benchmark::Chronometer;
+    using Catch::Benchmark::keep_memory;
+
+    const T scalar = randomValue<T>();
+    std::vector<VECTOR> out(lhs.size());
+    std::vector<T> values(lhs.size());
+    std::vector<float> angles(lhs.size());
+    std::vector<char> equal(lhs.size());
+
+    BENCHMARK_ADVANCED(name + " a + b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = lhs[i] + rhs[i]; keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a - b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = lhs[i] - rhs[i]; keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " -a")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = -lhs[i]; keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a * s")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = lhs[i] * scalar; keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a / s")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = lhs[i] / scalar; keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a * b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < values.size(); ++i) values[i] = lhs[i] * rhs[i]; keep_memory(values.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a += b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i]; out[i] += rhs[i]; } keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a -= b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i]; out[i] -= rhs[i]; } keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a *= s")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i]; out[i] *= scalar; } keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a /= s")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i]; out[i] /= scalar; } keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a == b")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < equal.size(); ++i) equal[i] = lhs[i] == rhs[i]; keep_memory(equal.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " lengthSquared")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < values.size(); ++i) values[i] = lhs[i].lengthSquared(); keep_memory(values.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " length")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < values.size(); ++i) values[i] = lhs[i].length(); keep_memory(values.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " normalize")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) { out[i] = lhs[i]; out[i].normalize(); } keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " normalized")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < out.size(); ++i) out[i] = lhs[i].normalized(); keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " angle")(Chronometer meter) {
+        meter.measure([&]{ for(std::size_t i = 0; i < angles.size(); ++i) angles[i] = lhs[i].angle(rhs[i]); keep_memory(angles.data()); });
+    };
+}
+
+#endif // BENCHMARK_HELPERS_HPP
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/AabbTree.hpp"
+#include "../src/SweepAndPrune.hpp"
+
+namespace
+{
+    // Spheres of radius 0.5 moving through a box with one sphere per 8 units of volume,
+    // bouncing off the walls. Each frame moves them by at most 0.05.
+    class MovingSpheres {
+    public:
+        explicit MovingSpheres(std::size_t count) :
+            m_extent{2.f * std::cbrt(static_cast<float>(count))},
+            m_positions(count),
+            m_velocities(count),
+            m_boxes(count) {
+            std::uniform_real_distribution<float> position{0.f, m_extent};
+            std::uniform_real_distribution<float> velocity{-0.05f, 0.05f};
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                m_positions[i] = {position(benchmarkRng()), position(benchmarkRng()), position(benchmarkRng())};
+                m_velocities[i] = {velocity(benchmarkRng()), velocity(benchmarkRng()), velocity(benchmarkRng())};
+            }
+            step();
+        }
+
+        void step() noexcept {
+            for(std::size_t i = 0; i < m_positions.size(); ++i)
+            {
+                m_positions[i] += m_velocities[i];
+                for(std::size_t c = 0; c < 3; ++c)
+                {
+                    if(m_positions[i][c] < 0.f || m_positions[i][c] > m_extent)
+                    {
+                        m_velocities[i][c] = -m_velocities[i][c];
+                    }
+                }
+                m_boxes[i] = Aabb3f::around(m_positions[i], 0.5f);
+            }
+        }
+
+        [[nodiscard]] const std::vector<Aabb3f> & boxes() const noexcept {
+            return m_boxes;
+        }
+
+    private:
+        float m_extent;
+        std::vector<Vector3f> m_positions;
+        std::vector<Vector3f> m_velocities;
+        std::vector<Aabb3f> m_boxes;
+    };
+
+    // One simulation frame per run: move, update the broad phase and find the pairs.
+    // The moving alone is measured too, to subtract it.
+    void benchmarkBroadPhase(std::size_t count)
+    {
+        using Catch::Benchmark::Chronometer;
+        using Catch::Benchmark::keep_memory;
+
+        MovingSpheres spheres(count);
+        SweepAndPrune<float, 3> sweep_and_prune;
+        sweep_and_prune.update(spheres.boxes());
+        AabbTree<float, 3> tree(0.2f);
+        tree.update(spheres.boxes());
+        std::vector<CollisionPair> pairs;
+        const std::string name = std::to_string(count) + " bodies";
+
+        BENCHMARK_ADVANCED(name + " move")(Chronometer meter) {
+            meter.measure([&]{ spheres.step(); keep_memory(&spheres); });
+        };
+        if(count <= 20'000)
+        {
+            BENCHMARK_ADVANCED(name + " brute force")(Chronometer meter) {
+                meter.measure([&]{
+                    spheres.step();
+                    bruteForcePairs<float, 3>(spheres.boxes(), pairs);
+                    keep_memory(&pairs);
+                });
+            };
+        }
+        BENCHMARK_ADVANCED(name + " SweepAndPrune")(Chronometer meter) {
+            meter.measure([&]{
+                spheres.step();
+                sweep_and_prune.update(spheres.boxes());
+                sweep_and_prune.findPairs(pairs);
+                keep_memory(&pairs);
+            });
+        };
+        BENCHMARK_ADVANCED(name + " AabbTree")(Chronometer meter) {
+            meter.measure([&]{
+                spheres.step();
+                tree.update(spheres.boxes());
+                tree.findPairs(pairs);
+                keep_memory(&pairs);
+            });
+        };
+    }
+}
+
+TEST_CASE("Benchmark Broad Phase", "[benchmark][BroadPhase]") {
+    for(const std::size_t count : {std::size_t{1'000}, std::size_t{20'000}, std::size_t{100'000}})
+    {
+        benchmarkBroadPhase(count);
+    }
+}
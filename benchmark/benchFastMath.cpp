@@ -0,0 +1,86 @@
+#include <cmath>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/VectorArray.hpp"
+
+namespace
+{
+    std::vector<float> uniformFloats(std::size_t count, float low, float high)
+    {
+        std::uniform_real_distribution<float> distribution{low, high};
+        std::vector<float> values(count);
+        for(auto & value : values)
+        {
+            value = distribution(benchmarkRng());
+        }
+        return values;
+    }
+
+    // One benchmark per Precision of a batch function
+    template <typename FUNCTION>
+    void benchmarkPrecisions(const std::string & name, FUNCTION function)
+    {
+        using Catch::Benchmark::Chronometer;
+
+        BENCHMARK_ADVANCED(name + " exact")(Chronometer meter) {
+            meter.measure([&]{ function(std::integral_constant<math::Precision, math::Precision::exact>()); });
+        };
+        BENCHMARK_ADVANCED(name + " fast")(Chronometer meter) {
+            meter.measure([&]{ function(std::integral_constant<math::Precision, math::Precision::fast>()); });
+        };
+    }
+}
+
+TEST_CASE("Benchmark FastMath", "[benchmark][FastMath]") {
+    using Catch::Benchmark::keep_memory;
+
+    const std::vector<float> cosines = uniformFloats(BENCHMARK_BATCH_SIZE, -1.f, 1.f);
+    const std::vector<float> angles = uniformFloats(BENCHMARK_BATCH_SIZE, -10.f, 10.f);
+    const std::vector<float> positives = uniformFloats(BENCHMARK_BATCH_SIZE, 0.f, 100.f);
+    std::vector<float> out(BENCHMARK_BATCH_SIZE);
+
+    benchmarkPrecisions("rsqrt", [&](auto precision){ math::rsqrt<precision()>(positives, out); keep_memory(out.data()); });
+    benchmarkPrecisions("acos", [&](auto precision){ math::acos<precision()>(cosines, out); keep_memory(out.data()); });
+    benchmarkPrecisions("atan2", [&](auto precision){ math::atan2<precision()>(cosines, angles, out); keep_memory(out.data()); });
+    benchmarkPrecisions("sin", [&](auto precision){ math::sin<precision()>(angles, out); keep_memory(out.data()); });
+    benchmarkPrecisions("cos", [&](auto precision){ math::cos<precision()>(angles, out); keep_memory(out.data()); });
+}
+
+// Normalizing and measuring angles of 1M vectors, stored as Vector and as VectorArray
+TEST_CASE("Benchmark Bulk Normalize", "[benchmark][FastMath]") {
+    using Catch::Benchmark::keep_memory;
+
+    constexpr std::size_t COUNT = 1 << 20;
+    auto set = [](Vector3f & vector, auto index, float value){ vector[index] = value; };
+    const std::vector<Vector3f> vectors = randomVectors<Vector3f, 3>(COUNT, set);
+    const std::vector<Vector3f> others = randomVectors<Vector3f, 3>(COUNT, set);
+    const VectorArray3f array(vectors);
+    const VectorArray3f other_array(others);
+    // Normalized again and again, which costs the same as the first time
+    std::vector<Vector3f> normalized = vectors;
+    VectorArray3f normalized_array = array;
+    std::vector<float> out(COUNT);
+
+    benchmarkPrecisions("normalizeVectors", [&](auto precision){
+        normalizeVectors<precision()>(normalized);
+        keep_memory(normalized.data());
+    });
+    benchmarkPrecisions("VectorArray normalize", [&](auto precision){
+        normalized_array.normalize<precision()>();
+        keep_memory(normalized_array.lane(0).data());
+    });
+    benchmarkPrecisions("vectorAngles", [&](auto precision){
+        vectorAngles<precision()>(vectors, others, out);
+        keep_memory(out.data());
+    });
+    benchmarkPrecisions("VectorArray angle", [&](auto precision){
+        array.angle<precision()>(other_array, std::span(out));
+        keep_memory(out.data());
+    });
+}
@@ -0,0 +1,74 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Math.hpp"
+
+// Validating 1M results against a reference where everything matches, so every
+// element is compared: a loop with early reporting like a hand written check, the
+// same loop with is_close, and all_close
+TEST_CASE("Benchmark AllClose", "[benchmark][Math]") {
+    using Catch::Benchmark::Chronometer;
+
+    constexpr std::size_t COUNT = 1 << 20;
+    auto set = [](Vector3f & vector, auto index, float value){ vector[index] = value; };
+    const std::vector<Vector3f> vectors = randomVectors<Vector3f, 3>(COUNT, set);
+    const std::vector<Vector3f> vector_copies = vectors;
+    std::vector<float> values(COUNT);
+    for(std::size_t i = 0; i < COUNT; ++i)
+    {
+        values[i] = vectors[i][0];
+    }
+    const std::vector<float> copies = values;
+    const Tolerance<float> tolerance{.absolute = 1e-6f, .relative = 1e-5f};
+
+    BENCHMARK_ADVANCED("floats loop")(Chronometer meter) {
+        meter.measure([&]{
+            std::vector<std::size_t> mismatches;
+            for(std::size_t i = 0; i < values.size(); ++i)
+            {
+                const float difference = std::abs(values[i] - copies[i]);
+                if(!(difference <= tolerance.absolute || difference <= tolerance.relative * std::max(std::abs(values[i]), std::abs(copies[i]))))
+                {
+                    mismatches.push_back(i);
+                }
+            }
+            return mismatches.size();
+        });
+    };
+    BENCHMARK_ADVANCED("floats is_close loop")(Chronometer meter) {
+        meter.measure([&]{
+            std::vector<std::size_t> mismatches;
+            for(std::size_t i = 0; i < values.size(); ++i)
+            {
+                if(!is_close(values[i], copies[i], tolerance))
+                {
+                    mismatches.push_back(i);
+                }
+            }
+            return mismatches.size();
+        });
+    };
+    BENCHMARK_ADVANCED("floats all_close")(Chronometer meter) {
+        meter.measure([&]{ return all_close(values, copies, tolerance).mismatches; });
+    };
+    BENCHMARK_ADVANCED("Vector3f is_close loop")(Chronometer meter) {
+        meter.measure([&]{
+            std::vector<std::size_t> mismatches;
+            for(std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                if(!is_close(vectors[i], vector_copies[i], tolerance))
+                {
+                    mismatches.push_back(i);
+                }
+            }
+            return mismatches.size();
+        });
+    };
+    BENCHMARK_ADVANCED("Vector3f all_close")(Chronometer meter) {
+        meter.measure([&]{ return all_close(vectors, vector_copies, tolerance).mismatches; });
+    };
+}
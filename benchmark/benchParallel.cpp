@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Vector.hpp"
+#include "../src/ecs/DenseSlotMap.hpp"
+#include "../src/ecs/ParallelForEach.hpp"
+
+namespace
+{
+    struct Particle
+    {
+        Vector3f position;
+        Vector3f velocity;
+    };
+
+    [[nodiscard]] std::vector<std::size_t> threadCounts()
+    {
+        std::vector<std::size_t> result;
+        const std::size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+        for(std::size_t threads = 1; threads < hardware; threads *= 2)
+        {
+            result.push_back(threads);
+        }
+        result.push_back(hardware);
+        return result;
+    }
+}
+
+TEST_CASE("Benchmark Parallel For Each", "[benchmark][Parallel]") {
+    constexpr std::size_t ENTITY_COUNT = 1'000'000;
+    DenseSlotMap<Particle> particles;
+    particles.reserve(ENTITY_COUNT);
+    for(std::size_t i = 0; i < ENTITY_COUNT; ++i)
+    {
+        std::ignore = particles.insert({
+            Vector3f{randomValue<float>(), randomValue<float>(), randomValue<float>()},
+            Vector3f{randomValue<float>(), randomValue<float>(), randomValue<float>()}
+        });
+    }
+
+    for(const auto threads : threadCounts())
+    {
+        juan::ThreadPool pool(threads);
+        const std::string suffix = " " + std::to_string(threads) + " threads";
+
+        BENCHMARK("parallelForEach integrate 1M" + suffix) {
+            parallelForEach(pool, particles, [](Particle & particle){
+                particle.position += particle.velocity * 0.001f;
+            });
+            return particles.data()[0].position;
+        };
+        BENCHMARK("parallelReduce deterministic 1M" + suffix) {
+            return parallelReduce(pool, particles, 0.f, [](const Particle & particle){ return particle.velocity.lengthSquared(); }, std::plus<>());
+        };
+        BENCHMARK("parallelReduce unordered 1M" + suffix) {
+            return parallelReduce(pool, particles, 0.f, [](const Particle & particle){ return particle.velocity.lengthSquared(); }, std::plus<>(), juan::Reduction::Unordered);
+        };
+    }
+}
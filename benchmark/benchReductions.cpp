@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Reductions.hpp"
+
+// Reductions of 1M Vector3f against the loops they replace, and with a thread pool
+TEST_CASE("Benchmark Vector Reductions", "[benchmark][Reductions]") {
+    constexpr std::size_t COUNT = 1 << 20;
+    auto set = [](Vector3f & vector, auto index, float value){ vector[index] = value; };
+    const std::vector<Vector3f> points = randomVectors<Vector3f, 3>(COUNT, set);
+
+    BENCHMARK("sum loop") {
+        Vector3f sum(0.f);
+        for(const auto & point : points)
+        {
+            sum += point;
+        }
+        return sum;
+    };
+    BENCHMARK("vectorSum simple") {
+        return vectorSum<Summation::simple>(points);
+    };
+    BENCHMARK("vectorSum pairwise") {
+        return vectorSum<Summation::pairwise>(points);
+    };
+    BENCHMARK("vectorSum kahan") {
+        return vectorSum<Summation::kahan>(points);
+    };
+    BENCHMARK("squared lengths loop") {
+        float sum = 0.f;
+        for(const auto & point : points)
+        {
+            sum += point.lengthSquared();
+        }
+        return sum;
+    };
+    BENCHMARK("vectorDotSum") {
+        return vectorDotSum(points, points);
+    };
+    BENCHMARK("bounds loop") {
+        Aabb3f bounds = Aabb3f::inverted();
+        for(const auto & point : points)
+        {
+            bounds = bounds.merged(point);
+        }
+        return bounds;
+    };
+    BENCHMARK("vectorBounds") {
+        return vectorBounds(points);
+    };
+    BENCHMARK("covariance loop") {
+        Vector3f mean(0.f);
+        for(const auto & point : points)
+        {
+            mean += point;
+        }
+        mean /= static_cast<float>(points.size());
+        Matrix3f covariance;
+        for(const auto & point : points)
+        {
+            const Vector3f centered = point - mean;
+            for(std::size_t r = 0; r < 3; ++r)
+            {
+                for(std::size_t c = 0; c < 3; ++c)
+                {
+                    covariance(r, c) += centered[r] * centered[c];
+                }
+            }
+        }
+        return covariance;
+    };
+    BENCHMARK("vectorCovariance") {
+        return vectorCovariance(points);
+    };
+
+    const std::size_t hardware = std::max(1U, std::thread::hardware_concurrency());
+    for(std::size_t threads = 1; threads <= hardware; threads *= 2)
+    {
+        juan::ThreadPool pool(threads);
+        const std::string suffix = " " + std::to_string(threads) + " threads";
+        BENCHMARK("vectorSum pairwise" + suffix) {
+            return vectorSum(pool, points);
+        };
+        BENCHMARK("vectorBounds" + suffix) {
+            return vectorBounds(pool, points);
+        };
+        BENCHMARK("vectorCovariance" + suffix) {
+            return vectorCovariance(pool, points);
+        };
+    }
+}
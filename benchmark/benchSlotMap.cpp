@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <numeric>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Vector.hpp"
+#include "../src/ecs/DenseSlotMap.hpp"
+#include "../src/ecs/SlotMap.hpp"
+#include "../src/ecs/UnorderedMapSlotMap.hpp"
+
+namespace
+{
+    constexpr std::size_t ENTITY_COUNT = 100'000;
+
+    struct Position
+    {
+        Vector3f value;
+    };
+
+    struct Velocity
+    {
+        Vector3f value;
+    };
+
+    template <typename MAP>
+    [[nodiscard]] auto fill(MAP & map) {
+        std::vector<typename MAP::key_type> keys;
+        keys.reserve(ENTITY_COUNT);
+        for(std::size_t i = 0; i < ENTITY_COUNT; ++i)
+        {
+            keys.push_back(map.insert(Vector3f{randomValue<float>(), randomValue<float>(), randomValue<float>()}));
+        }
+        std::shuffle(keys.begin(), keys.end(), benchmarkRng());
+        return keys;
+    }
+}
+
+TEST_CASE("Benchmark DenseSlotMap", "[benchmark][SlotMap]") {
+    using Catch::Benchmark::Chronometer;
+    DenseSlotMap<Vector3f> map;
+    const auto keys = fill(map);
+
+    BENCHMARK("DenseSlotMap iterate") {
+        return std::accumulate(map.begin(), map.end(), Vector3f{0.f}, std::plus<>());
+    };
+    BENCHMARK("DenseSlotMap get") {
+        Vector3f sum{0.f};
+        for(const auto & key : keys)
+        {
+            sum += map.get(key);
+        }
+        return sum;
+    };
+    BENCHMARK_ADVANCED("DenseSlotMap insert and erase")(Chronometer meter) {
+        DenseSlotMap<Vector3f> scratch;
+        auto scratch_keys = fill(scratch);
+        meter.measure([&]{
+            for(auto & key : scratch_keys)
+            {
+                scratch.erase(key);
+                key = scratch.insert(Vector3f{1.f});
+            }
+            return scratch.size();
+        });
+    };
+}
+
+TEST_CASE("Benchmark UnorderedMapSlotMap", "[benchmark][SlotMap]") {
+    using Catch::Benchmark::Chronometer;
+    UnorderedMapSlotMap<Vector3f> map;
+    const auto keys = fill(map);
+
+    BENCHMARK("UnorderedMapSlotMap iterate") {
+        Vector3f sum{0.f};
+        for(const auto & [key, value] : map)
+        {
+            sum += value;
+        }
+        return sum;
+    };
+    BENCHMARK("UnorderedMapSlotMap get") {
+        Vector3f sum{0.f};
+        for(const auto & key : keys)
+        {
+            sum += map.get(key);
+        }
+        return sum;
+    };
+    BENCHMARK_ADVANCED("UnorderedMapSlotMap insert and erase")(Chronometer meter) {
+        auto scratch_keys = keys;
+        meter.measure([&]{
+            for(auto & key : scratch_keys)
+            {
+                map.erase(key);
+                key = map.insert(Vector3f{1.f});
+            }
+            return map.size();
+        });
+    };
+}
+
+TEST_CASE("Benchmark SlotMap Each", "[benchmark][SlotMap]") {
+    DenseSlotMapWorld<Position, Velocity> world;
+    auto & positions = world.get<Position>();
+    auto & velocities = world.get<Velocity>();
+    std::vector<DenseSlotMapWorld<Position, Velocity>::key_type> keys;
+    for(std::size_t i = 0; i < ENTITY_COUNT; ++i)
+    {
+        keys.push_back(world.create());
+        world.insert(keys.back(), Position{Vector3f{randomValue<float>(), randomValue<float>(), randomValue<float>()}});
+        world.insert(keys.back(), Velocity{Vector3f{randomValue<float>(), randomValue<float>(), randomValue<float>()}});
+    }
+    // A tenth of the entities are static
+    std::shuffle(keys.begin(), keys.end(), benchmarkRng());
+    for(std::size_t i = 0; i < ENTITY_COUNT / 10; ++i)
+    {
+        velocities.erase(keys[i]);
+    }
+
+    BENCHMARK("SlotMap lookup per entity") {
+        for(std::size_t i = 0; i < positions.size(); ++i)
+        {
+            if(auto * velocity = velocities.find(positions.keyAt(i)))
+            {
+                positions.data()[i].value += velocity->value * 0.01f;
+            }
+        }
+        return positions.data()[0].value;
+    };
+    BENCHMARK("SlotMap each<Position, Velocity>") {
+        world.each<Position, Velocity>([](Position & position, const Velocity & velocity){
+            position.value += velocity.value * 0.01f;
+        });
+        return positions.data()[0].value;
+    };
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/KdTree.hpp"
+#include "../src/UniformGrid.hpp"
+
+namespace
+{
+    // Uniform points with one point per unit of volume, so the neighborhoods do not
+    // depend on the count: a radius of 1.5 holds about 14 points
+    std::vector<Vector3f> uniformPoints(std::size_t count, float extent)
+    {
+        std::uniform_real_distribution<float> distribution{0.f, extent};
+        std::vector<Vector3f> points(count);
+        for(auto & point : points)
+        {
+            point = {distribution(benchmarkRng()), distribution(benchmarkRng()), distribution(benchmarkRng())};
+        }
+        return points;
+    }
+
+    // Batches of 256 nearest neighbor (k = 8) and radius queries: brute force, uniform
+    // grid and k-d tree, sequential and on a thread pool, plus building the indexes
+    void benchmarkSpatialIndex(std::size_t count)
+    {
+        using Catch::Benchmark::Chronometer;
+        using Catch::Benchmark::keep_memory;
+
+        constexpr std::size_t K = 8;
+        constexpr float RADIUS = 1.5f;
+        const float extent = std::cbrt(static_cast<float>(count));
+        const std::vector<Vector3f> points = uniformPoints(count, extent);
+        const std::vector<Vector3f> centers = uniformPoints(256, extent);
+        const KdTree<float, 3> tree(points);
+        UniformGrid<float, 3> grid(1.f);
+        grid.update(points);
+        juan::ThreadPool pool;
+        SpatialQueryResults results;
+        const std::string name = std::to_string(count) + " points";
+
+        BENCHMARK_ADVANCED(name + " brute force nearest")(Chronometer meter) {
+            meter.measure([&]{
+                results.run(centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ bruteForceNearest<float, 3>(points, centers[i], K, out); });
+                keep_memory(&results);
+            });
+        };
+        BENCHMARK_ADVANCED(name + " UniformGrid nearest")(Chronometer meter) {
+            meter.measure([&]{ grid.nearest(centers, K, results); keep_memory(&results); });
+        };
+        BENCHMARK_ADVANCED(name + " KdTree nearest")(Chronometer meter) {
+            meter.measure([&]{ tree.nearest(centers, K, results); keep_memory(&results); });
+        };
+        BENCHMARK_ADVANCED(name + " KdTree nearest ThreadPool")(Chronometer meter) {
+            meter.measure([&]{ tree.nearest(pool, centers, K, results); keep_memory(&results); });
+        };
+        BENCHMARK_ADVANCED(name + " brute force radius")(Chronometer meter) {
+            meter.measure([&]{
+                results.run(centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ bruteForceRadius<float, 3>(points, centers[i], RADIUS, out); });
+                keep_memory(&results);
+            });
+        };
+        BENCHMARK_ADVANCED(name + " UniformGrid radius")(Chronometer meter) {
+            meter.measure([&]{ grid.radius(centers, RADIUS, results); keep_memory(&results); });
+        };
+        BENCHMARK_ADVANCED(name + " KdTree radius")(Chronometer meter) {
+            meter.measure([&]{ tree.radius(centers, RADIUS, results); keep_memory(&results); });
+        };
+        BENCHMARK_ADVANCED(name + " KdTree build")(Chronometer meter) {
+            meter.measure([&]{ const KdTree<float, 3> built(points); return built.size(); });
+        };
+        BENCHMARK_ADVANCED(name + " UniformGrid update")(Chronometer meter) {
+            meter.measure([&]{ grid.update(points); keep_memory(&grid); });
+        };
+    }
+}
+
+TEST_CASE("Benchmark Spatial Index", "[benchmark][Spatial]") {
+    for(const std::size_t count : {std::size_t{10'000}, std::size_t{100'000}, std::size_t{1'000'000}})
+    {
+        benchmarkSpatialIndex(count);
+    }
+}
+
+// Hidden, run it by name: ./CppUtilsBenchmark "Benchmark Spatial Index 10M"
+TEST_CASE("Benchmark Spatial Index 10M", "[.][benchmark][Spatial]") {
+    benchmarkSpatialIndex(10'000'000);
+}
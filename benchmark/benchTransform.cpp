@@ -0,0 +1,57 @@
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Quaternion.hpp"
+
+// Affine transform of many points: one matrix product per point in a loop, the
+// batched array of structures version and the batched structure of arrays version
+template <typename T>
+void benchmarkTransform() {
+    using Catch::Benchmark::Chronometer;
+    using Catch::Benchmark::keep_memory;
+    using vector_type = Vector<T, 3>;
+
+    auto set = [](vector_type & vector, auto index, T value){ vector[index] = value; };
+    const std::vector<vector_type> points = randomVectors<vector_type, 3>(BENCHMARK_BATCH_SIZE, set);
+    const VectorArray<T, 3> array(points);
+    const auto rotation = Quaternion<T>::fromAxisAngle(vector_type{T{0}, static_cast<T>(0.6), static_cast<T>(0.8)}, static_cast<T>(0.3));
+    const auto matrix = Matrix4<T>::translation({randomValue<T>(), randomValue<T>(), randomValue<T>()}) * rotation.toMatrix4();
+    std::vector<vector_type> out(points.size());
+    VectorArray<T, 3> array_out;
+    const std::string name = "Matrix4<" + typeName<T>() + ">";
+
+    BENCHMARK_ADVANCED(name + " homogeneous product per point")(Chronometer meter) {
+        meter.measure([&]{
+            for(std::size_t i = 0; i < points.size(); ++i)
+            {
+                const auto result = matrix * Vector<T, 4>{points[i][0], points[i][1], points[i][2], T{1}};
+                out[i] = vector_type{result[0], result[1], result[2]};
+            }
+            keep_memory(out.data());
+        });
+    };
+    BENCHMARK_ADVANCED(name + " transformPoints span")(Chronometer meter) {
+        meter.measure([&]{ transformPoints(matrix, points, out); keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED(name + " transformPoints VectorArray")(Chronometer meter) {
+        meter.measure([&]{ transformPoints(matrix, array, array_out); keep_memory(array_out.lane(0).data()); });
+    };
+    BENCHMARK_ADVANCED("Quaternion<" + typeName<T>() + "> rotate per point")(Chronometer meter) {
+        meter.measure([&]{
+            for(std::size_t i = 0; i < points.size(); ++i)
+            {
+                out[i] = rotation.rotate(points[i]);
+            }
+            keep_memory(out.data());
+        });
+    };
+    BENCHMARK_ADVANCED("Quaternion<" + typeName<T>() + "> rotate VectorArray")(Chronometer meter) {
+        meter.measure([&]{ rotate(rotation, array, array_out); keep_memory(array_out.lane(0).data()); });
+    };
+}
+
+TEMPLATE_TEST_CASE("Benchmark Transform", "[benchmark][Matrix]", float, double) {
+    benchmarkTransform<TestType>();
+}
@@ -0,0 +1,20 @@
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Vector.hpp"
+
+template <typename T, std::size_t SIZE>
+void benchmarkVector() {
+    auto set = [](Vector<T, SIZE> & vector, auto index, T value){ vector[index] = value; };
+    const auto lhs = randomVectors<Vector<T, SIZE>, SIZE>(BENCHMARK_BATCH_SIZE, set);
+    const auto rhs = randomVectors<Vector<T, SIZE>, SIZE>(BENCHMARK_BATCH_SIZE, set);
+    benchmarkOperators("Vector<" + typeName<T>() + ", " + std::to_string(SIZE) + ">", lhs, rhs);
+}
+
+TEMPLATE_TEST_CASE("Benchmark Vector", "[benchmark][Vector]", int, float, double) {
+    benchmarkVector<TestType, 2>();
+    benchmarkVector<TestType, 3>();
+    benchmarkVector<TestType, 4>();
+    benchmarkVector<TestType, 8>();
+    benchmarkVector<TestType, 16>();
+}
@@ -0,0 +1,37 @@
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/VectorArray.hpp"
+
+// a + b * s - c evaluated as one fused loop against one array temporary per operation
+template <typename T, std::size_t SIZE>
+void benchmarkVectorArrayChain() {
+    using Catch::Benchmark::Chronometer;
+    using Catch::Benchmark::keep_memory;
+    using vector_type = Vector<T, SIZE>;
+
+    auto set = [](vector_type & vector, auto index, T value){ vector[index] = value; };
+    const VectorArray<T, SIZE> a(randomVectors<vector_type, SIZE>(BENCHMARK_BATCH_SIZE, set));
+    const VectorArray<T, SIZE> b(randomVectors<vector_type, SIZE>(BENCHMARK_BATCH_SIZE, set));
+    const VectorArray<T, SIZE> c(randomVectors<vector_type, SIZE>(BENCHMARK_BATCH_SIZE, set));
+    const T scalar = randomValue<T>();
+    VectorArray<T, SIZE> out(BENCHMARK_BATCH_SIZE);
+    const std::string name = "VectorArray<" + typeName<T>() + ", " + std::to_string(SIZE) + ">";
+
+    BENCHMARK_ADVANCED(name + " a + b * s - c fused")(Chronometer meter) {
+        meter.measure([&]{ out = a + b * scalar - c; keep_memory(out.lane(0).data()); });
+    };
+    BENCHMARK_ADVANCED(name + " a + b * s - c per operation")(Chronometer meter) {
+        meter.measure([&]{
+            const VectorArray<T, SIZE> scaled = b * scalar;
+            const VectorArray<T, SIZE> sum = a + scaled;
+            out = sum - c;
+            keep_memory(out.lane(0).data());
+        });
+    };
+}
+
+TEMPLATE_TEST_CASE("Benchmark VectorArray", "[benchmark][VectorArray]", int, float, double) {
+    benchmarkVectorArrayChain<TestType, 3>();
+    benchmarkVectorArrayChain<TestType, 4>();
+}
@@ -0,0 +1,61 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/VectorFile.hpp"
+
+// Loading a file of Vector3f: reading it component by component, reading it in one
+// call, and mapping it, alone and followed by a pass over every vector
+TEST_CASE("Benchmark VectorFile", "[benchmark][Vector]") {
+    using Catch::Benchmark::Chronometer;
+    using Catch::Benchmark::keep_memory;
+
+    const auto path = std::filesystem::temp_directory_path() / "cpputils_benchmark_vectors.bin";
+    auto set = [](Vector3f & vector, auto index, float value){ vector[index] = value; };
+    const std::vector<Vector3f> vectors = randomVectors<Vector3f, 3>(BENCHMARK_BATCH_SIZE * 64, set);
+    writeVectorFile(path, vectors);
+    std::vector<Vector3f> out(vectors.size());
+
+    BENCHMARK_ADVANCED("ifstream read per component")(Chronometer meter) {
+        meter.measure([&]{
+            std::ifstream file(path, std::ios::binary);
+            file.seekg(sizeof(VectorFileHeader));
+            for(auto & vector : out)
+            {
+                for(auto & component : vector)
+                {
+                    file.read(reinterpret_cast<char *>(&component), sizeof(component));
+                }
+            }
+            keep_memory(out.data());
+        });
+    };
+    BENCHMARK_ADVANCED("ifstream read in one call")(Chronometer meter) {
+        meter.measure([&]{
+            std::ifstream file(path, std::ios::binary);
+            file.seekg(sizeof(VectorFileHeader));
+            std::vector<float> components(vectors.size() * 3);
+            file.read(reinterpret_cast<char *>(components.data()), static_cast<std::streamsize>(components.size() * sizeof(float)));
+            keep_memory(components.data());
+        });
+    };
+    BENCHMARK_ADVANCED("MappedVectorFile open")(Chronometer meter) {
+        meter.measure([&]{ const MappedVectorFile<float, 3> file(path); return file.size(); });
+    };
+    BENCHMARK_ADVANCED("MappedVectorFile open and sum")(Chronometer meter) {
+        meter.measure([&]{
+            const MappedVectorFile<float, 3> file(path);
+            float sum = 0.f;
+            for(const float component : file.components())
+            {
+                sum += component;
+            }
+            return sum;
+        });
+    };
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Vector.hpp"
+
+namespace
+{
+    // The Vector operators against the same operation written with the standard
+    // algorithms over the components, the generic path every size used to take.
+    // Every size processes the same number of components.
+    template <typename T, std::size_t SIZE>
+    void benchmarkVectorSize() {
+        using Catch::Benchmark::Chronometer;
+        using Catch::Benchmark::keep_memory;
+        using vector_type = Vector<T, SIZE>;
+
+        const std::size_t count = std::max<std::size_t>(1, (BENCHMARK_BATCH_SIZE * 4) / SIZE);
+        auto set = [](vector_type & vector, auto index, T value){ vector[index] = value; };
+        const auto lhs = randomVectors<vector_type, SIZE>(count, set);
+        const auto rhs = randomVectors<vector_type, SIZE>(count, set);
+        const T scalar = randomValue<T>();
+        std::vector<vector_type> out(count);
+        std::vector<T> values(count);
+        const std::string name = "Vector<" + typeName<T>() + ", " + std::to_string(SIZE) + ">";
+
+        BENCHMARK_ADVANCED(name + " a + b std::transform")(Chronometer meter) {
+            meter.measure([&]{
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    std::transform(lhs[i].begin(), lhs[i].end(), rhs[i].begin(), out[i].begin(), std::plus<>());
+                }
+                keep_memory(out.data());
+            });
+        };
+        BENCHMARK_ADVANCED(name + " a + b")(Chronometer meter) {
+            meter.measure([&]{ for(std::size_t i = 0; i < count; ++i) out[i] = lhs[i] + rhs[i]; keep_memory(out.data()); });
+        };
+        BENCHMARK_ADVANCED(name + " a += b std::transform")(Chronometer meter) {
+            meter.measure([&]{
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    std::transform(out[i].begin(), out[i].end(), rhs[i].begin(), out[i].begin(), std::plus<>());
+                }
+                keep_memory(out.data());
+            });
+        };
+        BENCHMARK_ADVANCED(name + " a += b")(Chronometer meter) {
+            meter.measure([&]{ for(std::size_t i = 0; i < count; ++i) out[i] += rhs[i]; keep_memory(out.data()); });
+        };
+        BENCHMARK_ADVANCED(name + " a * s std::transform")(Chronometer meter) {
+            meter.measure([&]{
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    std::transform(lhs[i].begin(), lhs[i].end(), out[i].begin(), [scalar](T value){ return value * scalar; });
+                }
+                keep_memory(out.data());
+            });
+        };
+        BENCHMARK_ADVANCED(name + " a * s")(Chronometer meter) {
+            meter.measure([&]{ for(std::size_t i = 0; i < count; ++i) out[i] = lhs[i] * scalar; keep_memory(out.data()); });
+        };
+        BENCHMARK_ADVANCED(name + " a * b std::inner_product")(Chronometer meter) {
+            meter.measure([&]{
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    values[i] = std::inner_product(lhs[i].begin(), lhs[i].end(), rhs[i].begin(), T{});
+                }
+                keep_memory(values.data());
+            });
+        };
+        BENCHMARK_ADVANCED(name + " a * b")(Chronometer meter) {
+            meter.measure([&]{ for(std::size_t i = 0; i < count; ++i) values[i] = lhs[i] * rhs[i]; keep_memory(values.data()); });
+        };
+    }
+}
+
+TEST_CASE("Benchmark Vector Sizes", "[benchmark][Vector]") {
+    benchmarkVectorSize<float, 2>();
+    benchmarkVectorSize<float, 3>();
+    benchmarkVectorSize<float, 4>();
+    benchmarkVectorSize<float, 64>();
+    benchmarkVectorSize<float, 256>();
+    benchmarkVectorSize<float, 1024>();
+    benchmarkVectorSize<int, 3>();
+    benchmarkVectorSize<int, 256>();
+}
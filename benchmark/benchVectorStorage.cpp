@@ -0,0 +1,56 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/Half.hpp"
+#include "../src/QuantizedVectors.hpp"
+
+// Compact storage of Vector3f batches: plain copies as the reference, conversions
+// to and from Vector<Half, 3> one vector at a time and in bulk, and int16_t encoding
+TEST_CASE("Benchmark Vector Storage", "[benchmark][Vector]") {
+    using Catch::Benchmark::Chronometer;
+    using Catch::Benchmark::keep_memory;
+
+    auto set = [](Vector3f & vector, auto index, float value){ vector[index] = value; };
+    const std::vector<Vector3f> vectors = randomVectors<Vector3f, 3>(BENCHMARK_BATCH_SIZE, set);
+    std::vector<Vector3f> out(vectors.size());
+    std::vector<Vector<Half, 3>> halves(vectors.size());
+    convertVectors(vectors, halves);
+    QuantizedVectors<std::int16_t, 3> quantized(vectors);
+
+    BENCHMARK_ADVANCED("Vector3f copy")(Chronometer meter) {
+        meter.measure([&]{ std::copy(vectors.begin(), vectors.end(), out.begin()); keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED("Vector3f to Half per vector")(Chronometer meter) {
+        meter.measure([&]{
+            for(std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                halves[i] = Vector<Half, 3>(vectors[i]);
+            }
+            keep_memory(halves.data());
+        });
+    };
+    BENCHMARK_ADVANCED("Vector3f to Half convertVectors")(Chronometer meter) {
+        meter.measure([&]{ convertVectors(vectors, halves); keep_memory(halves.data()); });
+    };
+    BENCHMARK_ADVANCED("Half to Vector3f per vector")(Chronometer meter) {
+        meter.measure([&]{
+            for(std::size_t i = 0; i < halves.size(); ++i)
+            {
+                out[i] = Vector3f(halves[i]);
+            }
+            keep_memory(out.data());
+        });
+    };
+    BENCHMARK_ADVANCED("Half to Vector3f convertVectors")(Chronometer meter) {
+        meter.measure([&]{ convertVectors(halves, out); keep_memory(out.data()); });
+    };
+    BENCHMARK_ADVANCED("Vector3f to int16_t encode")(Chronometer meter) {
+        meter.measure([&]{ quantized.encode(vectors); keep_memory(&quantized); });
+    };
+    BENCHMARK_ADVANCED("int16_t to Vector3f decode")(Chronometer meter) {
+        meter.measure([&]{ quantized.decode(out); keep_memory(out.data()); });
+    };
+}
@@ -0,0 +1,30 @@
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "BenchmarkHelpers.hpp"
+#include "../src/VectorTuple.hpp"
+
+template <typename T, std::size_t SIZE, typename STORAGE = TupleStorage>
+void benchmarkVectorTuple() {
+    using vector_type = VectorTuple<T, SIZE, STORAGE>;
+    auto set = [](vector_type & vector, auto index, T value){ vector.template get<index>() = value; };
+    const auto lhs = randomVectors<vector_type, SIZE>(BENCHMARK_BATCH_SIZE, set);
+    const auto rhs = randomVectors<vector_type, SIZE>(BENCHMARK_BATCH_SIZE, set);
+    const std::string name = STORAGE::contiguous ? "ContiguousVectorTuple<" : "VectorTuple<";
+    benchmarkOperators(name + typeName<T>() + ", " + std::to_string(SIZE) + ">", lhs, rhs);
+}
+
+TEMPLATE_TEST_CASE("Benchmark VectorTuple", "[benchmark][VectorTuple]", int, float, double) {
+    benchmarkVectorTuple<TestType, 2>();
+    benchmarkVectorTuple<TestType, 3>();
+    benchmarkVectorTuple<TestType, 4>();
+    benchmarkVectorTuple<TestType, 8>();
+    benchmarkVectorTuple<TestType, 16>();
+}
+
+TEMPLATE_TEST_CASE("Benchmark ContiguousVectorTuple", "[benchmark][VectorTuple]", int, float, double) {
+    benchmarkVectorTuple<TestType, 2, ContiguousStorage<>>();
+    benchmarkVectorTuple<TestType, 3, ContiguousStorage<>>();
+    benchmarkVectorTuple<TestType, 4, ContiguousStorage<>>();
+    benchmarkVectorTuple<TestType, 8, ContiguousStorage<>>();
+    benchmarkVectorTuple<TestType, 16, ContiguousStorage<>>();
+}
@@ -0,0 +1,26 @@
+// Compile time benchmark: instantiates every VectorTuple operation for
+// CPPUTILS_COMPILE_BENCHMARK_SIZE components. Built by the CppUtilsCompileBenchmark
+// target, one object per size, see CMakeLists.txt.
+
+#include "../src/VectorTuple.hpp"
+
+#ifndef CPPUTILS_COMPILE_BENCHMARK_SIZE
+#define CPPUTILS_COMPILE_BENCHMARK_SIZE 256
+#endif
+
+template <typename T>
+T instantiateVectorTuple(VectorTuple<T, CPPUTILS_COMPILE_BENCHMARK_SIZE> & lhs, const VectorTuple<T, CPPUTILS_COMPILE_BENCHMARK_SIZE> & rhs) {
+    constexpr auto ones = VectorTuple<T, CPPUTILS_COMPILE_BENCHMARK_SIZE>::template from_val<T{1}>();
+    auto result = (lhs + rhs - ones) * T{2} / T{3};
+    result += -lhs;
+    result -= rhs;
+    result *= T{2};
+    result /= T{2};
+    lhs = result.normalized();
+    lhs.template get<CPPUTILS_COMPILE_BENCHMARK_SIZE - 1>() = lhs.length() + result.template angle<T>(rhs);
+    return static_cast<T>(lhs * rhs + lhs.lengthSquared() + static_cast<T>(lhs < rhs) + static_cast<T>(lhs == rhs));
+}
+
+template int instantiateVectorTuple(VectorTuple<int, CPPUTILS_COMPILE_BENCHMARK_SIZE> &, const VectorTuple<int, CPPUTILS_COMPILE_BENCHMARK_SIZE> &);
+template float instantiateVectorTuple(VectorTuple<float, CPPUTILS_COMPILE_BENCHMARK_SIZE> &, const VectorTuple<float, CPPUTILS_COMPILE_BENCHMARK_SIZE> &);
+template double instantiateVectorTuple(VectorTuple<double, CPPUTILS_COMPILE_BENCHMARK_SIZE> &, const VectorTuple<double, CPPUTILS_COMPILE_BENCHMARK_SIZE> &);
@@ -0,0 +1,135 @@
+#ifndef AABB_HPP
+#define AABB_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#include "Vector.hpp"
+
+// Axis aligned bounding box, the points p with min[c] <= p[c] <= max[c] for every
+// component c. Boxes that only touch overlap.
+template <typename T, std::size_t SIZE> requires (SIZE > 0)
+struct Aabb {
+    using value_type = T;
+    using vector_type = Vector<T, SIZE>;
+
+    vector_type min{};
+    vector_type max{};
+
+    // Bounds of a circle or sphere
+    [[nodiscard]] static constexpr Aabb around(const vector_type & center, const T & radius) noexcept {
+        Aabb result;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result.min[c] = center[c] - radius;
+            result.max[c] = center[c] + radius;
+        }
+        return result;
+    }
+
+    // Box with min > max: merging it with another box gives the other box
+    [[nodiscard]] static constexpr Aabb inverted() noexcept {
+        return Aabb{vector_type(std::numeric_limits<T>::max()), vector_type(std::numeric_limits<T>::lowest())};
+    }
+
+    [[nodiscard]] constexpr bool overlaps(const Aabb & other) const noexcept {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            if(max[c] < other.min[c] || other.max[c] < min[c])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool contains(const Aabb & other) const noexcept {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            if(other.min[c] < min[c] || max[c] < other.max[c])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool contains(const vector_type & point) const noexcept {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            if(point[c] < min[c] || max[c] < point[c])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr Aabb merged(const Aabb & other) const noexcept {
+        Aabb result;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result.min[c] = std::min(min[c], other.min[c]);
+            result.max[c] = std::max(max[c], other.max[c]);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr Aabb merged(const vector_type & point) const noexcept {
+        return merged(Aabb{point, point});
+    }
+
+    // Grown by margin on every side
+    [[nodiscard]] constexpr Aabb expanded(const T & margin) const noexcept {
+        Aabb result;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result.min[c] = min[c] - margin;
+            result.max[c] = max[c] + margin;
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr vector_type center() const noexcept {
+        vector_type result;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = (min[c] + max[c]) / T{2};
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr vector_type extent() const noexcept {
+        vector_type result;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = max[c] - min[c];
+        }
+        return result;
+    }
+
+    // Sum of the extents: half the perimeter in 2D. Bounding volume trees use it as the
+    // cost of a node in any dimension.
+    [[nodiscard]] constexpr T halfPerimeter() const noexcept {
+        T result{};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result += max[c] - min[c];
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Aabb &) const noexcept = default;
+};
+
+template <typename T>
+using Aabb2 = Aabb<T, 2>;
+
+template <typename T>
+using Aabb3 = Aabb<T, 3>;
+
+using Aabb2f = Aabb2<float>;
+using Aabb3f = Aabb3<float>;
+
+#endif // AABB_HPP
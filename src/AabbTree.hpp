@@ -0,0 +1,411 @@
+#ifndef AABB_TREE_HPP
+#define AABB_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Aabb.hpp"
+#include "BroadPhase.hpp"
+
+// Dynamic bounding volume tree broad phase. Every body is a leaf holding its box
+// grown by margin (the fat box), inner nodes hold the union of their children, and
+// insertions pick the sibling that least increases the half perimeters. The tree is
+// kept balanced with rotations, so queries and updates cost O(log n).
+// update() only moves a leaf when the new box leaves its fat box: with a margin
+// larger than the distance bodies move in a frame, most updates are a comparison.
+// Pairs and queries are tested against the exact boxes, so the margin never adds
+// results. Nodes live in one array and are recycled through a free list.
+template <typename T, std::size_t SIZE> requires (SIZE > 0)
+class AabbTree {
+public:
+    using value_type = T;
+    using box_type = Aabb<T, SIZE>;
+
+    explicit AabbTree(const T & margin = T{}) noexcept :
+        m_margin{margin} {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool contains(std::uint32_t index) const noexcept {
+        return index < m_leaves.size() && m_leaves[index] != NONE;
+    }
+
+    [[nodiscard]] const box_type & box(std::uint32_t index) const noexcept {
+        assert(contains(index));
+        return m_boxes[index];
+    }
+
+    // Height of the tree, 0 for a single body
+    [[nodiscard]] std::size_t height() const noexcept {
+        return m_root == NONE ? 0 : m_nodes[m_root].height;
+    }
+
+    void insert(std::uint32_t index, const box_type & box) {
+        assert(index != NONE && !contains(index));
+        if(index >= m_leaves.size())
+        {
+            m_leaves.resize(static_cast<std::size_t>(index) + 1, NONE);
+            m_boxes.resize(static_cast<std::size_t>(index) + 1);
+        }
+        const std::uint32_t leaf = allocateNode();
+        m_nodes[leaf].box = box.expanded(m_margin);
+        m_nodes[leaf].index = index;
+        m_leaves[index] = leaf;
+        m_boxes[index] = box;
+        insertLeaf(leaf);
+        ++m_size;
+    }
+
+    // Returns whether the body moved in the tree
+    bool update(std::uint32_t index, const box_type & box) {
+        assert(contains(index));
+        m_boxes[index] = box;
+        const std::uint32_t leaf = m_leaves[index];
+        if(m_nodes[leaf].box.contains(box))
+        {
+            return false;
+        }
+        removeLeaf(leaf);
+        m_nodes[leaf].box = box.expanded(m_margin);
+        insertLeaf(leaf);
+        return true;
+    }
+
+    void erase(std::uint32_t index) {
+        assert(contains(index));
+        const std::uint32_t leaf = m_leaves[index];
+        removeLeaf(leaf);
+        freeNode(leaf);
+        m_leaves[index] = NONE;
+        --m_size;
+    }
+
+    // Bodies 0 to boxes.size() - 1 are inserted, or updated if they already are
+    void update(std::span<const box_type> boxes) {
+        assert(boxes.size() < NONE);
+        for(std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            const auto index = static_cast<std::uint32_t>(i);
+            if(contains(index))
+            {
+                update(index, boxes[i]);
+            }
+            else
+            {
+                insert(index, boxes[i]);
+            }
+        }
+    }
+
+    void clear() noexcept {
+        m_nodes.clear();
+        m_leaves.clear();
+        m_boxes.clear();
+        m_root = NONE;
+        m_free = NONE;
+        m_size = 0;
+    }
+
+    // Calls function(index) for every body overlapping box
+    template <typename FUNCTION>
+    void query(const box_type & box, FUNCTION && function) const {
+        if(m_root == NONE)
+        {
+            return;
+        }
+        std::vector<std::uint32_t> stack{m_root};
+        while(!stack.empty())
+        {
+            const Node & node = m_nodes[stack.back()];
+            stack.pop_back();
+            if(!node.box.overlaps(box))
+            {
+                continue;
+            }
+            if(node.isLeaf())
+            {
+                if(m_boxes[node.index].overlaps(box))
+                {
+                    function(node.index);
+                }
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // Replaces the contents of pairs with the overlapping bodies. Traverses the tree
+    // against itself, so every pair of subtrees is tested at most once.
+    void findPairs(std::vector<CollisionPair> & pairs) const {
+        pairs.clear();
+        if(m_root == NONE)
+        {
+            return;
+        }
+        // Pairs of nodes with overlapping boxes, (n, n) stands for the pairs within the subtree of n
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> stack{{m_root, m_root}};
+        while(!stack.empty())
+        {
+            const auto [a, b] = stack.back();
+            stack.pop_back();
+            const Node & first = m_nodes[a];
+            if(a == b)
+            {
+                if(!first.isLeaf())
+                {
+                    stack.emplace_back(first.child1, first.child1);
+                    stack.emplace_back(first.child2, first.child2);
+                    pushIfOverlapping(stack, first.child1, first.child2);
+                }
+                continue;
+            }
+            const Node & second = m_nodes[b];
+            if(first.isLeaf() && second.isLeaf())
+            {
+                if(m_boxes[first.index].overlaps(m_boxes[second.index]))
+                {
+                    pairs.push_back(detail::makeCollisionPair(first.index, second.index));
+                }
+            }
+            // Descend into the larger node
+            else if(second.isLeaf() || (!first.isLeaf() && first.box.halfPerimeter() >= second.box.halfPerimeter()))
+            {
+                pushIfOverlapping(stack, first.child1, b);
+                pushIfOverlapping(stack, first.child2, b);
+            }
+            else
+            {
+                pushIfOverlapping(stack, a, second.child1);
+                pushIfOverlapping(stack, a, second.child2);
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    struct Node {
+        box_type box;
+        std::uint32_t parent = NONE;
+        std::uint32_t child1 = NONE;
+        std::uint32_t child2 = NONE;
+        // Leaves: the body. Free nodes: the next free node.
+        std::uint32_t index = NONE;
+        // 0 for leaves
+        std::uint32_t height = 0;
+
+        [[nodiscard]] bool isLeaf() const noexcept {
+            return child1 == NONE;
+        }
+    };
+
+    void pushIfOverlapping(std::vector<std::pair<std::uint32_t, std::uint32_t>> & stack, std::uint32_t a, std::uint32_t b) const {
+        if(m_nodes[a].box.overlaps(m_nodes[b].box))
+        {
+            stack.emplace_back(a, b);
+        }
+    }
+
+    [[nodiscard]] std::uint32_t allocateNode() {
+        if(m_free == NONE)
+        {
+            m_nodes.emplace_back();
+            return static_cast<std::uint32_t>(m_nodes.size() - 1);
+        }
+        const std::uint32_t node = m_free;
+        m_free = m_nodes[node].index;
+        m_nodes[node] = Node{};
+        return node;
+    }
+
+    void freeNode(std::uint32_t node) noexcept {
+        m_nodes[node].index = m_free;
+        m_nodes[node].height = NONE;
+        m_free = node;
+    }
+
+    void insertLeaf(std::uint32_t leaf) {
+        if(m_root == NONE)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = NONE;
+            return;
+        }
+
+        // Descend while it is cheaper to push the leaf down than to pair it here
+        const box_type box = m_nodes[leaf].box;
+        std::uint32_t sibling = m_root;
+        while(!m_nodes[sibling].isLeaf())
+        {
+            const Node & node = m_nodes[sibling];
+            const T combined = node.box.merged(box).halfPerimeter();
+            const T cost = T{2} * combined;
+            // Every ancestor of the leaf grows
+            const T inheritance = T{2} * (combined - node.box.halfPerimeter());
+            const T cost1 = descendCost(node.child1, box) + inheritance;
+            const T cost2 = descendCost(node.child2, box) + inheritance;
+            if(cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+            sibling = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const std::uint32_t old_parent = m_nodes[sibling].parent;
+        const std::uint32_t parent = allocateNode();
+        Node & new_parent = m_nodes[parent];
+        new_parent.parent = old_parent;
+        new_parent.box = box.merged(m_nodes[sibling].box);
+        new_parent.height = m_nodes[sibling].height + 1;
+        new_parent.child1 = sibling;
+        new_parent.child2 = leaf;
+        m_nodes[sibling].parent = parent;
+        m_nodes[leaf].parent = parent;
+        if(old_parent == NONE)
+        {
+            m_root = parent;
+        }
+        else
+        {
+            replaceChild(old_parent, sibling, parent);
+        }
+        refit(m_nodes[leaf].parent);
+    }
+
+    // Cost of inserting box somewhere under child, without the inherited cost
+    [[nodiscard]] T descendCost(std::uint32_t child, const box_type & box) const noexcept {
+        const Node & node = m_nodes[child];
+        const T merged = node.box.merged(box).halfPerimeter();
+        return node.isLeaf() ? merged : merged - node.box.halfPerimeter();
+    }
+
+    void removeLeaf(std::uint32_t leaf) {
+        if(leaf == m_root)
+        {
+            m_root = NONE;
+            return;
+        }
+        const std::uint32_t parent = m_nodes[leaf].parent;
+        const std::uint32_t grand_parent = m_nodes[parent].parent;
+        const std::uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+        m_nodes[sibling].parent = grand_parent;
+        freeNode(parent);
+        if(grand_parent == NONE)
+        {
+            m_root = sibling;
+            return;
+        }
+        replaceChild(grand_parent, parent, sibling);
+        refit(grand_parent);
+    }
+
+    void replaceChild(std::uint32_t parent, std::uint32_t old_child, std::uint32_t new_child) noexcept {
+        Node & node = m_nodes[parent];
+        if(node.child1 == old_child)
+        {
+            node.child1 = new_child;
+        }
+        else
+        {
+            node.child2 = new_child;
+        }
+    }
+
+    // Rebalances and recomputes the boxes and heights from node to the root
+    void refit(std::uint32_t node) noexcept {
+        while(node != NONE)
+        {
+            node = balance(node);
+            Node & current = m_nodes[node];
+            const Node & child1 = m_nodes[current.child1];
+            const Node & child2 = m_nodes[current.child2];
+            current.box = child1.box.merged(child2.box);
+            current.height = 1 + std::max(child1.height, child2.height);
+            node = current.parent;
+        }
+    }
+
+    // If the heights of the children of a differ by more than one, the higher child
+    // takes the place of a. Returns the node now at the position of a.
+    [[nodiscard]] std::uint32_t balance(std::uint32_t a) noexcept {
+        if(m_nodes[a].isLeaf())
+        {
+            return a;
+        }
+        const std::uint32_t b = m_nodes[a].child1;
+        const std::uint32_t c = m_nodes[a].child2;
+        const auto difference = static_cast<std::int64_t>(m_nodes[c].height) - static_cast<std::int64_t>(m_nodes[b].height);
+        if(difference > 1)
+        {
+            rotate(a, c, b, &Node::child2);
+            return c;
+        }
+        if(difference < -1)
+        {
+            rotate(a, b, c, &Node::child1);
+            return b;
+        }
+        return a;
+    }
+
+    // Moves up the child of a, keeps its higher child and gives the other one to a, in
+    // place of up. slot is the member of a that pointed to up.
+    void rotate(std::uint32_t a, std::uint32_t up, std::uint32_t other, std::uint32_t Node::* slot) noexcept {
+        const std::uint32_t f = m_nodes[up].child1;
+        const std::uint32_t g = m_nodes[up].child2;
+        const std::uint32_t parent = m_nodes[a].parent;
+        m_nodes[up].child1 = a;
+        m_nodes[up].parent = parent;
+        m_nodes[a].parent = up;
+        if(parent == NONE)
+        {
+            m_root = up;
+        }
+        else
+        {
+            replaceChild(parent, a, up);
+        }
+
+        const bool keep_f = m_nodes[f].height > m_nodes[g].height;
+        const std::uint32_t kept = keep_f ? f : g;
+        const std::uint32_t moved = keep_f ? g : f;
+        m_nodes[up].child2 = kept;
+        m_nodes[a].*slot = moved;
+        m_nodes[moved].parent = a;
+
+        Node & node_a = m_nodes[a];
+        node_a.box = m_nodes[other].box.merged(m_nodes[moved].box);
+        node_a.height = 1 + std::max(m_nodes[other].height, m_nodes[moved].height);
+        Node & node_up = m_nodes[up];
+        node_up.box = node_a.box.merged(m_nodes[kept].box);
+        node_up.height = 1 + std::max(node_a.height, m_nodes[kept].height);
+    }
+
+    T m_margin;
+    std::vector<Node> m_nodes;
+    std::uint32_t m_root = NONE;
+    std::uint32_t m_free = NONE;
+    // Leaf of every body, NONE for the ones not inserted
+    std::vector<std::uint32_t> m_leaves;
+    // Exact boxes, the leaves have the fat ones
+    std::vector<box_type> m_boxes;
+    std::size_t m_size = 0;
+};
+
+#endif // AABB_TREE_HPP
@@ -0,0 +1,39 @@
+#ifndef ALIGNED_ALLOCATOR_HPP
+#define ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+// Standard allocator returning storage aligned to ALIGNMENT bytes, so contiguous
+// lanes of data can be loaded with full-width aligned SIMD instructions.
+template <typename T, std::size_t ALIGNMENT = 64> requires (ALIGNMENT >= alignof(T) && (ALIGNMENT & (ALIGNMENT - 1)) == 0)
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &) noexcept {
+    }
+
+    [[nodiscard]] T * allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+
+    void deallocate(T * p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{ALIGNMENT});
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr bool operator==(const AlignedAllocator<U, ALIGNMENT> &) const noexcept {
+        return true;
+    }
+};
+
+#endif // ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,207 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Memory resources for std::pmr containers.
+// Both keep every block they obtain from their upstream resource until they are
+// destroyed: reset() rewinds them in O(1), and once they have grown to the
+// working set size they never call the upstream resource again.
+// reset() may only be called when nothing allocated from the arena is in use.
+
+namespace detail
+{
+    // Blocks obtained from upstream and a bump pointer over them
+    class ArenaBlocks
+    {
+    public:
+        ArenaBlocks(std::size_t block_size, std::pmr::memory_resource * upstream) noexcept:
+            m_block_size{block_size},
+            m_upstream{upstream}
+        {
+        }
+
+        ~ArenaBlocks()
+        {
+            for(const auto & block : m_blocks)
+            {
+                m_upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+            }
+        }
+
+        ArenaBlocks(const ArenaBlocks &) = delete;
+        ArenaBlocks & operator=(const ArenaBlocks &) = delete;
+
+        [[nodiscard]] void * allocate(std::size_t bytes, std::size_t alignment)
+        {
+            while(true)
+            {
+                if(m_current == m_blocks.size())
+                {
+                    const std::size_t size = std::max(m_block_size, bytes + alignment);
+                    m_blocks.push_back({static_cast<std::byte *>(m_upstream->allocate(size, alignof(std::max_align_t))), size});
+                }
+
+                auto & block = m_blocks[m_current];
+                void * pointer = block.data + m_offset;
+                std::size_t space = block.size - m_offset;
+                if(std::align(alignment, bytes, pointer, space) != nullptr)
+                {
+                    m_offset = block.size - space + bytes;
+                    return pointer;
+                }
+                ++m_current;
+                m_offset = 0;
+            }
+        }
+
+        void reset() noexcept
+        {
+            m_current = 0;
+            m_offset = 0;
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            std::size_t result = 0;
+            for(const auto & block : m_blocks)
+            {
+                result += block.size;
+            }
+            return result;
+        }
+
+    private:
+        struct Block
+        {
+            std::byte * data;
+            std::size_t size;
+        };
+
+        std::size_t m_block_size;
+        std::pmr::memory_resource * m_upstream;
+        std::vector<Block> m_blocks;
+        std::size_t m_current = 0;
+        std::size_t m_offset = 0;
+    };
+}
+
+// Bump allocator, deallocation is a no-op
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    explicit MonotonicArena(std::size_t block_size = 1 << 20, std::pmr::memory_resource * upstream = std::pmr::new_delete_resource()) noexcept:
+        m_blocks{block_size, upstream}
+    {
+    }
+
+    void reset() noexcept
+    {
+        m_blocks.reset();
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return m_blocks.capacity();
+    }
+
+private:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        return m_blocks.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    detail::ArenaBlocks m_blocks;
+};
+
+// Fixed size block allocator for node based containers.
+// Requests up to block_size bytes are served from a free list, bigger ones are
+// forwarded to the upstream resource.
+class PoolArena : public std::pmr::memory_resource
+{
+public:
+    explicit PoolArena(std::size_t block_size, std::size_t blocks_per_chunk = 1024, std::pmr::memory_resource * upstream = std::pmr::new_delete_resource()) noexcept:
+        m_block_size{roundUp(std::max(block_size, sizeof(FreeBlock)))},
+        m_blocks{m_block_size * blocks_per_chunk, upstream},
+        m_upstream{upstream}
+    {
+    }
+
+    void reset() noexcept
+    {
+        m_free = nullptr;
+        m_blocks.reset();
+    }
+
+    [[nodiscard]] std::size_t blockSize() const noexcept
+    {
+        return m_block_size;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock * next;
+    };
+
+    [[nodiscard]] static constexpr std::size_t roundUp(std::size_t size) noexcept
+    {
+        constexpr std::size_t alignment = alignof(std::max_align_t);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    [[nodiscard]] bool fromPool(std::size_t bytes, std::size_t alignment) const noexcept
+    {
+        return bytes <= m_block_size && alignment <= alignof(std::max_align_t);
+    }
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if(!fromPool(bytes, alignment))
+        {
+            return m_upstream->allocate(bytes, alignment);
+        }
+        if(m_free != nullptr)
+        {
+            return std::exchange(m_free, m_free->next);
+        }
+        return m_blocks.allocate(m_block_size, alignof(std::max_align_t));
+    }
+
+    void do_deallocate(void * pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        if(!fromPool(bytes, alignment))
+        {
+            m_upstream->deallocate(pointer, bytes, alignment);
+            return;
+        }
+        m_free = ::new(pointer) FreeBlock{m_free};
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t m_block_size;
+    detail::ArenaBlocks m_blocks;
+    std::pmr::memory_resource * m_upstream;
+    FreeBlock * m_free = nullptr;
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,270 @@
+#ifndef ASYNCSINKBUFFER_HPP
+#define ASYNCSINKBUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <streambuf>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace juan
+{
+    // What AsyncSinkBuffer does when every block is waiting to be written
+    enum class BackPressure
+    {
+        // Wait for the writer thread to free a block
+        Block,
+        // Discard the output until a block is free
+        Drop,
+        // Allocate another block
+        Grow
+    };
+
+    struct AsyncSinkOptions
+    {
+        std::size_t block_size = 1 << 16;
+        // Ignored by BackPressure::Grow
+        std::size_t max_blocks = 8;
+        BackPressure back_pressure = BackPressure::Block;
+    };
+
+    // Stream buffer that forwards its output to a sink from a background thread.
+    // The put area is a large block, so the writing thread only copies bytes into
+    // it; full blocks are queued and the writer thread hands them to the sink.
+    // A single thread may write to the buffer at a time.
+    class AsyncSinkBuffer : public std::streambuf
+    {
+    public:
+        // Called from the writer thread, it must not throw
+        using Sink = std::function<void(std::string_view)>;
+
+        using BackPressure = juan::BackPressure;
+        using Options = AsyncSinkOptions;
+
+        explicit AsyncSinkBuffer(Sink sink, Options options = {}):
+            m_sink{std::move(sink)},
+            m_options{options},
+            m_thread{[this](std::stop_token stop){ writerLoop(stop); }}
+        {
+            assert(m_options.block_size > 0 && m_options.max_blocks > 0);
+            assert(m_options.block_size <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+        }
+
+#if __has_include(<unistd.h>)
+        // Writes to a file descriptor, which is not closed by the buffer
+        explicit AsyncSinkBuffer(int fd, Options options = {}):
+            AsyncSinkBuffer{[fd](std::string_view bytes){ writeAll(fd, bytes); }, options}
+        {
+        }
+#endif
+
+        // Everything written so far reaches the sink before the writer thread exits
+        ~AsyncSinkBuffer() override
+        {
+            std::unique_lock lock(m_mutex);
+            handOver(lock);
+            lock.unlock();
+            m_thread.request_stop();
+        }
+
+        AsyncSinkBuffer(const AsyncSinkBuffer &) = delete;
+        AsyncSinkBuffer(AsyncSinkBuffer &&) = delete;
+        AsyncSinkBuffer & operator=(const AsyncSinkBuffer &) = delete;
+        AsyncSinkBuffer & operator=(AsyncSinkBuffer &&) = delete;
+
+        // Waits until everything written so far has been handed to the sink
+        void flush()
+        {
+            std::unique_lock lock(m_mutex);
+            handOver(lock);
+            m_block_freed.wait(lock, [this]{ return m_queue.empty() && !m_writing; });
+        }
+
+        [[nodiscard]] std::uint64_t dropped() const noexcept
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        // Blocks allocated so far, only grows past max_blocks with BackPressure::Grow
+        [[nodiscard]] std::size_t blockCount() const
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_block_count;
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                const char c = traits_type::to_char_type(ch);
+                xsputn(&c, 1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize xsputn(const char * s, std::streamsize count) override
+        {
+            auto remaining = static_cast<std::size_t>(count);
+            while(remaining > 0)
+            {
+                if(pptr() == epptr() && !nextBlock())
+                {
+                    m_dropped.fetch_add(remaining, std::memory_order_relaxed);
+                    break;
+                }
+                const auto length = std::min(remaining, static_cast<std::size_t>(epptr() - pptr()));
+                std::memcpy(pptr(), s, length);
+                pbump(static_cast<int>(length));
+                s += length;
+                remaining -= length;
+            }
+            return count;
+        }
+
+        // Hands the current block over only when the writer thread is idle, so
+        // frequent flushes don't turn into many small writes under load
+        int sync() override
+        {
+            std::unique_lock lock(m_mutex);
+            if(m_queue.empty() && !m_writing)
+            {
+                handOver(lock);
+            }
+            return 0;
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t size = 0;
+        };
+
+#if __has_include(<unistd.h>)
+        static void writeAll(int fd, std::string_view bytes) noexcept
+        {
+            while(!bytes.empty())
+            {
+                const auto written = ::write(fd, bytes.data(), bytes.size());
+                if(written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if(written <= 0)
+                {
+                    return;
+                }
+                bytes.remove_prefix(static_cast<std::size_t>(written));
+            }
+        }
+#endif
+
+        // Queues the current block if it has any byte
+        void handOver(std::unique_lock<std::mutex> &)
+        {
+            m_current.size = static_cast<std::size_t>(pptr() - pbase());
+            if(m_current.size == 0)
+            {
+                return;
+            }
+            m_queue.push_back(std::move(m_current));
+            m_current = {};
+            setp(nullptr, nullptr);
+            m_block_ready.notify_one();
+        }
+
+        // Queues the current block and takes a free one, false when the output has to be dropped
+        [[nodiscard]] bool nextBlock()
+        {
+            std::unique_lock lock(m_mutex);
+            handOver(lock);
+            if(m_free.empty())
+            {
+                if(m_block_count < m_options.max_blocks || m_options.back_pressure == BackPressure::Grow)
+                {
+                    m_free.push_back({std::make_unique<char[]>(m_options.block_size), 0});
+                    ++m_block_count;
+                }
+                else if(m_options.back_pressure == BackPressure::Block)
+                {
+                    m_block_freed.wait(lock, [this]{ return !m_free.empty(); });
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            m_current = std::move(m_free.back());
+            m_free.pop_back();
+            setp(m_current.data.get(), m_current.data.get() + m_options.block_size);
+            return true;
+        }
+
+        void writerLoop(std::stop_token stop)
+        {
+            std::unique_lock lock(m_mutex);
+            while(true)
+            {
+                m_block_ready.wait(lock, stop, [this]{ return !m_queue.empty(); });
+                if(m_queue.empty())
+                {
+                    return;
+                }
+
+                std::vector<Block> batch(std::make_move_iterator(m_queue.begin()), std::make_move_iterator(m_queue.end()));
+                m_queue.clear();
+                m_writing = true;
+                lock.unlock();
+                for(const auto & block : batch)
+                {
+                    m_sink({block.data.get(), block.size});
+                }
+                lock.lock();
+
+                for(auto & block : batch)
+                {
+                    block.size = 0;
+                    m_free.push_back(std::move(block));
+                }
+                m_writing = false;
+                m_block_freed.notify_all();
+            }
+        }
+
+        Sink m_sink;
+        Options m_options;
+        // Block being filled through the put area, only used by the writing thread
+        Block m_current;
+        std::atomic<std::uint64_t> m_dropped{0};
+
+        mutable std::mutex m_mutex;
+        std::condition_variable_any m_block_ready;
+        std::condition_variable m_block_freed;
+        std::deque<Block> m_queue;
+        std::vector<Block> m_free;
+        std::size_t m_block_count = 0;
+        bool m_writing = false;
+        // Last member: the writer thread is joined before anything else is destroyed
+        std::jthread m_thread;
+    };
+}
+
+#endif // ASYNCSINKBUFFER_HPP
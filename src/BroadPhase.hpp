@@ -0,0 +1,49 @@
+#ifndef BROAD_PHASE_HPP
+#define BROAD_PHASE_HPP
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Aabb.hpp"
+
+// Shared pieces of the broad phases (SweepAndPrune.hpp, AabbTree.hpp), which find the
+// pairs of overlapping boxes without testing every pair. Bodies are identified by
+// std::uint32_t indices chosen by the caller. Pairs are reported once, with
+// first < second, in no particular order, into a vector that is cleared first, so
+// reusing it between frames reuses its memory.
+
+struct CollisionPair {
+    std::uint32_t first;
+    std::uint32_t second;
+
+    [[nodiscard]] constexpr auto operator<=>(const CollisionPair &) const noexcept = default;
+};
+
+namespace detail
+{
+    [[nodiscard]] constexpr CollisionPair makeCollisionPair(std::uint32_t a, std::uint32_t b) noexcept {
+        return a < b ? CollisionPair{a, b} : CollisionPair{b, a};
+    }
+}
+
+// Reference implementation, tests the n * (n - 1) / 2 pairs of boxes[0, n)
+template <typename T, std::size_t SIZE>
+void bruteForcePairs(std::type_identity_t<std::span<const Aabb<T, SIZE>>> boxes, std::vector<CollisionPair> & pairs) {
+    pairs.clear();
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        for(std::size_t j = i + 1; j < boxes.size(); ++j)
+        {
+            if(boxes[i].overlaps(boxes[j]))
+            {
+                pairs.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j)});
+            }
+        }
+    }
+}
+
+#endif // BROAD_PHASE_HPP
@@ -0,0 +1,246 @@
+#ifndef CONCURRENTCAPTUREBUFFER_HPP
+#define CONCURRENTCAPTUREBUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace juan
+{
+    // Stream buffer that can be written from several threads at once.
+    // It has no put area, so every write reaches xsputn/overflow, which append to a
+    // buffer owned by the writing thread. Each completed line gets a global sequence
+    // number and is pushed to a lock-free list; the reader merges the lines back in
+    // sequence order, so lines are never interleaved nor lost.
+    // The lines come from blocks owned by the writing thread and the reader hands them
+    // back once merged, so a steady stream of lines does not allocate.
+    // A std::ostream shared by several threads also shares its formatting state, which
+    // operator<< modifies (width): threads using operator<< write to threadStream().
+    class ConcurrentCaptureBuffer : public std::streambuf
+    {
+    public:
+        ConcurrentCaptureBuffer() = default;
+
+        ~ConcurrentCaptureBuffer() override
+        {
+            // The lines live in the blocks of the thread buffers
+            for(auto * buffer = m_thread_buffers.load(); buffer != nullptr;)
+            {
+                delete std::exchange(buffer, buffer->next);
+            }
+        }
+
+        ConcurrentCaptureBuffer(const ConcurrentCaptureBuffer &) = delete;
+        ConcurrentCaptureBuffer(ConcurrentCaptureBuffer &&) = delete;
+        ConcurrentCaptureBuffer & operator=(const ConcurrentCaptureBuffer &) = delete;
+        ConcurrentCaptureBuffer & operator=(ConcurrentCaptureBuffer &&) = delete;
+
+        // Stream of the calling thread writing to this buffer, with its own formatting state
+        [[nodiscard]] std::ostream & threadStream()
+        {
+            return local().stream;
+        }
+
+        // Completed lines of every thread plus the unfinished line of the calling thread.
+        // Only one thread may read at a time.
+        [[nodiscard]] const std::string & str()
+        {
+            publish(local());
+            merge();
+            return m_merged;
+        }
+
+        void clear()
+        {
+            merge();
+            m_merged.clear();
+        }
+
+        // Publishes the unfinished lines of all the threads.
+        // Only valid when no other thread is writing (e.g. after joining them).
+        void publishAll()
+        {
+            for(auto * buffer = m_thread_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next)
+            {
+                publish(*buffer);
+            }
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                const char c = traits_type::to_char_type(ch);
+                append(&c, 1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize xsputn(const char * s, std::streamsize count) override
+        {
+            append(s, static_cast<std::size_t>(count));
+            return count;
+        }
+
+        int sync() override
+        {
+            publish(local());
+            return 0;
+        }
+
+    private:
+        static constexpr std::size_t LINE_BLOCK_SIZE = 64;
+
+        struct ThreadBuffer;
+
+        struct Line
+        {
+            std::uint64_t sequence;
+            std::string text;
+            Line * next;
+            ThreadBuffer * owner;
+        };
+
+        struct ThreadBuffer
+        {
+            ThreadBuffer(std::thread::id id, std::streambuf * buffer) :
+                thread{id},
+                stream{buffer}
+            {
+            }
+
+            std::thread::id thread;
+            std::string partial;
+            std::ostream stream;
+            std::vector<std::unique_ptr<Line[]>> blocks;
+            // Lines of the writer, and lines handed back by the reader
+            Line * free_lines = nullptr;
+            std::atomic<Line *> returned_lines{nullptr};
+            ThreadBuffer * next = nullptr;
+        };
+
+        template <typename NODE>
+        static void pushFront(std::atomic<NODE *> & head, NODE * node) noexcept
+        {
+            node->next = head.load(std::memory_order_relaxed);
+            while(!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // Buffer of the calling thread, registered on its first write. A thread remembers
+        // the last buffer it wrote to, and looks the others up by thread id. The ids of
+        // the capture buffers are never reused, so the cache cannot point to a dead one.
+        [[nodiscard]] ThreadBuffer & local()
+        {
+            thread_local std::pair<std::uint64_t, ThreadBuffer *> last{UINT64_MAX, nullptr};
+            if(last.first == m_id)
+            {
+                return *last.second;
+            }
+            const auto id = std::this_thread::get_id();
+            auto * buffer = m_thread_buffers.load(std::memory_order_acquire);
+            while(buffer != nullptr && buffer->thread != id)
+            {
+                buffer = buffer->next;
+            }
+            if(buffer == nullptr)
+            {
+                buffer = new ThreadBuffer(id, this);
+                pushFront(m_thread_buffers, buffer);
+            }
+            last = {m_id, buffer};
+            return *buffer;
+        }
+
+        void append(const char * s, std::size_t count)
+        {
+            auto & buffer = local();
+            while(count > 0)
+            {
+                const auto * newline = std::find(s, s + count, '\n');
+                const auto length = static_cast<std::size_t>(newline - s) + (newline != s + count ? 1 : 0);
+                buffer.partial.append(s, length);
+                if(newline != s + count)
+                {
+                    publish(buffer);
+                }
+                s += length;
+                count -= length;
+            }
+        }
+
+        [[nodiscard]] static Line & acquireLine(ThreadBuffer & buffer)
+        {
+            if(buffer.free_lines == nullptr)
+            {
+                buffer.free_lines = buffer.returned_lines.exchange(nullptr, std::memory_order_acquire);
+            }
+            if(buffer.free_lines == nullptr)
+            {
+                auto & block = buffer.blocks.emplace_back(std::make_unique<Line[]>(LINE_BLOCK_SIZE));
+                for(std::size_t i = 0; i < LINE_BLOCK_SIZE; ++i)
+                {
+                    block[i].owner = &buffer;
+                    block[i].next = i + 1 < LINE_BLOCK_SIZE ? &block[i + 1] : nullptr;
+                }
+                buffer.free_lines = block.get();
+            }
+            return *std::exchange(buffer.free_lines, buffer.free_lines->next);
+        }
+
+        // The line takes the text and leaves its own emptied string, with its capacity
+        void publish(ThreadBuffer & buffer)
+        {
+            if(buffer.partial.empty())
+            {
+                return;
+            }
+            auto & line = acquireLine(buffer);
+            line.sequence = m_next_sequence.fetch_add(1, std::memory_order_relaxed);
+            line.text.swap(buffer.partial);
+            pushFront(m_lines, &line);
+        }
+
+        // Appends the published lines to m_merged in sequence order. A line whose
+        // sequence number is taken but not pushed yet holds back the lines after it.
+        void merge()
+        {
+            for(auto * line = m_lines.exchange(nullptr, std::memory_order_acquire); line != nullptr; line = line->next)
+            {
+                m_pending.push_back(line);
+            }
+            std::sort(m_pending.begin(), m_pending.end(), [](const Line * a, const Line * b){ return a->sequence < b->sequence; });
+
+            auto ready = m_pending.begin();
+            for(; ready != m_pending.end() && (*ready)->sequence == m_merged_sequence; ++ready, ++m_merged_sequence)
+            {
+                m_merged += (*ready)->text;
+                (*ready)->text.clear();
+                pushFront((*ready)->owner->returned_lines, *ready);
+            }
+            m_pending.erase(m_pending.begin(), ready);
+        }
+
+        inline static std::atomic<std::uint64_t> s_next_id{0};
+
+        const std::uint64_t m_id = s_next_id.fetch_add(1, std::memory_order_relaxed);
+        std::atomic<Line *> m_lines{nullptr};
+        std::atomic<ThreadBuffer *> m_thread_buffers{nullptr};
+        std::atomic<std::uint64_t> m_next_sequence{0};
+        // Reader side only
+        std::uint64_t m_merged_sequence = 0;
+        std::vector<Line *> m_pending;
+        std::string m_merged;
+    };
+}
+
+#endif // CONCURRENTCAPTUREBUFFER_HPP
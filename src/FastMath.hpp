@@ -0,0 +1,348 @@
+#ifndef FAST_MATH_HPP
+#define FAST_MATH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "VectorKernels.hpp"
+
+// Approximations of the float functions used by Vector, for loops over many values.
+// They have no branches, so loops calling them vectorize: std::sqrt and the other
+// <cmath> functions may set errno, which keeps GCC from vectorizing them.
+// Every function takes a Precision: exact calls the <cmath> function, fast uses the
+// approximation. Precision::fast only changes float, double always uses <cmath>.
+// Maximum errors of the fast versions against the correctly rounded result, measured
+// over all floats of the ranges (testFastMath checks a sample of them):
+// * rsqrt: 3 ULP, for normal positive arguments.
+// * sqrt: 1 ULP, for normal positive arguments and 0.
+// * acos: 1 ULP. Arguments are clamped to [-1, 1], where std::acos returns NaN.
+// * atan2: 3 ULP, for finite arguments.
+// * sin, cos: 2 ULP for |x| <= 1e6, next to the multiples of pi / 2 included. Larger
+//   arguments, infinities and NaN go to std::sin and std::cos: single calls check the
+//   range with a branch, the batches still vectorize and fix up the blocks holding them.
+namespace math
+{
+    enum class Precision {
+        exact,
+        fast
+    };
+
+    template <Precision P, typename T>
+    inline constexpr bool useFast = P == Precision::fast && std::is_same_v<T, float>;
+}
+
+namespace detail
+{
+    inline constexpr float PI = 3.14159265358979f;
+    inline constexpr float HALF_PI = 1.57079632679490f;
+
+    // condition ? a : b, with bit masks because GCC does not vectorize float selects
+    [[nodiscard]] constexpr float select(bool condition, float a, float b) noexcept {
+        const std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+        return std::bit_cast<float>((std::bit_cast<std::uint32_t>(a) & mask) | (std::bit_cast<std::uint32_t>(b) & ~mask));
+    }
+
+    [[nodiscard]] constexpr float flipSign(float value, std::uint32_t sign_bit) noexcept {
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) ^ sign_bit);
+    }
+
+    [[nodiscard]] constexpr std::uint32_t signBit(float value) noexcept {
+        return std::bit_cast<std::uint32_t>(value) & 0x80000000u;
+    }
+
+    // Initial guess from the exponent bits, then Newton steps: the first one leaves a
+    // relative error of 1.7e-3, the second one of 5e-6 and the third one rounding errors
+    [[nodiscard]] constexpr float fastRsqrt(float x) noexcept {
+        float y = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<std::uint32_t>(x) >> 1));
+        const float half = 0.5f * x;
+        y = y * (1.5f - half * y * y);
+        y = y * (1.5f - half * y * y);
+        y = y * (1.5f - half * y * y);
+        return y;
+    }
+
+    // x * rsqrt(x) corrected by one more step. rsqrt(0) is finite, so sqrt(0) is 0.
+    [[nodiscard]] constexpr float fastSqrt(float x) noexcept {
+        const float inverse = fastRsqrt(x);
+        const float root = x * inverse;
+        return root + 0.5f * inverse * (x - root * root);
+    }
+
+    // asin on [0, 0.5], the polynomial of the Cephes library
+    [[nodiscard]] constexpr float asinPolynomial(float x) noexcept {
+        const float z = x * x;
+        const float p = (((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z + 7.4953002686e-2f) * z + 1.6666752422e-1f;
+        return x + x * z * p;
+    }
+
+    // Above 0.5, acos(x) = 2 * asin(sqrt((1 - x) / 2)). Below, acos(x) = pi / 2 - asin(x).
+    [[nodiscard]] constexpr float fastAcos(float x) noexcept {
+        // Clamps |x| to 1 on the bits, which also turns NaN into 1
+        const float absolute = std::bit_cast<float>(std::min(std::bit_cast<std::uint32_t>(x) & 0x7fffffffu, 0x3f800000u));
+        const bool large = absolute > 0.5f;
+        const float reduced = select(large, fastSqrt(0.5f - 0.5f * absolute), absolute);
+        const float asin = asinPolynomial(reduced);
+        const float from_large = select(signBit(x) != 0, PI - 2.f * asin, 2.f * asin);
+        const float from_small = HALF_PI - flipSign(asin, signBit(x));
+        return select(large, from_large, from_small);
+    }
+
+    // atan on [-tan(pi / 8), tan(pi / 8)], the polynomial of the Cephes library
+    [[nodiscard]] constexpr float atanPolynomial(float x) noexcept {
+        const float z = x * x;
+        const float p = ((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f;
+        return x + x * z * p;
+    }
+
+    // Reduces to atan(t) with t = min / max of |x| and |y| in [0, 1], and to
+    // [0, tan(pi / 8)] with atan(t) = pi / 4 + atan((t - 1) / (t + 1))
+    [[nodiscard]] constexpr float fastAtan2(float y, float x) noexcept {
+        const float absolute_x = std::abs(x);
+        const float absolute_y = std::abs(y);
+        const bool steep = absolute_y > absolute_x;
+        const float numerator = select(steep, absolute_x, absolute_y);
+        const float denominator = select(steep, absolute_y, absolute_x);
+        const float t = select(denominator == 0.f, 0.f, numerator / denominator);
+        const bool large = t > 0.41421356f;
+        const float reduced = select(large, (t - 1.f) / (t + 1.f), t);
+        float angle = atanPolynomial(reduced) + select(large, PI / 4.f, 0.f);
+        angle = select(steep, HALF_PI - angle, angle);
+        angle = select(signBit(x) != 0, PI - angle, angle);
+        return flipSign(angle, signBit(y));
+    }
+
+    // Largest argument of fastSin and fastCos, the reduction below is exact up to 1.6e6
+    inline constexpr float FAST_TRIG_RANGE = 1e6f;
+
+    [[nodiscard]] constexpr bool inFastTrigRange(float x) noexcept {
+        return std::abs(x) <= FAST_TRIG_RANGE;
+    }
+
+    // x = q * pi / 2 + r with |r| <= pi / 4, computed in double with pi / 2 split in
+    // two parts (Cody and Waite): q times the first one, which has 33 significant bits,
+    // is exact for |q| < 2^20. Close to multiples of pi / 2, r is much smaller than x
+    // and a float reduction would leave only a few correct bits.
+    // q is rounded by adding 1.5 * 2^23, which leaves it in the low bits of the float,
+    // and only these bits tell the quadrant. Unlike a conversion to int this is defined
+    // for any x, but outside FAST_TRIG_RANGE (infinities and NaN included) the result
+    // is meaningless.
+    struct QuarterTurns {
+        std::uint32_t q;
+        float r;
+    };
+
+    [[nodiscard]] constexpr QuarterTurns reduceQuarterTurns(float x) noexcept {
+        constexpr float ROUNDING = 12582912.f;
+        const float rounded = x * 0.636619772f + ROUNDING;
+        const auto quarter_turns = static_cast<double>(rounded - ROUNDING);
+        double r = static_cast<double>(x) - quarter_turns * 1.57079632673412561417e+00;
+        r = r - quarter_turns * 6.07710050650619224932e-11;
+        return {std::bit_cast<std::uint32_t>(rounded), static_cast<float>(r)};
+    }
+
+    // sin or cos of x = q * pi / 2 + r: quadrant q + 1 of sin is quadrant q of cos
+    [[nodiscard]] constexpr float sinQuadrant(std::uint32_t q, float r) noexcept {
+        const float z = r * r;
+        const float sin = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+        const float cos = 1.f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+        const float result = select((q & 1u) != 0, cos, sin);
+        return flipSign(result, (q & 2u) << 30);
+    }
+
+    [[nodiscard]] constexpr float fastSin(float x) noexcept {
+        const auto [q, r] = reduceQuarterTurns(x);
+        return sinQuadrant(q, r);
+    }
+
+    [[nodiscard]] constexpr float fastCos(float x) noexcept {
+        const auto [q, r] = reduceQuarterTurns(x);
+        return sinQuadrant(q + 1u, r);
+    }
+
+    // The fast angle between vectors of the given squared lengths, NaN when one of them
+    // is null like the 0 / 0 cosine of Vector::angle. rsqrt(0) is finite and would give pi / 2.
+    [[nodiscard]] constexpr float angleOrNaN(float angle, float lhs_length_squared, float rhs_length_squared) noexcept {
+        constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+        return select(lhs_length_squared == 0.f, NaN, select(rhs_length_squared == 0.f, NaN, angle));
+    }
+
+    // out[i] = function(i). The blocks go through a local buffer, so the loop
+    // vectorizes even when out is also an input. fix(begin, block) can then correct
+    // the results of a block, while the inputs are still intact.
+    template <typename FUNCTION, typename FIX>
+    void generateFloats(std::span<float> out, FUNCTION function, FIX fix) noexcept {
+        constexpr std::size_t BLOCK_SIZE = 256;
+        float buffer[BLOCK_SIZE];
+        forEachBlock<BLOCK_SIZE>(out.size(), [&](std::size_t begin, auto count){
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                buffer[i] = function(begin + i);
+            }
+            fix(begin, std::span<float>(buffer, count));
+            std::copy(buffer, buffer + count, out.data() + begin);
+        });
+    }
+
+    template <typename FUNCTION>
+    void generateFloats(std::span<float> out, FUNCTION function) noexcept {
+        generateFloats(out, function, [](std::size_t, std::span<float>){});
+    }
+
+    // Batched fastSin or fastCos, the arguments outside FAST_TRIG_RANGE go to <cmath>
+    template <typename FAST, typename EXACT>
+    void generateTrig(std::span<const float> in, std::span<float> out, FAST fast, EXACT exact) noexcept {
+        generateFloats(out, [in, fast](std::size_t i){ return fast(in[i]); }, [in, exact](std::size_t begin, std::span<float> block){
+            // A branch free scan first, blocks with only small arguments are the common case
+            std::uint32_t outside = 0;
+            for(std::size_t i = 0; i < block.size(); ++i)
+            {
+                outside |= static_cast<std::uint32_t>(!inFastTrigRange(in[begin + i]));
+            }
+            for(std::size_t i = 0; outside != 0 && i < block.size(); ++i)
+            {
+                if(!inFastTrigRange(in[begin + i]))
+                {
+                    block[i] = exact(in[begin + i]);
+                }
+            }
+        });
+    }
+}
+
+namespace math
+{
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T rsqrt(T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::fastRsqrt(x);
+        }
+        else
+        {
+            return T{1} / std::sqrt(x);
+        }
+    }
+
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T sqrt(T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::fastSqrt(x);
+        }
+        else
+        {
+            return std::sqrt(x);
+        }
+    }
+
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T acos(T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::fastAcos(x);
+        }
+        else
+        {
+            return std::acos(x);
+        }
+    }
+
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T atan2(T y, T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::fastAtan2(y, x);
+        }
+        else
+        {
+            return std::atan2(y, x);
+        }
+    }
+
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T sin(T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::inFastTrigRange(x) ? detail::fastSin(x) : std::sin(x);
+        }
+        else
+        {
+            return std::sin(x);
+        }
+    }
+
+    template <Precision P = Precision::fast, std::floating_point T>
+    [[nodiscard]] constexpr T cos(T x) noexcept {
+        if constexpr (useFast<P, T>)
+        {
+            return detail::inFastTrigRange(x) ? detail::fastCos(x) : std::cos(x);
+        }
+        else
+        {
+            return std::cos(x);
+        }
+    }
+
+    // Batched versions, out[i] = f(in[i]). out can be in.
+
+    template <Precision P = Precision::fast>
+    void rsqrt(std::span<const float> in, std::span<float> out) noexcept {
+        assert(in.size() == out.size());
+        detail::generateFloats(out, [in](std::size_t i){ return rsqrt<P>(in[i]); });
+    }
+
+    template <Precision P = Precision::fast>
+    void sqrt(std::span<const float> in, std::span<float> out) noexcept {
+        assert(in.size() == out.size());
+        detail::generateFloats(out, [in](std::size_t i){ return sqrt<P>(in[i]); });
+    }
+
+    template <Precision P = Precision::fast>
+    void acos(std::span<const float> in, std::span<float> out) noexcept {
+        assert(in.size() == out.size());
+        detail::generateFloats(out, [in](std::size_t i){ return acos<P>(in[i]); });
+    }
+
+    template <Precision P = Precision::fast>
+    void sin(std::span<const float> in, std::span<float> out) noexcept {
+        assert(in.size() == out.size());
+        if constexpr (useFast<P, float>)
+        {
+            detail::generateTrig(in, out, [](float x){ return detail::fastSin(x); }, [](float x){ return std::sin(x); });
+        }
+        else
+        {
+            detail::generateFloats(out, [in](std::size_t i){ return sin<P>(in[i]); });
+        }
+    }
+
+    template <Precision P = Precision::fast>
+    void cos(std::span<const float> in, std::span<float> out) noexcept {
+        assert(in.size() == out.size());
+        if constexpr (useFast<P, float>)
+        {
+            detail::generateTrig(in, out, [](float x){ return detail::fastCos(x); }, [](float x){ return std::cos(x); });
+        }
+        else
+        {
+            detail::generateFloats(out, [in](std::size_t i){ return cos<P>(in[i]); });
+        }
+    }
+
+    // out[i] = atan2(y[i], x[i]). out can be y or x.
+    template <Precision P = Precision::fast>
+    void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept {
+        assert(y.size() == out.size() && x.size() == out.size());
+        detail::generateFloats(out, [y, x](std::size_t i){ return atan2<P>(y[i], x[i]); });
+    }
+}
+
+#endif // FAST_MATH_HPP
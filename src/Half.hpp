@@ -0,0 +1,152 @@
+#ifndef HALF_HPP
+#define HALF_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+// IEEE 754 binary16 storage type: half the bytes of a float, 11 significant bits
+// (about 3 decimal digits) and a range of +-65504. It is meant for storing large
+// amounts of data, arithmetic converts to float.
+// Conversions round to nearest even and keep infinities, NaNs and subnormals. They
+// use the F16C instructions when the target has them (e.g. -mf16c or -march=native)
+// and an exact bit manipulation fallback otherwise.
+
+namespace detail
+{
+    [[nodiscard]] constexpr std::uint16_t floatToHalfBits(float value) noexcept {
+        constexpr std::uint32_t SIGN_MASK = 0x80000000u;
+        constexpr std::uint32_t HALF_OVERFLOW = 0x47800000u;  // 65536.f, rounds to infinity
+        constexpr std::uint32_t HALF_NORMAL_MIN = 0x38800000u;  // 2^-14
+        constexpr std::uint32_t FLOAT_INFINITY = 0x7f800000u;
+        // Adding 0.5f aligns the subnormal half mantissa with the low float bits
+        constexpr std::uint32_t SUBNORMAL_MAGIC = 0x3f000000u;
+
+        std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+        const std::uint32_t sign = bits & SIGN_MASK;
+        bits ^= sign;
+        std::uint32_t result;
+        if(bits >= HALF_OVERFLOW)
+        {
+            result = bits > FLOAT_INFINITY ? 0x7e00u : 0x7c00u;
+        }
+        else if(bits < HALF_NORMAL_MIN)
+        {
+            const float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(SUBNORMAL_MAGIC);
+            result = std::bit_cast<std::uint32_t>(aligned) - SUBNORMAL_MAGIC;
+        }
+        else
+        {
+            const std::uint32_t odd_mantissa = (bits >> 13) & 1u;
+            // Rebias the exponent from 127 to 15 and round to nearest even
+            bits += 0xc8000fffu + odd_mantissa;
+            result = bits >> 13;
+        }
+        return static_cast<std::uint16_t>(result | (sign >> 16));
+    }
+
+    [[nodiscard]] constexpr float halfBitsToFloat(std::uint16_t half) noexcept {
+        constexpr std::uint32_t SHIFTED_EXPONENT = 0x7c00u << 13;
+        constexpr std::uint32_t SUBNORMAL_MAGIC = 113u << 23;
+
+        std::uint32_t bits = (half & 0x7fffu) << 13;
+        const std::uint32_t exponent = bits & SHIFTED_EXPONENT;
+        bits += (127u - 15u) << 23;
+        if(exponent == SHIFTED_EXPONENT)
+        {
+            bits += (128u - 16u) << 23;  // infinity or NaN
+        }
+        else if(exponent == 0)
+        {
+            bits += 1u << 23;  // zero or subnormal, renormalized by the float subtraction
+            bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(SUBNORMAL_MAGIC));
+        }
+        bits |= (half & 0x8000u) << 16;
+        return std::bit_cast<float>(bits);
+    }
+}
+
+class Half {
+public:
+    constexpr Half() noexcept = default;
+
+    constexpr explicit Half(float value) noexcept {
+#if defined(__F16C__)
+        if(!std::is_constant_evaluated())
+        {
+            m_bits = _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+            return;
+        }
+#endif
+        m_bits = detail::floatToHalfBits(value);
+    }
+
+    [[nodiscard]] static constexpr Half fromBits(std::uint16_t bits) noexcept {
+        Half result;
+        result.m_bits = bits;
+        return result;
+    }
+
+    [[nodiscard]] constexpr std::uint16_t bits() const noexcept {
+        return m_bits;
+    }
+
+    constexpr operator float() const noexcept {
+#if defined(__F16C__)
+        if(!std::is_constant_evaluated())
+        {
+            return _cvtsh_ss(m_bits);
+        }
+#endif
+        return detail::halfBitsToFloat(m_bits);
+    }
+
+private:
+    std::uint16_t m_bits{};
+};
+
+// Bulk conversions. Vector<Half, SIZE> and Vector<float, SIZE> convert through
+// these, so the converting constructor and convertVectors share the kernels.
+
+constexpr void convertComponents(const float * in, Half * out, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__F16C__)
+    if(!std::is_constant_evaluated())
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128i halves = _mm_cvtps_ph(_mm_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), halves);
+        }
+    }
+#endif
+    for(; i < count; ++i)
+    {
+        out[i] = Half(in[i]);
+    }
+}
+
+constexpr void convertComponents(const Half * in, float * out, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__F16C__)
+    if(!std::is_constant_evaluated())
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128i halves = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i));
+            _mm_storeu_ps(out + i, _mm_cvtph_ps(halves));
+        }
+    }
+#endif
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
+
+#endif // HALF_HPP
@@ -0,0 +1,224 @@
+#ifndef KD_TREE_HPP
+#define KD_TREE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "SpatialQueries.hpp"
+#include "Vector.hpp"
+
+// Static k-d tree over a set of points, for nearest neighbor and radius queries in
+// O(log n) instead of the O(n) of a brute force search. Results are indices into the
+// span given to build(), and match bruteForceNearest and bruteForceRadius.
+// Nodes are stored in one array in depth first order: the left child of a node is the
+// next node, so descending to the near side is mostly a walk forward in memory. Each
+// leaf keeps up to LEAF_SIZE points, copied in tree order so a leaf is scanned as one
+// contiguous block. Splits are at the median of the widest axis, so the depth is
+// about log2(n / LEAF_SIZE).
+template <typename T, std::size_t SIZE> requires (std::floating_point<T> && SIZE > 0)
+class KdTree : public SpatialBatchQueries<KdTree<T, SIZE>, T, SIZE> {
+public:
+    using value_type = T;
+    using vector_type = Vector<T, SIZE>;
+
+    static constexpr std::size_t LEAF_SIZE = 16;
+
+    KdTree() noexcept = default;
+
+    explicit KdTree(std::span<const vector_type> points) {
+        build(points);
+    }
+
+    // Replaces the points, there can be up to 2^32 - 1
+    void build(std::span<const vector_type> points) {
+        assert(points.size() < std::numeric_limits<std::uint32_t>::max());
+        m_nodes.clear();
+        // Partitioning copies of the points keeps the accesses sequential
+        std::vector<Entry> entries(points.size());
+        for(std::size_t i = 0; i < points.size(); ++i)
+        {
+            entries[i] = {points[i], static_cast<std::uint32_t>(i)};
+        }
+        if(!entries.empty())
+        {
+            m_nodes.reserve(2 * entries.size() / LEAF_SIZE + 1);
+            buildNode(entries, 0, static_cast<std::uint32_t>(entries.size()));
+        }
+        m_points.resize(entries.size());
+        m_indices.resize(entries.size());
+        for(std::size_t i = 0; i < entries.size(); ++i)
+        {
+            m_points[i] = entries[i].position;
+            m_indices[i] = entries[i].index;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_points.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_points.empty();
+    }
+
+    // Appends the points at distance <= radius of center, in no particular order
+    void radius(const vector_type & center, T radius, std::vector<std::uint32_t> & out) const {
+        if(empty())
+        {
+            return;
+        }
+        const T radius_squared = radius * radius;
+        std::array<std::uint32_t, MAX_DEPTH> stack;
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while(top > 0)
+        {
+            const Node & node = m_nodes[stack[--top]];
+            if(node.axis == LEAF)
+            {
+                for(std::uint32_t i = node.index; i < node.index + node.count; ++i)
+                {
+                    if(distanceSquared(m_points[i], center) <= radius_squared)
+                    {
+                        out.push_back(m_indices[i]);
+                    }
+                }
+                continue;
+            }
+            const T difference = center[node.axis] - node.split;
+            const std::uint32_t left = static_cast<std::uint32_t>(&node - m_nodes.data()) + 1;
+            if(difference * difference <= radius_squared)
+            {
+                stack[top++] = left;
+                stack[top++] = node.index;
+            }
+            else
+            {
+                stack[top++] = difference < T{0} ? left : node.index;
+            }
+        }
+    }
+
+    // Appends the k nearest points to center, nearest first
+    void nearest(const vector_type & center, std::size_t k, std::vector<std::uint32_t> & out) const {
+        if(k == 0 || empty())
+        {
+            return;
+        }
+        detail::NearestNeighbors<T> neighbors(std::min(k, size()));
+        // Nodes to visit with a lower bound of the squared distance to their points
+        std::array<std::pair<std::uint32_t, T>, MAX_DEPTH> stack;
+        std::size_t top = 0;
+        stack[top++] = {0, T{0}};
+        while(top > 0)
+        {
+            const auto [index, bound] = stack[--top];
+            if(bound > neighbors.bound())
+            {
+                continue;
+            }
+            const Node & node = m_nodes[index];
+            if(node.axis == LEAF)
+            {
+                for(std::uint32_t i = node.index; i < node.index + node.count; ++i)
+                {
+                    const T distance = distanceSquared(m_points[i], center);
+                    if(distance <= neighbors.bound())
+                    {
+                        neighbors.add(distance, m_indices[i]);
+                    }
+                }
+                continue;
+            }
+            const T difference = center[node.axis] - node.split;
+            const std::uint32_t near = difference < T{0} ? index + 1 : node.index;
+            const std::uint32_t far = difference < T{0} ? node.index : index + 1;
+            // The near side is on top, so it is visited first and tightens the bound
+            stack[top++] = {far, std::max(bound, difference * difference)};
+            stack[top++] = {near, bound};
+        }
+        neighbors.appendSorted(out);
+    }
+
+    // Batched queries, one result per center
+    using SpatialBatchQueries<KdTree, T, SIZE>::radius;
+    using SpatialBatchQueries<KdTree, T, SIZE>::nearest;
+
+private:
+    static constexpr std::uint32_t LEAF = std::numeric_limits<std::uint32_t>::max();
+    // The tree is balanced and has less than 2^32 points
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    struct Node {
+        T split{};
+        // Split axis, or LEAF
+        std::uint32_t axis = LEAF;
+        // Inner nodes: the right child. Leaves: the first point.
+        std::uint32_t index = 0;
+        std::uint32_t count = 0;
+    };
+
+    struct Entry {
+        vector_type position;
+        std::uint32_t index;
+    };
+
+    // Builds the subtree of entries[begin, end) and returns its node
+    std::uint32_t buildNode(std::vector<Entry> & entries, std::uint32_t begin, std::uint32_t end) {
+        const auto node = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+        if(end - begin <= LEAF_SIZE)
+        {
+            m_nodes[node].index = begin;
+            m_nodes[node].count = end - begin;
+            return node;
+        }
+
+        vector_type low = entries[begin].position;
+        vector_type high = low;
+        for(std::uint32_t i = begin + 1; i < end; ++i)
+        {
+            const vector_type & point = entries[i].position;
+            for(std::size_t c = 0; c < SIZE; ++c)
+            {
+                low[c] = std::min(low[c], point[c]);
+                high[c] = std::max(high[c], point[c]);
+            }
+        }
+        std::uint32_t axis = 0;
+        for(std::uint32_t c = 1; c < SIZE; ++c)
+        {
+            if(high[c] - low[c] > high[axis] - low[axis])
+            {
+                axis = c;
+            }
+        }
+
+        const std::uint32_t middle = begin + (end - begin) / 2;
+        const auto first = entries.begin();
+        std::nth_element(first + begin, first + middle, first + end, [axis](const Entry & a, const Entry & b){
+            return a.position[axis] < b.position[axis];
+        });
+        m_nodes[node].split = entries[middle].position[axis];
+        m_nodes[node].axis = axis;
+        buildNode(entries, begin, middle);
+        const std::uint32_t right = buildNode(entries, middle, end);
+        m_nodes[node].index = right;
+        return node;
+    }
+
+    std::vector<Node> m_nodes;
+    // Points in tree order and their index in the span given to build
+    std::vector<vector_type> m_points;
+    std::vector<std::uint32_t> m_indices;
+};
+
+#endif // KD_TREE_HPP
@@ -1,8 +1,21 @@
 #ifndef MATH_HPP
 #define MATH_HPP
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <cmath>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Vector.hpp"
+#include "VectorTuple.hpp"
 
 template <typename T>
 [[nodiscard]] consteval bool equals(const T & a, const T & b, const float & epsilon = std::numeric_limits<T>::epsilon()) noexcept
@@ -13,4 +26,223 @@ template <typename T>
         return false;
 }
 
+// Tolerances of is_close and all_close. Two values are close when they are equal or
+// when any of the three holds:
+// * |a - b| <= absolute, for values near zero.
+// * |a - b| <= relative * max(|a|, |b|).
+// * a and b are at most ulps representable values apart.
+// The default tolerance only accepts equal values. NaN is never close, not even to
+// NaN, and infinities are only close to themselves.
+template <std::floating_point T>
+struct Tolerance {
+    T absolute{};
+    T relative{};
+    std::uint64_t ulps = 0;
+};
+
+namespace detail
+{
+    template <typename T>
+    struct FloatBits;
+
+    template <>
+    struct FloatBits<float> {
+        using type = std::uint32_t;
+    };
+
+    template <>
+    struct FloatBits<double> {
+        using type = std::uint64_t;
+    };
+
+    // Unsigned integer that orders like the float, with -0 right below +0
+    template <std::floating_point T>
+    [[nodiscard]] constexpr auto orderedBits(T value) noexcept {
+        using U = typename FloatBits<T>::type;
+        constexpr U SIGN = U{1} << (sizeof(U) * 8 - 1);
+        const U bits = std::bit_cast<U>(value);
+        const U negative = U{0} - (bits >> (sizeof(U) * 8 - 1));
+        return static_cast<U>(bits ^ (negative | SIGN));
+    }
+
+    // Without branches, only bitwise operations on the conditions, so loops vectorize.
+    // USE_ULPS = false skips the distance in ULPs, for tolerances with ulps = 0.
+    template <bool USE_ULPS = true, std::floating_point T>
+    [[nodiscard]] constexpr bool isClose(T a, T b, T absolute, T relative, typename FloatBits<T>::type ulps) noexcept {
+        using U = typename FloatBits<T>::type;
+        constexpr U MAGNITUDE = std::numeric_limits<U>::max() >> 1;
+        constexpr U INFINITY_BITS = std::bit_cast<U>(std::numeric_limits<T>::infinity());
+        const U magnitude_a = std::bit_cast<U>(a) & MAGNITUDE;
+        const U magnitude_b = std::bit_cast<U>(b) & MAGNITUDE;
+        const bool finite = (magnitude_a < INFINITY_BITS) & (magnitude_b < INFINITY_BITS);
+        const T difference = std::bit_cast<T>(static_cast<U>(std::bit_cast<U>(a - b) & MAGNITUDE));
+        const T scale = std::bit_cast<T>(std::max(magnitude_a, magnitude_b));
+        const bool within = (difference <= absolute) | (difference <= relative * scale);
+        if constexpr (USE_ULPS)
+        {
+            const U ordered_a = orderedBits(a);
+            const U ordered_b = orderedBits(b);
+            const U distance = static_cast<U>(std::max(ordered_a, ordered_b) - std::min(ordered_a, ordered_b));
+            return (a == b) | (finite & (within | (distance <= ulps)));
+        }
+        else
+        {
+            return (a == b) | (finite & within);
+        }
+    }
+
+    template <std::floating_point T>
+    [[nodiscard]] constexpr bool isClose(T a, T b, const Tolerance<T> & tolerance) noexcept {
+        using U = typename FloatBits<T>::type;
+        const auto ulps = static_cast<U>(std::min<std::uint64_t>(tolerance.ulps, std::numeric_limits<U>::max()));
+        return isClose(a, b, tolerance.absolute, tolerance.relative, ulps);
+    }
+}
+
+template <std::floating_point T>
+[[nodiscard]] constexpr bool is_close(T a, T b, const std::type_identity_t<Tolerance<T>> & tolerance = {}) noexcept {
+    return detail::isClose(a, b, tolerance);
+}
+
+// Every component is close
+template <std::floating_point T, std::size_t SIZE>
+[[nodiscard]] constexpr bool is_close(const Vector<T, SIZE> & a, const Vector<T, SIZE> & b, const std::type_identity_t<Tolerance<T>> & tolerance = {}) noexcept {
+    for(std::size_t c = 0; c < SIZE; ++c)
+    {
+        if(!detail::isClose(a[c], b[c], tolerance))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every component is close, components of MixedStorage are compared as value_type
+template <std::floating_point T, std::size_t SIZE, typename STORAGE>
+[[nodiscard]] constexpr bool is_close(const VectorTuple<T, SIZE, STORAGE> & a, const VectorTuple<T, SIZE, STORAGE> & b, const std::type_identity_t<Tolerance<T>> & tolerance = {}) noexcept {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (detail::isClose(static_cast<T>(a.template get<Is>()), static_cast<T>(b.template get<Is>()), tolerance) && ...);
+    }(std::make_index_sequence<SIZE>());
+}
+
+// Result of all_close, true when every element is close
+struct CloseReport {
+    // Number of elements that are not close
+    std::size_t mismatches = 0;
+    // Indices of the first of them, in increasing order
+    std::vector<std::size_t> first_mismatches;
+
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return mismatches == 0;
+    }
+};
+
+namespace detail
+{
+    // Scalar type compared by all_close for ranges of E
+    template <typename E>
+    struct CloseTraits {
+        using value_type = E;
+        static constexpr std::size_t size = 1;
+        // Elements stored as size values of value_type without padding
+        static constexpr bool flat = true;
+
+        [[nodiscard]] static const value_type * values(const E * elements) noexcept {
+            return elements;
+        }
+    };
+
+    template <typename T, std::size_t SIZE>
+    struct CloseTraits<Vector<T, SIZE>> {
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+        static constexpr bool flat = sizeof(Vector<T, SIZE>) == SIZE * sizeof(T);
+
+        [[nodiscard]] static const value_type * values(const Vector<T, SIZE> * elements) noexcept {
+            return elements->begin();
+        }
+    };
+
+    template <typename T, std::size_t SIZE, typename STORAGE>
+    struct CloseTraits<VectorTuple<T, SIZE, STORAGE>> {
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+        static constexpr bool flat = STORAGE::contiguous && sizeof(VectorTuple<T, SIZE, STORAGE>) == SIZE * sizeof(T);
+
+        [[nodiscard]] static const value_type * values(const VectorTuple<T, SIZE, STORAGE> * elements) noexcept requires STORAGE::contiguous {
+            return elements->data();
+        }
+    };
+
+    template <std::ranges::contiguous_range R>
+    using CloseValue = typename CloseTraits<std::ranges::range_value_t<R>>::value_type;
+
+    template <bool USE_ULPS, typename T, typename COUNT>
+    [[nodiscard]] std::uint32_t countNotClose(const T * actual, const T * expected, COUNT count, T absolute, T relative, typename FloatBits<T>::type ulps) noexcept {
+        std::uint32_t result = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            result += static_cast<std::uint32_t>(!isClose<USE_ULPS>(actual[i], expected[i], absolute, relative, ulps));
+        }
+        return result;
+    }
+}
+
+// Compares two contiguous ranges of the same size, of floats or of Vector or
+// VectorTuple of floats, element by element with is_close. The report has the number
+// of elements that are not close and the indices of the first max_reported of them.
+// Elements stored as plain arrays of floats are first compared in blocks, in a loop
+// that vectorizes, and only the blocks with mismatches are compared element by element.
+template <std::ranges::contiguous_range ACTUAL, std::ranges::contiguous_range EXPECTED>
+    requires std::is_same_v<std::ranges::range_value_t<ACTUAL>, std::ranges::range_value_t<EXPECTED>>
+[[nodiscard]] CloseReport all_close(const ACTUAL & actual, const EXPECTED & expected, const Tolerance<detail::CloseValue<ACTUAL>> & tolerance = {}, std::size_t max_reported = 8) {
+    using element_type = std::ranges::range_value_t<ACTUAL>;
+    using traits = detail::CloseTraits<element_type>;
+    using T = typename traits::value_type;
+    using U = typename detail::FloatBits<T>::type;
+    assert(std::ranges::size(actual) == std::ranges::size(expected));
+
+    const element_type * actual_data = std::ranges::data(actual);
+    const element_type * expected_data = std::ranges::data(expected);
+    const std::size_t count = std::ranges::size(actual);
+    CloseReport report;
+    const auto compareElements = [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            if(!is_close(actual_data[i], expected_data[i], tolerance))
+            {
+                if(report.first_mismatches.size() < max_reported)
+                {
+                    report.first_mismatches.push_back(i);
+                }
+                ++report.mismatches;
+            }
+        }
+    };
+
+    if constexpr (traits::flat)
+    {
+        // Blocks of values holding 256 whole elements
+        constexpr std::size_t BLOCK_SIZE = 256 * traits::size;
+        const auto ulps = static_cast<U>(std::min<std::uint64_t>(tolerance.ulps, std::numeric_limits<U>::max()));
+        detail::forEachBlock<BLOCK_SIZE>(count * traits::size, [&](std::size_t begin, auto value_count){
+            const std::size_t element = begin / traits::size;
+            const T * actual_values = traits::values(actual_data + element);
+            const T * expected_values = traits::values(expected_data + element);
+            const std::uint32_t not_close = ulps == 0 ?
+                detail::countNotClose<false>(actual_values, expected_values, value_count, tolerance.absolute, tolerance.relative, ulps) :
+                detail::countNotClose<true>(actual_values, expected_values, value_count, tolerance.absolute, tolerance.relative, ulps);
+            if(not_close > 0)
+            {
+                compareElements(element, element + value_count / traits::size);
+            }
+        });
+    }
+    else
+    {
+        compareElements(0, count);
+    }
+    return report;
+}
+
 #endif
@@ -0,0 +1,318 @@
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorArray.hpp"
+
+// Dense ROWS x COLUMNS matrix stored row-major in one contiguous array.
+// Vectors are columns: matrix * vector transforms the vector, and for square
+// matrices the product a * b applies b first.
+template<typename T, std::size_t ROWS, std::size_t COLUMNS> requires (ROWS > 0 && COLUMNS > 0)
+class Matrix {
+public:
+    using value_type = T;
+    using row_type = Vector<T, COLUMNS>;
+    using column_type = Vector<T, ROWS>;
+    // Points and directions in homogeneous coordinates have one component less
+    using point_type = Vector<T, (ROWS > 1 ? ROWS - 1 : 1)>;
+
+    static constexpr std::size_t rows = ROWS;
+    static constexpr std::size_t columns = COLUMNS;
+
+    // Zero matrix
+    constexpr Matrix() noexcept = default;
+
+    // Values in row-major order
+    template <typename... U> requires (sizeof...(U) == ROWS * COLUMNS && ROWS * COLUMNS > 1)
+    constexpr Matrix(U... values) noexcept : m_data{detail::convertTo<T>(values)...} {
+    }
+
+    [[nodiscard]] static constexpr Matrix identity() noexcept requires (ROWS == COLUMNS) {
+        Matrix result;
+        for(std::size_t i = 0; i < ROWS; ++i)
+        {
+            result(i, i) = T{1};
+        }
+        return result;
+    }
+
+    // Homogeneous translation, e.g. a 4x4 matrix moving 3D points
+    [[nodiscard]] static constexpr Matrix translation(const point_type & offset) noexcept requires (ROWS == COLUMNS && ROWS > 1) {
+        Matrix result = identity();
+        for(std::size_t r = 0; r + 1 < ROWS; ++r)
+        {
+            result(r, COLUMNS - 1) = offset[r];
+        }
+        return result;
+    }
+
+    // Diagonal scale, the last diagonal element stays 1 for homogeneous scales
+    template <std::size_t SIZE> requires (ROWS == COLUMNS && (SIZE == ROWS || SIZE + 1 == ROWS))
+    [[nodiscard]] static constexpr Matrix scaling(const Vector<T, SIZE> & factors) noexcept {
+        Matrix result = identity();
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            result(i, i) = factors[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr const value_type & operator()(std::size_t row, std::size_t column) const noexcept {
+        assert(row < ROWS && column < COLUMNS);
+        return m_data[row * COLUMNS + column];
+    }
+
+    [[nodiscard]] constexpr value_type & operator()(std::size_t row, std::size_t column) noexcept {
+        assert(row < ROWS && column < COLUMNS);
+        return m_data[row * COLUMNS + column];
+    }
+
+    [[nodiscard]] constexpr row_type row(std::size_t row) const noexcept {
+        row_type result{};
+        for(std::size_t c = 0; c < COLUMNS; ++c)
+        {
+            result[c] = (*this)(row, c);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr column_type column(std::size_t column) const noexcept {
+        column_type result{};
+        for(std::size_t r = 0; r < ROWS; ++r)
+        {
+            result[r] = (*this)(r, column);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr const value_type * data() const noexcept {
+        return m_data.data();
+    }
+
+    [[nodiscard]] constexpr Matrix<T, COLUMNS, ROWS> transposed() const noexcept {
+        Matrix<T, COLUMNS, ROWS> result;
+        for(std::size_t r = 0; r < ROWS; ++r)
+        {
+            for(std::size_t c = 0; c < COLUMNS; ++c)
+            {
+                result(c, r) = (*this)(r, c);
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr Matrix operator+(const Matrix & rhs) const noexcept {
+        Matrix result;
+        std::transform(m_data.begin(), m_data.end(), rhs.m_data.begin(), result.m_data.begin(), std::plus<T>());
+        return result;
+    }
+
+    [[nodiscard]] constexpr Matrix operator-(const Matrix & rhs) const noexcept {
+        Matrix result;
+        std::transform(m_data.begin(), m_data.end(), rhs.m_data.begin(), result.m_data.begin(), std::minus<T>());
+        return result;
+    }
+
+    template <typename U> requires (std::integral<U> or std::floating_point<U>)
+    [[nodiscard]] constexpr Matrix operator*(const U & scalar) const noexcept {
+        Matrix result;
+        std::transform(m_data.begin(), m_data.end(), result.m_data.begin(), [scalar](const auto & element){
+            return detail::convertTo<T>(element * scalar);
+        });
+        return result;
+    }
+
+    template <std::size_t OTHER_COLUMNS>
+    [[nodiscard]] constexpr Matrix<T, ROWS, OTHER_COLUMNS> operator*(const Matrix<T, COLUMNS, OTHER_COLUMNS> & rhs) const noexcept {
+        Matrix<T, ROWS, OTHER_COLUMNS> result;
+        for(std::size_t r = 0; r < ROWS; ++r)
+        {
+            for(std::size_t k = 0; k < COLUMNS; ++k)
+            {
+                const T value = (*this)(r, k);
+                for(std::size_t c = 0; c < OTHER_COLUMNS; ++c)
+                {
+                    result(r, c) = detail::convertTo<T>(result(r, c) + value * rhs(k, c));
+                }
+            }
+        }
+        return result;
+    }
+
+    // Products are accumulated in column order
+    [[nodiscard]] constexpr column_type operator*(const row_type & vector) const noexcept {
+        column_type result{};
+        for(std::size_t r = 0; r < ROWS; ++r)
+        {
+            T sum{};
+            for(std::size_t c = 0; c < COLUMNS; ++c)
+            {
+                sum = detail::convertTo<T>(sum + (*this)(r, c) * vector[c]);
+            }
+            result[r] = sum;
+        }
+        return result;
+    }
+
+    // Affine transform of a point: the last column is added and the last row ignored
+    [[nodiscard]] constexpr point_type transformPoint(const point_type & point) const noexcept requires (ROWS == COLUMNS && ROWS > 1) {
+        point_type result{};
+        for(std::size_t r = 0; r + 1 < ROWS; ++r)
+        {
+            T sum{};
+            for(std::size_t c = 0; c + 1 < COLUMNS; ++c)
+            {
+                sum = detail::convertTo<T>(sum + (*this)(r, c) * point[c]);
+            }
+            result[r] = detail::convertTo<T>(sum + (*this)(r, COLUMNS - 1));
+        }
+        return result;
+    }
+
+    // Affine transform of a direction: like transformPoint without the translation
+    [[nodiscard]] constexpr point_type transformDirection(const point_type & direction) const noexcept requires (ROWS == COLUMNS && ROWS > 1) {
+        point_type result{};
+        for(std::size_t r = 0; r + 1 < ROWS; ++r)
+        {
+            T sum{};
+            for(std::size_t c = 0; c + 1 < COLUMNS; ++c)
+            {
+                sum = detail::convertTo<T>(sum + (*this)(r, c) * direction[c]);
+            }
+            result[r] = sum;
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Matrix & rhs) const noexcept = default;
+
+private:
+    std::array<T, ROWS * COLUMNS> m_data{};
+};
+
+// Batched transforms.
+// The matrix is copied into a local before the loop: the output cannot alias
+// it, so its elements stay in registers instead of being reloaded per vector.
+// Every output is computed as the single vector versions above compute it, and
+// the input and output may be the same storage.
+
+template <typename T, std::size_t ROWS, std::size_t COLUMNS>
+void transform(const Matrix<T, ROWS, COLUMNS> & matrix, std::type_identity_t<std::span<const Vector<T, COLUMNS>>> in, std::type_identity_t<std::span<Vector<T, ROWS>>> out) noexcept {
+    assert(in.size() == out.size());
+    const Matrix<T, ROWS, COLUMNS> local = matrix;
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = local * in[i];
+    }
+}
+
+template <typename T, std::size_t SIZE>
+void transformPoints(const Matrix<T, SIZE, SIZE> & matrix, std::type_identity_t<std::span<const Vector<T, SIZE - 1>>> in, std::type_identity_t<std::span<Vector<T, SIZE - 1>>> out) noexcept {
+    assert(in.size() == out.size());
+    const Matrix<T, SIZE, SIZE> local = matrix;
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = local.transformPoint(in[i]);
+    }
+}
+
+template <typename T, std::size_t SIZE>
+void transformDirections(const Matrix<T, SIZE, SIZE> & matrix, std::type_identity_t<std::span<const Vector<T, SIZE - 1>>> in, std::type_identity_t<std::span<Vector<T, SIZE - 1>>> out) noexcept {
+    assert(in.size() == out.size());
+    const Matrix<T, SIZE, SIZE> local = matrix;
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        out[i] = local.transformDirection(in[i]);
+    }
+}
+
+namespace detail
+{
+    // Structure of arrays kernel over COUNT vectors starting at begin: out lane r =
+    // sum over c of matrix(r, c) * in lane c, plus the last column when TRANSLATE.
+    // The results go to a block first, so in and out may be the same array.
+    template <bool TRANSLATE, typename T, std::size_t ROWS, std::size_t COLUMNS, std::size_t IN, std::size_t OUT, typename COUNT>
+    void transformBlock(const Matrix<T, ROWS, COLUMNS> & matrix, const VectorArray<T, IN> & in, VectorArray<T, OUT> & out, std::size_t begin, COUNT count) noexcept {
+        constexpr std::size_t BLOCK_SIZE = 256;
+        std::array<std::array<T, BLOCK_SIZE>, OUT> block;
+        for(std::size_t r = 0; r < OUT; ++r)
+        {
+            T * result = block[r].data();
+            const T * lane = in.lane(0).data() + begin;
+            const T factor = matrix(r, 0);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                result[i] = convertTo<T>(factor * lane[i]);
+            }
+            for(std::size_t c = 1; c < IN; ++c)
+            {
+                lane = in.lane(c).data() + begin;
+                const T next_factor = matrix(r, c);
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    result[i] = convertTo<T>(result[i] + next_factor * lane[i]);
+                }
+            }
+            if constexpr (TRANSLATE)
+            {
+                const T offset = matrix(r, COLUMNS - 1);
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    result[i] = convertTo<T>(result[i] + offset);
+                }
+            }
+        }
+        for(std::size_t r = 0; r < OUT; ++r)
+        {
+            std::copy_n(block[r].begin(), static_cast<std::size_t>(count), out.lane(r).begin() + static_cast<std::ptrdiff_t>(begin));
+        }
+    }
+
+    // Full blocks use a compile time count, so their loops have a fixed trip count
+    template <bool TRANSLATE, typename T, std::size_t ROWS, std::size_t COLUMNS, std::size_t IN, std::size_t OUT>
+    void transformLanes(const Matrix<T, ROWS, COLUMNS> & matrix, const VectorArray<T, IN> & in, VectorArray<T, OUT> & out) {
+        constexpr std::size_t BLOCK_SIZE = 256;
+        const Matrix<T, ROWS, COLUMNS> local = matrix;
+        out.resize(in.size());
+        forEachBlock<BLOCK_SIZE>(in.size(), [&](std::size_t begin, auto count){
+            transformBlock<TRANSLATE>(local, in, out, begin, count);
+        });
+    }
+}
+
+template <typename T, std::size_t ROWS, std::size_t COLUMNS>
+void transform(const Matrix<T, ROWS, COLUMNS> & matrix, const std::type_identity_t<VectorArray<T, COLUMNS>> & in, std::type_identity_t<VectorArray<T, ROWS>> & out) {
+    detail::transformLanes<false>(matrix, in, out);
+}
+
+template <typename T, std::size_t SIZE>
+void transformPoints(const Matrix<T, SIZE, SIZE> & matrix, const std::type_identity_t<VectorArray<T, SIZE - 1>> & in, std::type_identity_t<VectorArray<T, SIZE - 1>> & out) {
+    detail::transformLanes<true>(matrix, in, out);
+}
+
+template <typename T, std::size_t SIZE>
+void transformDirections(const Matrix<T, SIZE, SIZE> & matrix, const std::type_identity_t<VectorArray<T, SIZE - 1>> & in, std::type_identity_t<VectorArray<T, SIZE - 1>> & out) {
+    detail::transformLanes<false>(matrix, in, out);
+}
+
+template <typename T>
+using Matrix3 = Matrix<T, 3, 3>;
+
+template <typename T>
+using Matrix4 = Matrix<T, 4, 4>;
+
+using Matrix3f = Matrix3<float>;
+using Matrix3d = Matrix3<double>;
+
+using Matrix4f = Matrix4<float>;
+using Matrix4d = Matrix4<double>;
+
+#endif // MATRIX_HPP
@@ -0,0 +1,15 @@
+#ifndef MEMORY_MAP_HPP
+#define MEMORY_MAP_HPP
+
+// Internal: detects the POSIX memory mapping functions used by RingCaptureBuffer and
+// VectorFile. CPPUTILS_DETAIL_HAS_MMAP is an implementation detail of these headers,
+// RingCaptureBuffer::SPILL_SUPPORTED tells users whether spill files are available.
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CPPUTILS_DETAIL_HAS_MMAP
+#endif
+
+#endif // MEMORY_MAP_HPP
@@ -4,18 +4,67 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "AsyncSinkBuffer.hpp"
+#include "ConcurrentCaptureBuffer.hpp"
+#include "RingCaptureBuffer.hpp"
 
 namespace juan
 {
     class OstreamRedirector
     {
     public:
-        explicit OstreamRedirector(std::ostream & stream):
+        enum class Capture
+        {
+            // Single std::stringstream, only one thread may write to the stream
+            Buffered,
+            // Per-thread buffers merged line by line, see ConcurrentCaptureBuffer
+            Concurrent,
+            // Fixed size ring read through chunks(), see RingCaptureBuffer
+            Ring
+        };
+
+        static constexpr std::size_t DEFAULT_RING_CAPACITY = 1 << 16;
+
+        // ring_capacity and spill_path are only used by Capture::Ring. The spill file is
+        // created with a random suffix appended to spill_path and unlinked right away.
+        explicit OstreamRedirector(std::ostream & stream, Capture capture = Capture::Buffered,
+            std::size_t ring_capacity = DEFAULT_RING_CAPACITY, const std::filesystem::path & spill_path = {}):
             m_stream{stream}
+        {
+            if(capture == Capture::Concurrent)
+            {
+                m_concurrent = std::make_unique<ConcurrentCaptureBuffer>();
+            }
+            else if(capture == Capture::Ring)
+            {
+                m_ring = std::make_unique<RingCaptureBuffer>(ring_capacity, spill_path);
+            }
+            start();
+        }
+
+        // Forwards the output to sink from a background thread instead of capturing it
+        OstreamRedirector(std::ostream & stream, AsyncSinkBuffer::Sink sink, AsyncSinkBuffer::Options options = {}):
+            m_stream{stream},
+            m_async{std::make_unique<AsyncSinkBuffer>(std::move(sink), options)}
         {
             start();
         }
 
+#if __has_include(<unistd.h>)
+        // Forwards the output to a file descriptor from a background thread
+        OstreamRedirector(std::ostream & stream, int fd, AsyncSinkBuffer::Options options = {}):
+            m_stream{stream},
+            m_async{std::make_unique<AsyncSinkBuffer>(fd, options)}
+        {
+            start();
+        }
+#endif
+
         ~OstreamRedirector()
         {
             assert(m_p_cout != nullptr);
@@ -32,9 +81,24 @@ namespace juan
 
         void start()
         {
-            m_p_cout = m_stream.rdbuf(m_captured.rdbuf());
+            std::streambuf * buffer = m_captured.rdbuf();
+            if(m_concurrent)
+            {
+                buffer = m_concurrent.get();
+            }
+            else if(m_ring)
+            {
+                buffer = m_ring.get();
+            }
+            else if(m_async)
+            {
+                buffer = m_async.get();
+            }
+            m_p_cout = m_stream.rdbuf(buffer);
         }
 
+        // In concurrent mode the unfinished lines of every thread are kept, so the
+        // writer threads must be done by the time stop() is called
         void stop()
         {
             assert(m_p_cout != nullptr);
@@ -42,22 +106,91 @@ namespace juan
             {
                 m_stream.rdbuf(m_p_cout);
             }
+            if(m_concurrent)
+            {
+                m_concurrent->publishAll();
+            }
+            if(m_async)
+            {
+                m_async->flush();
+            }
+        }
+
+        // Forwarding only: waits until everything written so far reached the sink
+        void flush()
+        {
+            assert(m_async);
+            m_async->flush();
         }
 
+        // In concurrent mode, only one thread may call get() or clear() at a time.
+        // Nothing is captured when forwarding to a sink.
         std::string get() const
         {
+            if(m_concurrent)
+            {
+                return m_concurrent->str();
+            }
+            if(m_ring)
+            {
+                return m_ring->str();
+            }
             return m_captured.str();
         }
 
         void clear()
         {
+            if(m_concurrent)
+            {
+                m_concurrent->clear();
+                return;
+            }
+            if(m_ring)
+            {
+                m_ring->clear();
+                return;
+            }
             m_captured.str(std::string());
         }
 
+        // Capture::Concurrent only: stream of the calling thread with its own formatting
+        // state. The redirected stream is shared by every thread and operator<< changes
+        // its width, so only its unformatted write() and put() are safe from several threads.
+        [[nodiscard]] std::ostream & threadStream()
+        {
+            assert(m_concurrent);
+            return m_concurrent->threadStream();
+        }
+
+        // Capture::Ring only: views of the captured bytes without copying them
+        [[nodiscard]] RingCaptureBuffer::Chunks chunks()
+        {
+            assert(m_ring);
+            return m_ring->chunks();
+        }
+
+        // Capture::Ring only: frees the oldest count captured bytes
+        void consume(std::size_t count)
+        {
+            assert(m_ring);
+            m_ring->consume(count);
+        }
+
+        // Capture::Ring only: calls function(std::string_view) over the captured bytes and consumes them
+        template <typename FUNCTION>
+        std::size_t drain(FUNCTION && function)
+        {
+            assert(m_ring);
+            return m_ring->drain(std::forward<FUNCTION>(function));
+        }
+
     private:
         std::ostream & m_stream;
         std::streambuf * m_p_cout = {nullptr};
         std::stringstream m_captured;
+        std::unique_ptr<ConcurrentCaptureBuffer> m_concurrent;
+        std::unique_ptr<RingCaptureBuffer> m_ring;
+        std::unique_ptr<AsyncSinkBuffer> m_async;
     };
 }
 
@@ -0,0 +1,206 @@
+#ifndef QUANTIZED_VECTORS_HPP
+#define QUANTIZED_VECTORS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Vector.hpp"
+
+namespace detail
+{
+    // Compares the bits of the absolute values, which order like the values for
+    // non NaN floats, because integer maximums vectorize and float ones do not.
+    // Infinities and NaN have larger bits than any finite float, so the result is only
+    // finite when every component is.
+    [[nodiscard]] inline float maxAbsComponent(const float * in, std::size_t count) noexcept {
+        std::uint32_t result = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            result = std::max(result, std::bit_cast<std::uint32_t>(in[i]) & 0x7fffffffu);
+        }
+        return std::bit_cast<float>(result);
+    }
+
+    // Rounds half away from zero. The clamp only absorbs rounding errors of the scale,
+    // it is done on integers so the loop has no branches and vectorizes.
+    template <typename Q, typename COUNT>
+    void quantizeBlock(const float * in, Q * out, COUNT count, float inverse) noexcept {
+        constexpr int MAX = std::numeric_limits<Q>::max();
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const float scaled = in[i] * inverse;
+            const int rounded = static_cast<int>(scaled + std::copysign(0.5f, scaled));
+            out[i] = static_cast<Q>(std::clamp(rounded, -MAX, MAX));
+        }
+    }
+
+    template <typename Q, typename COUNT>
+    void dequantizeBlock(const Q * in, float * out, COUNT count, float scale) noexcept {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = static_cast<float>(in[i]) * scale;
+        }
+    }
+
+    inline constexpr std::size_t QUANTIZE_BLOCK_SIZE = 256;
+
+    template <typename Q>
+    void quantizeComponents(const float * in, Q * out, std::size_t count, float inverse) noexcept {
+        forEachBlock<QUANTIZE_BLOCK_SIZE>(count, [=](std::size_t begin, auto block_count){
+            quantizeBlock(in + begin, out + begin, block_count, inverse);
+        });
+    }
+
+    template <typename Q>
+    void dequantizeComponents(const Q * in, float * out, std::size_t count, float scale) noexcept {
+        forEachBlock<QUANTIZE_BLOCK_SIZE>(count, [=](std::size_t begin, auto block_count){
+            dequantizeBlock(in + begin, out + begin, block_count, scale);
+        });
+    }
+}
+
+// Array of Vector<float, SIZE> stored as normalized signed integers with one scale for
+// the whole array: component = integer * scale. With Q = std::int16_t a Vector3f takes
+// 6 bytes instead of 12, and every decoded component is within scale / 2 of the encoded
+// one. The scale is chosen by encode() so the largest absolute component maps to the
+// largest integer. Q is narrower than int, e.g. std::int8_t or std::int16_t.
+template <std::signed_integral Q, std::size_t SIZE> requires (SIZE > 0 && sizeof(Q) < sizeof(int))
+class QuantizedVectors {
+public:
+    using value_type = Vector<float, SIZE>;
+    using quantized_type = Vector<Q, SIZE>;
+
+    static constexpr float MAX_QUANTIZED = static_cast<float>(std::numeric_limits<Q>::max());
+
+    QuantizedVectors() noexcept = default;
+
+    explicit QuantizedVectors(std::span<const value_type> vectors) {
+        encode(vectors);
+    }
+
+    // Previously encoded data, e.g. read from a file
+    QuantizedVectors(std::vector<quantized_type> quantized, float scale) noexcept :
+        m_quantized(std::move(quantized)),
+        m_scale{scale} {
+        assert(scale > 0.f);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_quantized.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_quantized.empty();
+    }
+
+    [[nodiscard]] float scale() const noexcept {
+        return m_scale;
+    }
+
+    [[nodiscard]] std::span<const quantized_type> quantized() const noexcept {
+        return m_quantized;
+    }
+
+    // Replaces the contents and chooses a new scale. The components must be finite:
+    // an infinity or a NaN would make the scale meaningless, so encode throws
+    // std::invalid_argument and leaves the contents unchanged.
+    void encode(std::span<const value_type> vectors) {
+        float max_abs = 0.f;
+        if constexpr (PACKED)
+        {
+            if(!vectors.empty())
+            {
+                max_abs = detail::maxAbsComponent(vectors.front().begin(), vectors.size() * SIZE);
+            }
+        }
+        else
+        {
+            // On the bits too, std::max would drop a NaN
+            std::uint32_t max_bits = 0;
+            for(const auto & vector : vectors)
+            {
+                max_bits = std::max(max_bits, std::bit_cast<std::uint32_t>(detail::maxAbsComponent(vector.begin(), SIZE)));
+            }
+            max_abs = std::bit_cast<float>(max_bits);
+        }
+        if(!std::isfinite(max_abs))
+        {
+            throw std::invalid_argument("QuantizedVectors::encode: components must be finite");
+        }
+
+        m_quantized.resize(vectors.size());
+        // Components so small that the scale underflows are all quantized to 0
+        const float scale = max_abs / MAX_QUANTIZED;
+        m_scale = scale > 0.f ? scale : 1.f;
+        const float inverse = 1.f / m_scale;
+        if constexpr (PACKED)
+        {
+            detail::quantizeComponents(vectors.front().begin(), m_quantized.front().begin(), vectors.size() * SIZE, inverse);
+        }
+        else
+        {
+            for(std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                detail::quantizeComponents(vectors[i].begin(), m_quantized[i].begin(), SIZE, inverse);
+            }
+        }
+    }
+
+    void decode(std::span<value_type> out) const noexcept {
+        assert(out.size() == size());
+        if constexpr (PACKED)
+        {
+            if(!empty())
+            {
+                detail::dequantizeComponents(m_quantized.front().begin(), out.front().begin(), size() * SIZE, m_scale);
+            }
+        }
+        else
+        {
+            for(std::size_t i = 0; i < size(); ++i)
+            {
+                out[i] = get(i);
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<value_type> decode() const {
+        std::vector<value_type> result(size());
+        decode(result);
+        return result;
+    }
+
+    [[nodiscard]] value_type get(std::size_t index) const noexcept {
+        assert(index < size());
+        value_type result{};
+        detail::dequantizeComponents(m_quantized[index].begin(), result.begin(), SIZE, m_scale);
+        return result;
+    }
+
+    // The vector must be finite and fit in the current scale
+    void set(std::size_t index, const value_type & vector) noexcept {
+        assert(index < size());
+        const float inverse = 1.f / m_scale;
+        assert(detail::maxAbsComponent(vector.begin(), SIZE) * inverse < MAX_QUANTIZED + 0.5f);
+        detail::quantizeComponents(vector.begin(), m_quantized[index].begin(), SIZE, inverse);
+    }
+
+private:
+    // Without padding (e.g. SIMD Vector3f has some) the whole array is one run of components
+    static constexpr bool PACKED = sizeof(value_type) == SIZE * sizeof(float) && sizeof(quantized_type) == SIZE * sizeof(Q);
+
+    std::vector<quantized_type> m_quantized;
+    float m_scale = 1.f;
+};
+
+#endif // QUANTIZED_VECTORS_HPP
@@ -0,0 +1,443 @@
+#ifndef REDUCTIONS_HPP
+#define REDUCTIONS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Aabb.hpp"
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+#include "VectorKernels.hpp"
+#include "VectorTuple.hpp"
+
+// Reductions over contiguous ranges of Vector or VectorTuple: sums, dot product sums,
+// per component bounds, means and covariances. Components of MixedStorage are reduced
+// as value_type. Every reduction also takes a juan::ThreadPool, which reduces chunks of
+// grain vectors in parallel and then reduces the chunk results in order, so the result
+// only depends on the grain, not on the number of threads or on their timing.
+// Within a chunk, several vectors are reduced at once in independent accumulators,
+// a loop that vectorizes.
+
+// How float sums are accumulated, integer sums ignore it:
+// * simple: one rounding per addition, the error grows with the number of values.
+// * pairwise: blocks of simple sums added as a balanced tree, the error grows with
+//   the logarithm of the number of values, for about the cost of a simple sum.
+// * kahan: compensated summation, the error does not grow with the number of values,
+//   for about four times the cost of a simple sum.
+enum class Summation {
+    simple,
+    pairwise,
+    kahan
+};
+
+namespace detail
+{
+    template <typename E>
+    struct ReductionTraits;
+
+    template <typename T, std::size_t SIZE>
+    struct ReductionTraits<Vector<T, SIZE>> {
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+
+        [[nodiscard]] static constexpr std::array<T, SIZE> components(const Vector<T, SIZE> & vector) noexcept {
+            std::array<T, SIZE> result;
+            for(std::size_t c = 0; c < SIZE; ++c)
+            {
+                result[c] = vector[c];
+            }
+            return result;
+        }
+    };
+
+    template <typename T, std::size_t SIZE, typename STORAGE>
+    struct ReductionTraits<VectorTuple<T, SIZE, STORAGE>> {
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+
+        [[nodiscard]] static constexpr std::array<T, SIZE> components(const VectorTuple<T, SIZE, STORAGE> & vector) noexcept {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<T, SIZE>{static_cast<T>(vector.template get<Is>())...};
+            }(std::make_index_sequence<SIZE>());
+        }
+    };
+
+    template <std::ranges::contiguous_range R>
+    using ReductionTraitsOf = ReductionTraits<std::ranges::range_value_t<R>>;
+
+    // Vectors reduced at once, with N accumulators of T each: about 96 bytes of
+    // accumulators, as many as the SSE registers hold next to the loaded values
+    template <typename T, std::size_t N>
+    inline constexpr std::size_t REDUCTION_LANES = std::max<std::size_t>(1, 96 / (N * sizeof(T)));
+
+    // Vectors per simple sum of a pairwise sum
+    inline constexpr std::size_t PAIRWISE_BLOCK_SIZE = 256;
+
+    template <typename T, std::size_t N>
+    constexpr void addTerms(std::array<T, N> & sum, const std::array<T, N> & terms) noexcept {
+        unroll<N>([&](std::size_t j){ sum[j] += terms[j]; });
+    }
+
+    // sum + terms compensated by compensation, which keeps the lost low order bits
+    template <typename T, std::size_t N>
+    constexpr void addTerms(std::array<T, N> & sum, std::array<T, N> & compensation, const std::array<T, N> & terms) noexcept {
+        unroll<N>([&](std::size_t j){
+            const T term = terms[j] - compensation[j];
+            const T next = sum[j] + term;
+            compensation[j] = (next - sum[j]) - term;
+            sum[j] = next;
+        });
+    }
+
+    // Sums terms(i), an array of N values, over [begin, end)
+    template <typename T, std::size_t N, typename TERMS>
+    [[nodiscard]] std::array<T, N> simpleSum(std::size_t begin, std::size_t end, TERMS & terms) noexcept {
+        constexpr std::size_t LANES = REDUCTION_LANES<T, N>;
+        std::array<std::array<T, N>, LANES> lanes{};
+        std::size_t i = begin;
+        for(; i + LANES <= end; i += LANES)
+        {
+            unroll<LANES>([&](std::size_t k){ addTerms(lanes[k], terms(i + k)); });
+        }
+        std::array<T, N> result{};
+        for(std::size_t k = 0; k < LANES; ++k)
+        {
+            addTerms(result, lanes[k]);
+        }
+        for(; i < end; ++i)
+        {
+            addTerms(result, terms(i));
+        }
+        return result;
+    }
+
+    template <typename T, std::size_t N, typename TERMS>
+    [[nodiscard]] std::array<T, N> kahanSum(std::size_t begin, std::size_t end, TERMS & terms) noexcept {
+        constexpr std::size_t LANES = REDUCTION_LANES<T, N>;
+        std::array<std::array<T, N>, LANES> lanes{};
+        std::array<std::array<T, N>, LANES> compensations{};
+        std::size_t i = begin;
+        for(; i + LANES <= end; i += LANES)
+        {
+            unroll<LANES>([&](std::size_t k){ addTerms(lanes[k], compensations[k], terms(i + k)); });
+        }
+        std::array<T, N> result{};
+        std::array<T, N> compensation{};
+        for(std::size_t k = 0; k < LANES; ++k)
+        {
+            addTerms(result, compensation, lanes[k]);
+            for(auto & value : compensations[k])
+            {
+                value = -value;
+            }
+            addTerms(result, compensation, compensations[k]);
+        }
+        for(; i < end; ++i)
+        {
+            addTerms(result, compensation, terms(i));
+        }
+        return result;
+    }
+
+    // Simple sums of blocks, added as they complete like the digits of a binary
+    // counter: block sums of equal weight are added together, the largest weights last
+    template <typename T, std::size_t N, typename TERMS>
+    [[nodiscard]] std::array<T, N> pairwiseSum(std::size_t begin, std::size_t end, TERMS & terms) noexcept {
+        std::array<std::array<T, N>, 64> pending;
+        std::size_t depth = 0;
+        std::size_t blocks = 0;
+        for(std::size_t block = begin; block < end; block += PAIRWISE_BLOCK_SIZE)
+        {
+            std::array<T, N> sum = simpleSum<T, N>(block, std::min(block + PAIRWISE_BLOCK_SIZE, end), terms);
+            ++blocks;
+            for(std::size_t weight = blocks; (weight & 1) == 0; weight >>= 1)
+            {
+                std::array<T, N> & lower = pending[--depth];
+                addTerms(lower, sum);
+                sum = lower;
+            }
+            pending[depth++] = sum;
+        }
+        std::array<T, N> result{};
+        while(depth > 0)
+        {
+            addTerms(result, pending[--depth]);
+        }
+        return result;
+    }
+
+    template <Summation S, typename T, std::size_t N, typename TERMS>
+    [[nodiscard]] std::array<T, N> sumTerms(std::size_t begin, std::size_t end, TERMS && terms) noexcept {
+        if constexpr (!std::floating_point<T> || S == Summation::simple)
+        {
+            return simpleSum<T, N>(begin, end, terms);
+        }
+        else if constexpr (S == Summation::pairwise)
+        {
+            return pairwiseSum<T, N>(begin, end, terms);
+        }
+        else
+        {
+            return kahanSum<T, N>(begin, end, terms);
+        }
+    }
+
+    // The chunk sums are summed again with S
+    template <Summation S, typename T, std::size_t N, typename TERMS>
+    [[nodiscard]] std::array<T, N> sumTerms(juan::ThreadPool & pool, std::size_t count, std::size_t grain, TERMS && terms) {
+        grain = std::max<std::size_t>(grain, 1);
+        std::vector<std::array<T, N>> partials((count + grain - 1) / grain);
+        pool.parallelFor(count, grain, [&](std::size_t begin, std::size_t end){
+            partials[begin / grain] = sumTerms<S, T, N>(begin, end, terms);
+        });
+        return sumTerms<S, T, N>(0, partials.size(), [&](std::size_t i){ return partials[i]; });
+    }
+
+    template <typename T, std::size_t SIZE>
+    [[nodiscard]] constexpr Vector<T, SIZE> toVector(const std::array<T, SIZE> & components) noexcept {
+        // Value initialized, so the padding lane of the SIMD storage is not left undefined
+        Vector<T, SIZE> result{};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = components[c];
+        }
+        return result;
+    }
+
+    // Comparisons that skip NaN, in independent lanes like simpleSum. Minimums and
+    // maximums are kept in arrays of their own, so every lane is one min or max instruction.
+    template <typename T, std::size_t SIZE, typename E>
+    [[nodiscard]] Aabb<T, SIZE> bounds(const E * vectors, std::size_t begin, std::size_t end) noexcept {
+        constexpr std::size_t LANES = REDUCTION_LANES<T, 2 * SIZE>;
+        std::array<std::array<T, SIZE>, LANES> low;
+        std::array<std::array<T, SIZE>, LANES> high;
+        for(std::size_t k = 0; k < LANES; ++k)
+        {
+            low[k].fill(std::numeric_limits<T>::max());
+            high[k].fill(std::numeric_limits<T>::lowest());
+        }
+        const auto add = [](std::array<T, SIZE> & lane_low, std::array<T, SIZE> & lane_high, const std::array<T, SIZE> & components){
+            unroll<SIZE>([&](std::size_t c){
+                lane_low[c] = components[c] < lane_low[c] ? components[c] : lane_low[c];
+                lane_high[c] = lane_high[c] < components[c] ? components[c] : lane_high[c];
+            });
+        };
+        std::size_t i = begin;
+        for(; i + LANES <= end; i += LANES)
+        {
+            unroll<LANES>([&](std::size_t k){ add(low[k], high[k], ReductionTraits<E>::components(vectors[i + k])); });
+        }
+        for(; i < end; ++i)
+        {
+            add(low[0], high[0], ReductionTraits<E>::components(vectors[i]));
+        }
+        Aabb<T, SIZE> result{toVector(low[0]), toVector(high[0])};
+        for(std::size_t k = 1; k < LANES; ++k)
+        {
+            result = result.merged(Aabb<T, SIZE>{toVector(low[k]), toVector(high[k])});
+        }
+        return result;
+    }
+
+    // Products lhs[c] * rhs[c]: summed per component, they vectorize like vectorSum
+    template <typename E>
+    [[nodiscard]] auto componentProducts(const E * lhs, const E * rhs) noexcept {
+        return [lhs, rhs](std::size_t i){
+            auto products = ReductionTraits<E>::components(lhs[i]);
+            const auto rhs_components = ReductionTraits<E>::components(rhs[i]);
+            unroll<products.size()>([&](std::size_t c){ products[c] *= rhs_components[c]; });
+            return products;
+        };
+    }
+
+    template <typename T, std::size_t SIZE>
+    [[nodiscard]] constexpr T componentSum(const std::array<T, SIZE> & components) noexcept {
+        T result = components[0];
+        for(std::size_t c = 1; c < SIZE; ++c)
+        {
+            result += components[c];
+        }
+        return result;
+    }
+
+    // Row and column of the elements of the upper triangle of a SIZE x SIZE matrix, row by row
+    template <std::size_t SIZE>
+    inline constexpr auto UPPER_TRIANGLE = []{
+        std::array<std::pair<std::size_t, std::size_t>, SIZE * (SIZE + 1) / 2> result;
+        std::size_t j = 0;
+        for(std::size_t r = 0; r < SIZE; ++r)
+        {
+            for(std::size_t c = r; c < SIZE; ++c)
+            {
+                result[j++] = {r, c};
+            }
+        }
+        return result;
+    }();
+
+    // Products (v - mean)[r] * (v - mean)[c] of the upper triangle
+    template <typename E, typename T, std::size_t SIZE>
+    [[nodiscard]] auto centeredProducts(const E * vectors, const Vector<T, SIZE> & mean) noexcept {
+        return [vectors, mean](std::size_t i){
+            const std::array<T, SIZE> components = ReductionTraits<E>::components(vectors[i]);
+            std::array<T, SIZE> centered;
+            unroll<SIZE>([&](std::size_t c){ centered[c] = components[c] - mean[c]; });
+            std::array<T, UPPER_TRIANGLE<SIZE>.size()> products;
+            unroll<products.size()>([&](std::size_t j){
+                products[j] = centered[UPPER_TRIANGLE<SIZE>[j].first] * centered[UPPER_TRIANGLE<SIZE>[j].second];
+            });
+            return products;
+        };
+    }
+
+    template <typename T, std::size_t SIZE>
+    [[nodiscard]] constexpr Matrix<T, SIZE, SIZE> covarianceMatrix(const std::array<T, SIZE * (SIZE + 1) / 2> & sums, std::size_t count) noexcept {
+        Matrix<T, SIZE, SIZE> result;
+        for(std::size_t j = 0; j < sums.size(); ++j)
+        {
+            const auto [r, c] = UPPER_TRIANGLE<SIZE>[j];
+            result(r, c) = sums[j] / static_cast<T>(count);
+            result(c, r) = result(r, c);
+        }
+        return result;
+    }
+}
+
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorSum(const R & vectors) noexcept {
+    using traits = detail::ReductionTraitsOf<R>;
+    using T = typename traits::value_type;
+    const auto * data = std::ranges::data(vectors);
+    return detail::toVector(detail::sumTerms<S, T, traits::size>(0, std::ranges::size(vectors), [data](std::size_t i){
+        return traits::components(data[i]);
+    }));
+}
+
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorSum(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    using traits = detail::ReductionTraitsOf<R>;
+    using T = typename traits::value_type;
+    const auto * data = std::ranges::data(vectors);
+    return detail::toVector(detail::sumTerms<S, T, traits::size>(pool, std::ranges::size(vectors), grain, [data](std::size_t i){
+        return traits::components(data[i]);
+    }));
+}
+
+// Sum of lhs[i] * rhs[i], e.g. the sum of the squared lengths with lhs = rhs
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range LHS, std::ranges::contiguous_range RHS>
+    requires std::is_same_v<std::ranges::range_value_t<LHS>, std::ranges::range_value_t<RHS>>
+[[nodiscard]] auto vectorDotSum(const LHS & lhs, const RHS & rhs) noexcept {
+    using traits = detail::ReductionTraitsOf<LHS>;
+    using T = typename traits::value_type;
+    assert(std::ranges::size(lhs) == std::ranges::size(rhs));
+    const auto * lhs_data = std::ranges::data(lhs);
+    const auto * rhs_data = std::ranges::data(rhs);
+    return detail::componentSum(detail::sumTerms<S, T, traits::size>(0, std::ranges::size(lhs), detail::componentProducts(lhs_data, rhs_data)));
+}
+
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range LHS, std::ranges::contiguous_range RHS>
+    requires std::is_same_v<std::ranges::range_value_t<LHS>, std::ranges::range_value_t<RHS>>
+[[nodiscard]] auto vectorDotSum(juan::ThreadPool & pool, const LHS & lhs, const RHS & rhs, std::size_t grain = 1 << 16) {
+    using traits = detail::ReductionTraitsOf<LHS>;
+    using T = typename traits::value_type;
+    assert(std::ranges::size(lhs) == std::ranges::size(rhs));
+    const auto * lhs_data = std::ranges::data(lhs);
+    const auto * rhs_data = std::ranges::data(rhs);
+    return detail::componentSum(detail::sumTerms<S, T, traits::size>(pool, std::ranges::size(lhs), grain, detail::componentProducts(lhs_data, rhs_data)));
+}
+
+// Smallest and largest value of every component, Aabb::inverted() for an empty range.
+// NaN components are skipped.
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorBounds(const R & vectors) noexcept {
+    using traits = detail::ReductionTraitsOf<R>;
+    return detail::bounds<typename traits::value_type, traits::size>(std::ranges::data(vectors), 0, std::ranges::size(vectors));
+}
+
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorBounds(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    using traits = detail::ReductionTraitsOf<R>;
+    using box_type = Aabb<typename traits::value_type, traits::size>;
+    const auto * data = std::ranges::data(vectors);
+    return pool.parallelReduce(std::ranges::size(vectors), grain, box_type::inverted(), [data](std::size_t begin, std::size_t end){
+        return detail::bounds<typename traits::value_type, traits::size>(data, begin, end);
+    }, [](const box_type & a, const box_type & b){
+        return a.merged(b);
+    });
+}
+
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorMin(const R & vectors) noexcept {
+    return vectorBounds(vectors).min;
+}
+
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorMax(const R & vectors) noexcept {
+    return vectorBounds(vectors).max;
+}
+
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorMin(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    return vectorBounds(pool, vectors, grain).min;
+}
+
+template <std::ranges::contiguous_range R>
+[[nodiscard]] auto vectorMax(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    return vectorBounds(pool, vectors, grain).max;
+}
+
+// Centroid of a non empty range of float vectors
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+    requires std::floating_point<typename detail::ReductionTraitsOf<R>::value_type>
+[[nodiscard]] auto vectorMean(const R & vectors) noexcept {
+    using T = typename detail::ReductionTraitsOf<R>::value_type;
+    assert(!std::ranges::empty(vectors));
+    const Vector<T, detail::ReductionTraitsOf<R>::size> sum = vectorSum<S>(vectors);
+    return Vector<T, detail::ReductionTraitsOf<R>::size>(sum / static_cast<T>(std::ranges::size(vectors)));
+}
+
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+    requires std::floating_point<typename detail::ReductionTraitsOf<R>::value_type>
+[[nodiscard]] auto vectorMean(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    using T = typename detail::ReductionTraitsOf<R>::value_type;
+    assert(!std::ranges::empty(vectors));
+    const Vector<T, detail::ReductionTraitsOf<R>::size> sum = vectorSum<S>(pool, vectors, grain);
+    return Vector<T, detail::ReductionTraitsOf<R>::size>(sum / static_cast<T>(std::ranges::size(vectors)));
+}
+
+// Population covariance of a non empty range of float vectors, the sums of the
+// products of the components minus the mean divided by the number of vectors.
+// Multiply it by n / (n - 1) for the sample covariance. Two passes over the vectors:
+// subtracting the mean first avoids the cancellation of the one pass formula.
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+    requires std::floating_point<typename detail::ReductionTraitsOf<R>::value_type>
+[[nodiscard]] auto vectorCovariance(const R & vectors) noexcept {
+    using traits = detail::ReductionTraitsOf<R>;
+    using T = typename traits::value_type;
+    constexpr std::size_t SIZE = traits::size;
+    const std::size_t count = std::ranges::size(vectors);
+    const auto sums = detail::sumTerms<S, T, SIZE * (SIZE + 1) / 2>(0, count, detail::centeredProducts(std::ranges::data(vectors), vectorMean<S>(vectors)));
+    return detail::covarianceMatrix<T, SIZE>(sums, count);
+}
+
+template <Summation S = Summation::pairwise, std::ranges::contiguous_range R>
+    requires std::floating_point<typename detail::ReductionTraitsOf<R>::value_type>
+[[nodiscard]] auto vectorCovariance(juan::ThreadPool & pool, const R & vectors, std::size_t grain = 1 << 16) {
+    using traits = detail::ReductionTraitsOf<R>;
+    using T = typename traits::value_type;
+    constexpr std::size_t SIZE = traits::size;
+    const std::size_t count = std::ranges::size(vectors);
+    const auto sums = detail::sumTerms<S, T, SIZE * (SIZE + 1) / 2>(pool, count, grain, detail::centeredProducts(std::ranges::data(vectors), vectorMean<S>(pool, vectors, grain)));
+    return detail::covarianceMatrix<T, SIZE>(sums, count);
+}
+
+#endif // REDUCTIONS_HPP
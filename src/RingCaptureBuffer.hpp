@@ -0,0 +1,361 @@
+#ifndef RINGCAPTUREBUFFER_HPP
+#define RINGCAPTUREBUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "MemoryMap.hpp"
+
+namespace juan
+{
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+    namespace detail
+    {
+        // Growable memory mapped file, unlinked as soon as it is created. The name is the
+        // given prefix followed by a random suffix (mkstemp), so the file is always a new
+        // one: existing files and symbolic links are never opened or truncated.
+        class SpillFile
+        {
+        public:
+            explicit SpillFile(const std::filesystem::path & prefix):
+                m_fd{createUnlinked(prefix.string() + "XXXXXX")}
+            {
+            }
+
+            ~SpillFile()
+            {
+                unmap();
+                ::close(m_fd);
+            }
+
+            SpillFile(const SpillFile &) = delete;
+            SpillFile & operator=(const SpillFile &) = delete;
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_tail - m_head;
+            }
+
+            [[nodiscard]] std::string_view unread() const noexcept
+            {
+                return {m_data + m_head, size()};
+            }
+
+            void append(std::string_view bytes)
+            {
+                if(m_tail + bytes.size() > m_capacity)
+                {
+                    grow(std::max({m_capacity * 2, m_tail + bytes.size(), MIN_CAPACITY}));
+                }
+                std::memcpy(m_data + m_tail, bytes.data(), bytes.size());
+                m_tail += bytes.size();
+            }
+
+            // Once everything is consumed the file is written from the start again
+            void consume(std::size_t count) noexcept
+            {
+                assert(count <= size());
+                m_head += count;
+                if(m_head == m_tail)
+                {
+                    m_head = 0;
+                    m_tail = 0;
+                }
+            }
+
+        private:
+            static constexpr std::size_t MIN_CAPACITY = 1 << 20;
+
+            [[nodiscard]] static int createUnlinked(std::string path)
+            {
+                const int fd = ::mkstemp(path.data());
+                if(fd < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "mkstemp " + path);
+                }
+                ::unlink(path.c_str());
+                ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+                return fd;
+            }
+
+            void grow(std::size_t capacity)
+            {
+                unmap();
+                if(::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "ftruncate");
+                }
+                void * data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+                if(data == MAP_FAILED)
+                {
+                    throw std::system_error(errno, std::generic_category(), "mmap");
+                }
+                m_data = static_cast<char *>(data);
+                m_capacity = capacity;
+            }
+
+            void unmap() noexcept
+            {
+                if(m_data != nullptr)
+                {
+                    ::munmap(m_data, m_capacity);
+                    m_data = nullptr;
+                }
+            }
+
+            int m_fd;
+            char * m_data = nullptr;
+            std::size_t m_capacity = 0;
+            std::size_t m_head = 0;
+            std::size_t m_tail = 0;
+        };
+    }
+#endif
+
+    // Stream buffer over a fixed size ring.
+    // The put area is the free part of the ring, so writes go straight into it, and
+    // the reader gets views of the unread bytes: nothing is copied on either side.
+    // When the ring is full the oldest unread bytes move to a spill file, if a path
+    // prefix was given for it (see detail::SpillFile), or are dropped. Reads and writes must happen on the same thread or
+    // be synchronized externally.
+    class RingCaptureBuffer : public std::streambuf
+    {
+    public:
+        // Unread bytes in order: spilled bytes first, then the ring in up to two parts
+        using Chunks = std::array<std::string_view, 3>;
+
+        // Spill files need mmap, without it a spill path must not be given
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+        static constexpr bool SPILL_SUPPORTED = true;
+#else
+        static constexpr bool SPILL_SUPPORTED = false;
+#endif
+
+        explicit RingCaptureBuffer(std::size_t capacity, const std::filesystem::path & spill_path = {}):
+            m_data{std::make_unique<char[]>(capacity)},
+            m_capacity{capacity}
+        {
+            assert(capacity > 0);
+            if(!spill_path.empty())
+            {
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+                m_spill = std::make_unique<detail::SpillFile>(spill_path);
+#else
+                assert(false && "spill files need mmap");
+#endif
+            }
+            resetPutArea();
+        }
+
+        RingCaptureBuffer(const RingCaptureBuffer &) = delete;
+        RingCaptureBuffer(RingCaptureBuffer &&) = delete;
+        RingCaptureBuffer & operator=(const RingCaptureBuffer &) = delete;
+        RingCaptureBuffer & operator=(RingCaptureBuffer &&) = delete;
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        // Unread bytes, spilled ones included
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return spilled() + ringSize() + static_cast<std::size_t>(pptr() - pbase());
+        }
+
+        // Bytes lost because the ring was full and there is no spill file
+        [[nodiscard]] std::uint64_t dropped() const noexcept
+        {
+            return m_dropped;
+        }
+
+        // Views are valid until the next write, consume() or clear()
+        [[nodiscard]] Chunks chunks() noexcept
+        {
+            commit();
+            const std::size_t begin = m_head % m_capacity;
+            const std::size_t first = std::min(ringSize(), m_capacity - begin);
+            return {
+                spillView(),
+                std::string_view{m_data.get() + begin, first},
+                std::string_view{m_data.get(), ringSize() - first}
+            };
+        }
+
+        void consume(std::size_t count) noexcept
+        {
+            commit();
+            assert(count <= size());
+            const std::size_t from_spill = std::min(count, spilled());
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            if(from_spill > 0)
+            {
+                m_spill->consume(from_spill);
+            }
+#endif
+            m_head += count - from_spill;
+            resetPutArea();
+        }
+
+        // Calls function(std::string_view) for every non empty chunk and consumes them.
+        // Returns the number of bytes drained.
+        template <typename FUNCTION>
+        std::size_t drain(FUNCTION && function)
+        {
+            std::size_t drained = 0;
+            for(const auto chunk : chunks())
+            {
+                if(!chunk.empty())
+                {
+                    function(chunk);
+                    drained += chunk.size();
+                }
+            }
+            consume(drained);
+            return drained;
+        }
+
+        // Copy of the unread bytes
+        [[nodiscard]] std::string str()
+        {
+            std::string result;
+            result.reserve(size());
+            for(const auto chunk : chunks())
+            {
+                result += chunk;
+            }
+            return result;
+        }
+
+        void clear() noexcept
+        {
+            consume(size());
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                const char c = traits_type::to_char_type(ch);
+                xsputn(&c, 1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize xsputn(const char * s, std::streamsize count) override
+        {
+            auto remaining = static_cast<std::size_t>(count);
+            while(remaining > 0)
+            {
+                commit();
+                if(pptr() == epptr())
+                {
+                    makeRoom(std::min(remaining, m_capacity));
+                    resetPutArea();
+                }
+                const auto length = std::min(remaining, static_cast<std::size_t>(epptr() - pptr()));
+                std::memcpy(pptr(), s, length);
+                m_tail += length;
+                resetPutArea();
+                s += length;
+                remaining -= length;
+            }
+            return count;
+        }
+
+        int sync() override
+        {
+            commit();
+            return 0;
+        }
+
+    private:
+        [[nodiscard]] std::size_t ringSize() const noexcept
+        {
+            return m_tail - m_head;
+        }
+
+        [[nodiscard]] std::size_t spilled() const noexcept
+        {
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            return m_spill ? m_spill->size() : 0;
+#else
+            return 0;
+#endif
+        }
+
+        [[nodiscard]] std::string_view spillView() const noexcept
+        {
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            if(m_spill)
+            {
+                return m_spill->unread();
+            }
+#endif
+            return {};
+        }
+
+        // Moves the bytes written through the put area into the ring
+        void commit() noexcept
+        {
+            m_tail += static_cast<std::size_t>(pptr() - pbase());
+            resetPutArea();
+        }
+
+        // The put area is the contiguous free space after the last written byte
+        void resetPutArea() noexcept
+        {
+            const std::size_t begin = m_tail % m_capacity;
+            const std::size_t length = std::min(m_capacity - begin, m_capacity - ringSize());
+            setp(m_data.get() + begin, m_data.get() + begin + length);
+        }
+
+        // Spills or drops the oldest bytes until count bytes are free
+        void makeRoom(std::size_t count)
+        {
+            const std::size_t free = m_capacity - ringSize();
+            if(free >= count)
+            {
+                return;
+            }
+            const std::size_t evicted = count - free;
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            if(m_spill)
+            {
+                const std::size_t begin = m_head % m_capacity;
+                const std::size_t first = std::min(evicted, m_capacity - begin);
+                m_spill->append({m_data.get() + begin, first});
+                m_spill->append({m_data.get(), evicted - first});
+                m_head += evicted;
+                return;
+            }
+#endif
+            m_dropped += evicted;
+            m_head += evicted;
+        }
+
+        std::unique_ptr<char[]> m_data;
+        std::size_t m_capacity;
+        // Total bytes read and written, the ring positions are taken modulo the capacity
+        std::size_t m_head = 0;
+        std::size_t m_tail = 0;
+        std::uint64_t m_dropped = 0;
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+        std::unique_ptr<detail::SpillFile> m_spill;
+#endif
+    };
+}
+
+#endif // RINGCAPTUREBUFFER_HPP
@@ -0,0 +1,210 @@
+#ifndef SPATIAL_QUERIES_HPP
+#define SPATIAL_QUERIES_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+
+// Shared pieces of the spatial indexes (UniformGrid.hpp, KdTree.hpp): batched queries
+// and their results, and brute force versions of the queries, as a reference.
+// Points are identified by std::uint32_t indices. k nearest neighbor results are
+// sorted by distance, ties by index, radius results are in no particular order and
+// include the points at exactly radius.
+
+// Results of a batch of queries in one buffer: neighbors of query i are
+// indices()[offsets[i], offsets[i + 1]). Reusing the object reuses its memory.
+class SpatialQueryResults {
+public:
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_offsets.size() - 1;
+    }
+
+    [[nodiscard]] std::span<const std::uint32_t> operator[](std::size_t query) const noexcept {
+        assert(query < size());
+        return std::span<const std::uint32_t>(m_indices).subspan(m_offsets[query], m_offsets[query + 1] - m_offsets[query]);
+    }
+
+    [[nodiscard]] std::span<const std::uint32_t> indices() const noexcept {
+        return m_indices;
+    }
+
+    void clear() noexcept {
+        m_offsets.resize(1);
+        m_indices.clear();
+    }
+
+    // Runs query(i, neighbors) for i in [0, count), which appends the neighbors of query i
+    template <typename QUERY>
+    void run(std::size_t count, QUERY && query) {
+        clear();
+        m_offsets.reserve(count + 1);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            query(i, m_indices);
+            m_offsets.push_back(m_indices.size());
+        }
+    }
+
+    // Same results as run, with chunks of grain queries running in parallel
+    template <typename QUERY>
+    void run(juan::ThreadPool & pool, std::size_t count, QUERY && query, std::size_t grain = 32) {
+        grain = std::max<std::size_t>(grain, 1);
+        std::vector<SpatialQueryResults> chunks((count + grain - 1) / grain);
+        pool.parallelFor(count, grain, [&](std::size_t begin, std::size_t end){
+            chunks[begin / grain].run(end - begin, [&](std::size_t i, std::vector<std::uint32_t> & neighbors){
+                query(begin + i, neighbors);
+            });
+        });
+        clear();
+        m_offsets.reserve(count + 1);
+        for(const auto & chunk : chunks)
+        {
+            const std::size_t base = m_indices.size();
+            m_indices.insert(m_indices.end(), chunk.m_indices.begin(), chunk.m_indices.end());
+            for(std::size_t i = 1; i < chunk.m_offsets.size(); ++i)
+            {
+                m_offsets.push_back(base + chunk.m_offsets[i]);
+            }
+        }
+    }
+
+private:
+    std::vector<std::size_t> m_offsets{0};
+    std::vector<std::uint32_t> m_indices;
+};
+
+// Batched queries of a spatial index, one result per center, in terms of its single
+// queries radius(center, radius, out) and nearest(center, k, out). Indexes derive from
+// it (CRTP) and bring the overloads next to their own with using declarations.
+template <typename INDEX, typename T, std::size_t SIZE>
+class SpatialBatchQueries {
+public:
+    void radius(std::span<const Vector<T, SIZE>> centers, T radius, SpatialQueryResults & results) const {
+        results.run(centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ index().radius(centers[i], radius, out); });
+    }
+
+    void radius(juan::ThreadPool & pool, std::span<const Vector<T, SIZE>> centers, T radius, SpatialQueryResults & results) const {
+        results.run(pool, centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ index().radius(centers[i], radius, out); });
+    }
+
+    void nearest(std::span<const Vector<T, SIZE>> centers, std::size_t k, SpatialQueryResults & results) const {
+        results.run(centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ index().nearest(centers[i], k, out); });
+    }
+
+    void nearest(juan::ThreadPool & pool, std::span<const Vector<T, SIZE>> centers, std::size_t k, SpatialQueryResults & results) const {
+        results.run(pool, centers.size(), [&](std::size_t i, std::vector<std::uint32_t> & out){ index().nearest(centers[i], k, out); });
+    }
+
+private:
+    [[nodiscard]] const INDEX & index() const noexcept {
+        return static_cast<const INDEX &>(*this);
+    }
+};
+
+template <typename T, std::size_t SIZE>
+[[nodiscard]] constexpr T distanceSquared(const Vector<T, SIZE> & a, const Vector<T, SIZE> & b) noexcept {
+    T result{};
+    for(std::size_t c = 0; c < SIZE; ++c)
+    {
+        const T difference = a[c] - b[c];
+        result += difference * difference;
+    }
+    return result;
+}
+
+namespace detail
+{
+    // The k > 0 best (distance, index) pairs seen so far, as a max heap on the distance
+    template <typename T>
+    class NearestNeighbors {
+    public:
+        using value_type = std::pair<T, std::uint32_t>;
+
+        explicit NearestNeighbors(std::size_t k) :
+            m_k{k} {
+            assert(k > 0);
+            m_heap.reserve(k);
+        }
+
+        [[nodiscard]] bool full() const noexcept {
+            return m_heap.size() == m_k;
+        }
+
+        // Squared distance a point must beat to enter
+        [[nodiscard]] T bound() const noexcept {
+            return full() ? m_heap.front().first : std::numeric_limits<T>::infinity();
+        }
+
+        void add(T distance, std::uint32_t index) {
+            const value_type candidate{distance, index};
+            if(!full())
+            {
+                m_heap.push_back(candidate);
+                std::push_heap(m_heap.begin(), m_heap.end());
+            }
+            else if(candidate < m_heap.front())
+            {
+                std::pop_heap(m_heap.begin(), m_heap.end());
+                m_heap.back() = candidate;
+                std::push_heap(m_heap.begin(), m_heap.end());
+            }
+        }
+
+        // Appends the indices from nearest to farthest
+        void appendSorted(std::vector<std::uint32_t> & out) {
+            std::sort_heap(m_heap.begin(), m_heap.end());
+            for(const auto & neighbor : m_heap)
+            {
+                out.push_back(neighbor.second);
+            }
+            m_heap.clear();
+        }
+
+    private:
+        std::size_t m_k;
+        std::vector<value_type> m_heap;
+    };
+}
+
+// Reference implementations, O(points) per query
+
+template <typename T, std::size_t SIZE>
+void bruteForceRadius(std::type_identity_t<std::span<const Vector<T, SIZE>>> points, const Vector<T, SIZE> & center, T radius, std::vector<std::uint32_t> & out) {
+    const T radius_squared = radius * radius;
+    for(std::size_t i = 0; i < points.size(); ++i)
+    {
+        if(distanceSquared(points[i], center) <= radius_squared)
+        {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+template <typename T, std::size_t SIZE>
+void bruteForceNearest(std::type_identity_t<std::span<const Vector<T, SIZE>>> points, const Vector<T, SIZE> & center, std::size_t k, std::vector<std::uint32_t> & out) {
+    if(k == 0 || points.empty())
+    {
+        return;
+    }
+    detail::NearestNeighbors<T> neighbors(std::min(k, points.size()));
+    for(std::size_t i = 0; i < points.size(); ++i)
+    {
+        const T distance = distanceSquared(points[i], center);
+        if(distance <= neighbors.bound())
+        {
+            neighbors.add(distance, static_cast<std::uint32_t>(i));
+        }
+    }
+    neighbors.appendSorted(out);
+}
+
+#endif // SPATIAL_QUERIES_HPP
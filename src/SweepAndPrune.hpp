@@ -0,0 +1,162 @@
+#ifndef SWEEP_AND_PRUNE_HPP
+#define SWEEP_AND_PRUNE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Aabb.hpp"
+#include "BroadPhase.hpp"
+
+// Sweep and prune broad phase: the boxes are kept sorted by their min on one axis, and
+// a sweep over that order only tests the boxes whose intervals on the axis overlap.
+// Between frames bodies move little, so the order is restored with an insertion sort
+// that costs O(n + swaps) instead of sorting again. Pick the axis along which the
+// bodies are most spread out, e.g. the horizontal one in a side view.
+template <typename T, std::size_t SIZE> requires (SIZE > 0)
+class SweepAndPrune {
+public:
+    using value_type = T;
+    using box_type = Aabb<T, SIZE>;
+
+    explicit SweepAndPrune(std::size_t axis = 0) noexcept :
+        m_axis{axis} {
+        assert(axis < SIZE);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool contains(std::uint32_t index) const noexcept {
+        return index < m_slots.size() && m_slots[index] != NONE;
+    }
+
+    [[nodiscard]] const box_type & box(std::uint32_t index) const noexcept {
+        assert(contains(index));
+        return m_entries[m_slots[index]].box;
+    }
+
+    void insert(std::uint32_t index, const box_type & box) {
+        assert(index != NONE && !contains(index));
+        if(index >= m_slots.size())
+        {
+            m_slots.resize(static_cast<std::size_t>(index) + 1, NONE);
+        }
+        m_slots[index] = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.push_back({box, index});
+        ++m_size;
+    }
+
+    void update(std::uint32_t index, const box_type & box) noexcept {
+        assert(contains(index));
+        m_entries[m_slots[index]].box = box;
+    }
+
+    // The entry stays in place until the next findPairs, which removes it
+    void erase(std::uint32_t index) noexcept {
+        assert(contains(index));
+        m_entries[m_slots[index]].index = NONE;
+        m_slots[index] = NONE;
+        --m_size;
+    }
+
+    // Bodies 0 to boxes.size() - 1 are inserted, or updated if they already are
+    void update(std::span<const box_type> boxes) {
+        assert(boxes.size() < NONE);
+        for(std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            const auto index = static_cast<std::uint32_t>(i);
+            if(contains(index))
+            {
+                update(index, boxes[i]);
+            }
+            else
+            {
+                insert(index, boxes[i]);
+            }
+        }
+    }
+
+    void clear() noexcept {
+        m_entries.clear();
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    // Restores the order and replaces the contents of pairs with the overlapping bodies
+    void findPairs(std::vector<CollisionPair> & pairs) {
+        sort();
+        pairs.clear();
+        const std::size_t count = m_entries.size();
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const box_type & current = m_entries[i].box;
+            const T end = current.max[m_axis];
+            for(std::size_t j = i + 1; j < count && m_entries[j].box.min[m_axis] <= end; ++j)
+            {
+                if(current.overlaps(m_entries[j].box))
+                {
+                    pairs.push_back(detail::makeCollisionPair(m_entries[i].index, m_entries[j].index));
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    struct Entry {
+        box_type box;
+        std::uint32_t index;
+    };
+
+    void sort() {
+        std::erase_if(m_entries, [](const Entry & entry){ return entry.index == NONE; });
+
+        // Insertion sort, falling back to std::sort when the order changed too much,
+        // e.g. after many insertions: the part sorted so far still helps std::sort
+        const std::size_t max_moves = 8 * m_entries.size() + 64;
+        std::size_t moves = 0;
+        for(std::size_t i = 1; i < m_entries.size() && moves <= max_moves; ++i)
+        {
+            const Entry entry = m_entries[i];
+            const T key = entry.box.min[m_axis];
+            std::size_t j = i;
+            for(; j > 0 && key < m_entries[j - 1].box.min[m_axis]; --j)
+            {
+                m_entries[j] = m_entries[j - 1];
+            }
+            m_entries[j] = entry;
+            moves += i - j;
+        }
+        if(moves > max_moves)
+        {
+            std::sort(m_entries.begin(), m_entries.end(), [axis = m_axis](const Entry & a, const Entry & b){
+                return a.box.min[axis] < b.box.min[axis];
+            });
+        }
+
+        for(std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            m_slots[m_entries[i].index] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    std::size_t m_axis;
+    // Sorted by box.min[m_axis] after sort(), erased bodies have index NONE
+    std::vector<Entry> m_entries;
+    // Position of every body in m_entries, NONE for the ones not inserted
+    std::vector<std::uint32_t> m_slots;
+    std::size_t m_size = 0;
+};
+
+#endif // SWEEP_AND_PRUNE_HPP
@@ -0,0 +1,274 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace juan
+{
+    enum class Reduction
+    {
+        // Chunk results are combined in chunk order: the result only depends on the grain size
+        Deterministic,
+        // Chunk results are combined as they finish, no extra storage per chunk
+        Unordered
+    };
+
+    // Work stealing thread pool.
+    // Every worker owns a task queue: it pops its newest task and, when empty, steals
+    // the oldest task of another worker. A thread waiting for a parallel loop runs
+    // tasks too, so parallel loops can be nested, and sleeps once there are none left.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(std::size_t thread_count = std::max(1U, std::thread::hardware_concurrency()))
+        {
+            m_queues.reserve(thread_count);
+            for(std::size_t i = 0; i < thread_count; ++i)
+            {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            m_threads.reserve(thread_count);
+            for(std::size_t i = 0; i < thread_count; ++i)
+            {
+                m_threads.emplace_back([this, i](std::stop_token stop){ workerLoop(stop, i); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            for(auto & thread : m_threads)
+            {
+                thread.request_stop();
+            }
+            m_wake.notify_all();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool(ThreadPool &&) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+        ThreadPool & operator=(ThreadPool &&) = delete;
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_threads.size();
+        }
+
+        // Index of the calling thread: [0, size()) for the workers of this pool, size() for any other thread
+        [[nodiscard]] std::size_t threadIndex() const noexcept
+        {
+            return ownQueue().value_or(size());
+        }
+
+        // Calls function(begin, end) over [0, count) split in chunks of grain elements and
+        // waits for all of them. The first exception thrown by a chunk is rethrown here.
+        template <typename FUNCTION>
+        void parallelFor(std::size_t count, std::size_t grain, FUNCTION && function)
+        {
+            grain = std::max<std::size_t>(grain, 1);
+            const std::size_t chunks = (count + grain - 1) / grain;
+            if(chunks <= 1)
+            {
+                if(count > 0)
+                {
+                    function(std::size_t{0}, count);
+                }
+                return;
+            }
+
+            std::atomic<std::size_t> remaining{chunks};
+            std::exception_ptr error;
+            std::mutex error_mutex;
+            for(std::size_t chunk = 0; chunk < chunks; ++chunk)
+            {
+                const std::size_t begin = chunk * grain;
+                const std::size_t end = std::min(begin + grain, count);
+                push([&, begin, end]{
+                    try
+                    {
+                        function(begin, end);
+                    }
+                    catch(...)
+                    {
+                        std::scoped_lock lock(error_mutex);
+                        if(!error)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                    if(remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        // Under the lock, so the waiting thread cannot miss it between its check and its wait
+                        std::scoped_lock lock(m_wake_mutex);
+                        m_wake.notify_all();
+                    }
+                });
+            }
+
+            // Runs tasks while there are any, then sleeps until the chunks running on
+            // other threads finish or push new tasks (nested loops)
+            while(remaining.load(std::memory_order_acquire) != 0)
+            {
+                if(runOneTask())
+                {
+                    continue;
+                }
+                std::unique_lock lock(m_wake_mutex);
+                m_wake.wait(lock, [&]{
+                    return remaining.load(std::memory_order_acquire) == 0 || m_pending.load(std::memory_order_acquire) != 0;
+                });
+            }
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Reduces map(begin, end) over chunks of [0, count) with reduce(accumulated, chunk_result)
+        template <typename T, typename MAP, typename REDUCE>
+        [[nodiscard]] T parallelReduce(std::size_t count, std::size_t grain, T identity, MAP && map, REDUCE && reduce, Reduction mode = Reduction::Deterministic)
+        {
+            grain = std::max<std::size_t>(grain, 1);
+            if(mode == Reduction::Deterministic)
+            {
+                std::vector<std::optional<T>> partials((count + grain - 1) / grain);
+                parallelFor(count, grain, [&](std::size_t begin, std::size_t end){
+                    partials[begin / grain].emplace(map(begin, end));
+                });
+                for(auto & partial : partials)
+                {
+                    identity = reduce(std::move(identity), std::move(*partial));
+                }
+                return identity;
+            }
+
+            std::mutex mutex;
+            parallelFor(count, grain, [&](std::size_t begin, std::size_t end){
+                T partial = map(begin, end);
+                std::scoped_lock lock(mutex);
+                identity = reduce(std::move(identity), std::move(partial));
+            });
+            return identity;
+        }
+
+    private:
+        using Task = std::function<void()>;
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        // Index of the queue owned by the current thread, if it is a worker of this pool
+        [[nodiscard]] std::optional<std::size_t> ownQueue() const noexcept
+        {
+            if(t_pool == this)
+            {
+                return t_worker;
+            }
+            return std::nullopt;
+        }
+
+        void push(Task task)
+        {
+            const std::size_t index = ownQueue().value_or(m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+            {
+                std::scoped_lock lock(m_queues[index]->mutex);
+                m_queues[index]->tasks.push_back(std::move(task));
+            }
+            {
+                std::scoped_lock lock(m_wake_mutex);
+                m_pending.fetch_add(1, std::memory_order_release);
+            }
+            m_wake.notify_one();
+        }
+
+        [[nodiscard]] std::optional<Task> popOwn(std::size_t index)
+        {
+            auto & queue = *m_queues[index];
+            std::scoped_lock lock(queue.mutex);
+            if(queue.tasks.empty())
+            {
+                return std::nullopt;
+            }
+            Task task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return task;
+        }
+
+        [[nodiscard]] std::optional<Task> steal(std::size_t index)
+        {
+            auto & queue = *m_queues[index];
+            std::scoped_lock lock(queue.mutex);
+            if(queue.tasks.empty())
+            {
+                return std::nullopt;
+            }
+            Task task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return task;
+        }
+
+        bool runOneTask()
+        {
+            const auto own = ownQueue();
+            std::optional<Task> task;
+            if(own)
+            {
+                task = popOwn(*own);
+            }
+            const std::size_t start = own.value_or(0);
+            for(std::size_t i = 0; !task && i < m_queues.size(); ++i)
+            {
+                task = steal((start + i) % m_queues.size());
+            }
+            if(!task)
+            {
+                return false;
+            }
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            (*task)();
+            return true;
+        }
+
+        void workerLoop(std::stop_token stop, std::size_t index)
+        {
+            t_pool = this;
+            t_worker = index;
+            while(!stop.stop_requested())
+            {
+                if(runOneTask())
+                {
+                    continue;
+                }
+                std::unique_lock lock(m_wake_mutex);
+                m_wake.wait(lock, stop, [this]{ return m_pending.load(std::memory_order_acquire) != 0; });
+            }
+        }
+
+        inline static thread_local const ThreadPool * t_pool = nullptr;
+        inline static thread_local std::size_t t_worker = 0;
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::atomic<std::size_t> m_next_queue{0};
+        std::atomic<std::size_t> m_pending{0};
+        std::mutex m_wake_mutex;
+        std::condition_variable_any m_wake;
+        // Last member: the workers are joined before anything else is destroyed
+        std::vector<std::jthread> m_threads;
+    };
+}
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,325 @@
+#ifndef UNIFORM_GRID_HPP
+#define UNIFORM_GRID_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "SpatialQueries.hpp"
+#include "Vector.hpp"
+
+// Uniform hash grid over points that move: space is split in cubic cells of
+// cell_size, and only the non empty cells are stored, in a hash map. Moving a point
+// within its cell only updates its position, and moving it to another cell is O(1).
+// Points are identified by indices chosen by the caller, typically their index in an
+// array of positions, and results are those indices. Results match bruteForceNearest
+// and bruteForceRadius over the inserted points.
+// Queries are fastest when radius is a few cells at most: choose cell_size close to
+// the usual query radius, or to the distance of the k-th nearest neighbor.
+template <typename T, std::size_t SIZE> requires (std::floating_point<T> && SIZE > 0)
+class UniformGrid : public SpatialBatchQueries<UniformGrid<T, SIZE>, T, SIZE> {
+public:
+    using value_type = T;
+    using vector_type = Vector<T, SIZE>;
+
+    explicit UniformGrid(T cell_size) noexcept :
+        m_inverse_cell_size{T{1} / cell_size} {
+        assert(cell_size > T{0});
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool contains(std::uint32_t index) const noexcept {
+        return index < m_points.size() && m_points[index].slot != NONE;
+    }
+
+    [[nodiscard]] const vector_type & position(std::uint32_t index) const noexcept {
+        assert(contains(index));
+        const Point & point = m_points[index];
+        return (*point.bucket)[point.slot].position;
+    }
+
+    void insert(std::uint32_t index, const vector_type & position) {
+        assert(index != NONE && !contains(index));
+        if(index >= m_points.size())
+        {
+            m_points.resize(static_cast<std::size_t>(index) + 1);
+        }
+        addToCell(index, cellOf(position), position);
+        ++m_size;
+    }
+
+    void erase(std::uint32_t index) {
+        assert(contains(index));
+        removeFromCell(index);
+        m_points[index].slot = NONE;
+        --m_size;
+    }
+
+    // Incremental update, the point only changes cell when it crosses a cell boundary
+    void update(std::uint32_t index, const vector_type & position) {
+        assert(contains(index));
+        const Point & point = m_points[index];
+        const Cell cell = cellOf(position);
+        if(cell == point.cell)
+        {
+            (*point.bucket)[point.slot].position = position;
+            return;
+        }
+        removeFromCell(index);
+        addToCell(index, cell, position);
+    }
+
+    // Points 0 to positions.size() - 1 are inserted, or updated if they already are
+    void update(std::span<const vector_type> positions) {
+        assert(positions.size() < NONE);
+        for(std::size_t i = 0; i < positions.size(); ++i)
+        {
+            const auto index = static_cast<std::uint32_t>(i);
+            if(contains(index))
+            {
+                update(index, positions[i]);
+            }
+            else
+            {
+                insert(index, positions[i]);
+            }
+        }
+    }
+
+    void clear() noexcept {
+        m_cells.clear();
+        m_points.clear();
+        m_size = 0;
+    }
+
+    // Appends the points at distance <= radius of center, in no particular order
+    void radius(const vector_type & center, T radius, std::vector<std::uint32_t> & out) const {
+        const T radius_squared = radius * radius;
+        auto visit = [&](const Bucket & bucket){
+            for(const auto & entry : bucket)
+            {
+                if(distanceSquared(entry.position, center) <= radius_squared)
+                {
+                    out.push_back(entry.index);
+                }
+            }
+        };
+        Cell low;
+        Cell high;
+        T cells = T{1};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            low[c] = coordinate(center[c] - radius);
+            high[c] = coordinate(center[c] + radius);
+            cells *= static_cast<T>(high[c] - low[c] + 1);
+        }
+        // Large radius: visiting the stored cells is cheaper than looking up every cell
+        if(cells > static_cast<T>(m_cells.size()))
+        {
+            for(const auto & [cell, bucket] : m_cells)
+            {
+                visit(bucket);
+            }
+            return;
+        }
+        forEachCell(low, high, [&](const Cell & cell){
+            if(const auto found = m_cells.find(cell); found != m_cells.end())
+            {
+                visit(found->second);
+            }
+        });
+    }
+
+    // Appends the k nearest points to center, nearest first. Searches rings of cells
+    // around the cell of center, until the next ring cannot contain a nearer point.
+    void nearest(const vector_type & center, std::size_t k, std::vector<std::uint32_t> & out) const {
+        if(k == 0 || empty())
+        {
+            return;
+        }
+        detail::NearestNeighbors<T> neighbors(std::min(k, size()));
+        auto visit = [&](const Bucket & bucket){
+            for(const auto & entry : bucket)
+            {
+                const T distance = distanceSquared(entry.position, center);
+                if(distance <= neighbors.bound())
+                {
+                    neighbors.add(distance, entry.index);
+                }
+            }
+        };
+        const Cell origin = cellOf(center);
+        // Distance from center to the nearest face of its cell
+        T margin = std::numeric_limits<T>::max();
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            const T offset = center[c] * m_inverse_cell_size - static_cast<T>(origin[c]);
+            margin = std::min({margin, offset, T{1} - offset});
+        }
+        for(std::int64_t ring = 0;; ++ring)
+        {
+            // Once a ring has more cells than the map, scan every stored cell not visited yet
+            const T ring_cells = std::pow(static_cast<T>(2 * ring + 1), static_cast<T>(SIZE));
+            if(ring_cells > static_cast<T>(m_cells.size()))
+            {
+                for(const auto & [cell, bucket] : m_cells)
+                {
+                    if(chebyshevDistance(cell, origin) >= ring)
+                    {
+                        visit(bucket);
+                    }
+                }
+                break;
+            }
+            Cell low;
+            Cell high;
+            for(std::size_t c = 0; c < SIZE; ++c)
+            {
+                low[c] = static_cast<std::int32_t>(origin[c] - ring);
+                high[c] = static_cast<std::int32_t>(origin[c] + ring);
+            }
+            forEachCell(low, high, [&](const Cell & cell){
+                if(chebyshevDistance(cell, origin) == ring)
+                {
+                    if(const auto found = m_cells.find(cell); found != m_cells.end())
+                    {
+                        visit(found->second);
+                    }
+                }
+            });
+            // Points outside the rings visited so far are at least this far, and one exactly
+            // this far may still win the tie on its lower index
+            const T reach = (static_cast<T>(ring) + margin) / m_inverse_cell_size;
+            if(neighbors.full() && neighbors.bound() < reach * reach)
+            {
+                break;
+            }
+        }
+        neighbors.appendSorted(out);
+    }
+
+    // Batched queries, one result per center
+    using SpatialBatchQueries<UniformGrid, T, SIZE>::radius;
+    using SpatialBatchQueries<UniformGrid, T, SIZE>::nearest;
+
+private:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    using Cell = std::array<std::int32_t, SIZE>;
+
+    struct CellHash {
+        [[nodiscard]] std::size_t operator()(const Cell & cell) const noexcept {
+            std::size_t hash = 0;
+            for(const std::int32_t coordinate : cell)
+            {
+                hash = (hash ^ static_cast<std::uint32_t>(coordinate)) * 0x9e3779b97f4a7c15ull;
+            }
+            return hash ^ (hash >> 32);
+        }
+    };
+
+    // Positions are kept next to the indices, so queries scan cells without indirection
+    struct Entry {
+        vector_type position;
+        std::uint32_t index;
+    };
+
+    using Bucket = std::vector<Entry>;
+    using Cells = std::unordered_map<Cell, Bucket, CellHash>;
+
+    // Buckets are map nodes, they keep their address until their cell is erased
+    struct Point {
+        Cell cell{};
+        Bucket * bucket = nullptr;
+        // Position in the bucket, NONE when not inserted
+        std::uint32_t slot = NONE;
+    };
+
+    [[nodiscard]] std::int32_t coordinate(T value) const noexcept {
+        return static_cast<std::int32_t>(std::floor(value * m_inverse_cell_size));
+    }
+
+    [[nodiscard]] Cell cellOf(const vector_type & position) const noexcept {
+        Cell cell;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            cell[c] = coordinate(position[c]);
+        }
+        return cell;
+    }
+
+    [[nodiscard]] static std::int64_t chebyshevDistance(const Cell & a, const Cell & b) noexcept {
+        std::int64_t result = 0;
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result = std::max(result, std::abs(std::int64_t{a[c]} - std::int64_t{b[c]}));
+        }
+        return result;
+    }
+
+    // Calls function(cell) for every cell of the box [low, high]
+    template <typename FUNCTION>
+    static void forEachCell(const Cell & low, const Cell & high, FUNCTION && function) {
+        Cell cell = low;
+        while(true)
+        {
+            function(cell);
+            std::size_t c = 0;
+            while(c < SIZE && cell[c] == high[c])
+            {
+                cell[c] = low[c];
+                ++c;
+            }
+            if(c == SIZE)
+            {
+                return;
+            }
+            ++cell[c];
+        }
+    }
+
+    void addToCell(std::uint32_t index, const Cell & cell, const vector_type & position) {
+        Point & point = m_points[index];
+        point.cell = cell;
+        point.bucket = &m_cells[cell];
+        point.slot = static_cast<std::uint32_t>(point.bucket->size());
+        point.bucket->push_back({position, index});
+    }
+
+    // Swap and pop, the last point of the bucket takes the slot
+    void removeFromCell(std::uint32_t index) {
+        const Point & point = m_points[index];
+        Bucket & bucket = *point.bucket;
+        const std::uint32_t slot = point.slot;
+        bucket[slot] = bucket.back();
+        m_points[bucket[slot].index].slot = slot;
+        bucket.pop_back();
+        if(bucket.empty())
+        {
+            m_cells.erase(point.cell);
+        }
+    }
+
+    T m_inverse_cell_size;
+    Cells m_cells;
+    std::vector<Point> m_points;
+    std::size_t m_size = 0;
+};
+
+#endif // UNIFORM_GRID_HPP
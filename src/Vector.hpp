@@ -6,6 +6,25 @@
 #include <cassert>
 #include <algorithm>
 #include <numeric>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include "FastMath.hpp"
+#include "VectorExpression.hpp"
+#include "VectorKernels.hpp"
+#include "VectorSimd.hpp"
+
+// Converts count components with static_cast, the converting constructor of Vector
+// uses it. Found through argument dependent lookup, so overloads for other component
+// types can be declared after this header.
+template <typename T, typename U>
+constexpr void convertComponents(const U * in, T * out, std::size_t count) noexcept {
+    std::transform(in, in + count, out, [](const auto & element){
+        return static_cast<T>(element);
+    });
+}
 
 template<typename T, std::size_t SIZE> requires (SIZE > 0)
 class Vector {
@@ -14,6 +33,7 @@ public:
     using reference = value_type &;
     using iterator = value_type *;
     using const_iterator = const value_type *;
+    using simd = VectorSimd<T, SIZE>;
 
     constexpr explicit Vector() noexcept = default;
 
@@ -21,15 +41,20 @@ public:
         m_data.fill(val);
     }
 
-    template <typename... U>
+    template <typename... U> requires (sizeof...(U) <= SIZE)
     constexpr Vector(U... ts) : m_data{ts...} {
     }
 
+    // Component types with their own conversion kernels, such as Half, overload convertComponents
     template <typename U>
     constexpr Vector(const Vector<U, SIZE> & other) noexcept {
-        std::transform(other.begin(), other.end(), m_data.begin(), [](const auto & element){
-            return static_cast<T>(element);
-        });
+        convertComponents(other.begin(), begin(), SIZE);
+    }
+
+    // Evaluates an arithmetic expression, see VectorExpression.hpp
+    template <VectorExpressionNode E> requires (VectorOperandOf<E, T, SIZE> && !detail::ExpressionTraits<E>::batch)
+    constexpr Vector(const E & expression) noexcept {
+        assign(expression);
     }
 
     constexpr Vector(const Vector<value_type, SIZE> &) noexcept = default;
@@ -38,6 +63,13 @@ public:
 
     constexpr Vector & operator=(Vector<value_type, SIZE> && other) noexcept = default;
 
+    // Components are computed in place, the expression may refer to this vector
+    template <VectorExpressionNode E> requires (VectorOperandOf<E, T, SIZE> && !detail::ExpressionTraits<E>::batch)
+    constexpr Vector & operator=(const E & expression) noexcept {
+        assign(expression);
+        return *this;
+    }
+
     template <typename U, typename S>
     [[nodiscard]] constexpr static Vector<T, 2> fromAngleAndLength(const U & angle, const S & scalar) noexcept {
         return Vector<T, 2>{
@@ -48,7 +80,7 @@ public:
 
     template <typename U = value_type>
     [[nodiscard]] constexpr U lengthSquared() const noexcept {
-        return std::inner_product(begin(), end(), begin(), T{});
+        return *this * *this;
     }
 
     template <typename U = value_type>
@@ -57,7 +89,14 @@ public:
     }
 
     constexpr bool is_null() const noexcept {
-        return std::all_of(m_data.begin(), m_data.end(), [](const auto & val){ return val == T{}; });
+        if constexpr (simd::enabled)
+        {
+            if(!std::is_constant_evaluated())
+            {
+                return simd::isNull(m_data.data());
+            }
+        }
+        return detail::allComponents<SIZE>([this](std::size_t c){ return m_data[c] == T{}; });
     }
 
     constexpr void normalize() noexcept {
@@ -89,102 +128,243 @@ public:
         return m_data[i];
     }
 
-    [[nodiscard]] constexpr Vector<T, SIZE> operator+(const Vector<T, SIZE> & rhs) const noexcept {
-        Vector<T, SIZE> result;
-        std::transform(begin(), end(), rhs.begin(), result.begin(), std::plus<T>());
-        return result;
-    }
-
-    [[nodiscard]] constexpr Vector<T, SIZE> operator-(const Vector<T, SIZE> & rhs) const noexcept {
-        Vector<T, SIZE> result;
-        std::transform(begin(), end(), rhs.begin(), result.begin(), std::minus<T>());
-        return result;
-    }
-
-    [[nodiscard]] constexpr Vector<T, SIZE> operator-() const noexcept {
-        Vector<T, SIZE> result;
-        std::transform(begin(), end(), result.begin(), std::negate<T>());
-        return result;
+    [[nodiscard]] constexpr T operator*(const Vector<T, SIZE> & rhs) const noexcept {
+        if constexpr (simd::enabled)
+        {
+            if(!std::is_constant_evaluated())
+            {
+                return simd::dot(m_data.data(), rhs.m_data.data());
+            }
+        }
+        return detail::sumComponents<SIZE, T>([&](std::size_t c){ return m_data[c] * rhs.m_data[c]; });
     }
 
-    template <typename U> requires (std::integral<U> or std::floating_point<U>)
-    [[nodiscard]] constexpr Vector<T, SIZE> operator*(const U & scalar) const noexcept {
-        Vector<T, SIZE> result;
-        std::transform(begin(), end(), result.begin(), [scalar](const auto & element){
-            return element * scalar;
-        });
-        return result;
+    template <typename R> requires (VectorOperandOf<R, T, SIZE> && !detail::ExpressionTraits<R>::batch)
+    constexpr Vector & operator+=(const R & rhs) noexcept {
+        return *this = *this + rhs;
     }
 
-    [[nodiscard]] constexpr T operator*(const Vector<T, SIZE> & rhs) const noexcept {
-        return std::inner_product(begin(), end(), rhs.begin(), T{});
+    template <typename R> requires (VectorOperandOf<R, T, SIZE> && !detail::ExpressionTraits<R>::batch)
+    constexpr Vector & operator-=(const R & rhs) noexcept {
+        return *this = *this - rhs;
     }
 
-    template <typename U>
-    [[nodiscard]] constexpr Vector<T, SIZE> operator/(const U & scalar) const noexcept {
-        Vector<T, SIZE> result;
-        std::transform(begin(), end(), result.begin(), [scalar](const auto & element){
-            return element / scalar;
-        });
-        return result;
+    template <VectorScalar U>
+    constexpr Vector & operator*=(const U & scalar) noexcept {
+        return *this = *this * scalar;
     }
 
-    constexpr Vector<T, SIZE> operator+=(const Vector<T, SIZE> & rhs) noexcept {
-        std::transform(begin(), end(), rhs.begin(), begin(), std::plus<T>());
-        return *this;
+    template <VectorScalar U>
+    constexpr Vector & operator/=(const U & scalar) noexcept {
+        return *this = *this / scalar;
     }
 
-    constexpr Vector<T, SIZE> operator-=(const Vector<T, SIZE> & rhs) noexcept {
-        std::transform(begin(), end(), rhs.begin(), begin(), std::minus<T>());
-        return *this;
+    [[nodiscard]] constexpr bool operator==(const Vector<T, SIZE> & rhs) const noexcept {
+        return detail::allComponents<SIZE>([&](std::size_t c){ return m_data[c] == rhs.m_data[c]; });
     }
 
-    template <typename U>
-    constexpr Vector<T, SIZE> operator*=(const U & scalar) noexcept {
-        *this = *this * scalar;
-        return *this;
+    constexpr iterator begin() noexcept {
+        return m_data.data();
     }
 
-    template <typename U>
-    constexpr Vector<T, SIZE> operator/=(const U & scalar) noexcept {
-        *this = *this / scalar;
-        return *this;
+    constexpr const_iterator begin() const noexcept {
+        return m_data.data();
     }
 
-    [[nodiscard]] constexpr bool operator==(const Vector<T, SIZE> & rhs) const noexcept {
-        return m_data == rhs.m_data;
+    constexpr iterator end() noexcept {
+        return m_data.data() + SIZE;
     }
 
-    iterator begin() noexcept {
-        return m_data.begin();
+    constexpr const_iterator end() const noexcept {
+        return m_data.data() + SIZE;
     }
 
-    const_iterator begin() const noexcept {
-        return m_data.begin();
-    }
-
-    iterator end() noexcept {
-        return m_data.end();
+private:
+    template <typename E>
+    constexpr void assign(const E & expression) noexcept {
+        if constexpr (simd::enabled)
+        {
+            if(!std::is_constant_evaluated() && assignSimd(expression))
+            {
+                return;
+            }
+        }
+        detail::generateComponents<SIZE>(m_data.data(), [&](std::size_t c){ return expression.lane(c)(0); });
     }
 
-    const_iterator end() const noexcept {
-        return m_data.end();
+    // Single operations over whole vectors map to one SIMD kernel
+    template <typename E>
+    bool assignSimd(const E & expression) noexcept {
+        using operation = typename E::operation_type;
+        using operands = std::remove_cvref_t<decltype(expression.operands())>;
+        if constexpr (std::tuple_size_v<operands> == 2)
+        {
+            using lhs_type = std::tuple_element_t<0, operands>;
+            using rhs_type = std::tuple_element_t<1, operands>;
+            const auto & [lhs, rhs] = expression.operands();
+            if constexpr (detail::is_vector_leaf<lhs_type> && detail::is_vector_leaf<rhs_type>)
+            {
+                if constexpr (std::is_same_v<operation, std::plus<>>)
+                {
+                    simd::add(lhs.data(), rhs.data(), m_data.data());
+                    return true;
+                }
+                else if constexpr (std::is_same_v<operation, std::minus<>>)
+                {
+                    simd::sub(lhs.data(), rhs.data(), m_data.data());
+                    return true;
+                }
+            }
+            else if constexpr (detail::is_vector_leaf<lhs_type> && std::is_same_v<rhs_type, detail::ScalarLeaf<T>>)
+            {
+                if constexpr (std::is_same_v<operation, std::multiplies<>>)
+                {
+                    simd::mul(lhs.data(), rhs.value(), m_data.data());
+                    return true;
+                }
+                else if constexpr (std::is_same_v<operation, std::divides<>> && std::is_same_v<T, float>)
+                {
+                    simd::div(lhs.data(), rhs.value(), m_data.data());
+                    return true;
+                }
+            }
+        }
+        return false;
     }
 
-private:
-    std::array<T, SIZE> m_data;
+    // Padded to a full register when the SIMD backend is enabled for this type
+    alignas(simd::alignment) std::array<T, simd::storage_size> m_data;
 };
 
 template <typename T, std::size_t SIZE>
-constexpr Vector<T, SIZE> operator*(const T & scalar, const Vector<T, SIZE> & rhs) noexcept
+constexpr Vector<T, SIZE> operator/(const T & scalar, const Vector<T, SIZE> & rhs) noexcept
 {
-    return rhs * scalar;
+    return scalar / rhs;
 }
 
-template <typename T, std::size_t SIZE>
-constexpr Vector<T, SIZE> operator/(const T & scalar, const Vector<T, SIZE> & rhs) noexcept
+// Converts a contiguous range of vectors into another one of the same size, with the
+// same results as the converting constructor. Vectors without padding are converted
+// as one run of components, so the component kernels work on the whole range.
+template <std::ranges::contiguous_range IN, std::ranges::contiguous_range OUT>
+void convertVectors(const IN & in, OUT && out) noexcept {
+    using in_type = std::ranges::range_value_t<IN>;
+    using out_type = std::ranges::range_value_t<OUT>;
+    using in_value = typename in_type::value_type;
+    using out_value = typename out_type::value_type;
+    constexpr std::size_t SIZE = detail::ExpressionTraits<in_type>::size;
+    static_assert(std::is_same_v<in_type, Vector<in_value, SIZE>> && std::is_same_v<out_type, Vector<out_value, SIZE>>,
+        "convertVectors converts between ranges of Vector of the same size");
+    assert(std::ranges::size(in) == std::ranges::size(out));
+    const std::size_t count = std::ranges::size(in);
+    if(count == 0)
+    {
+        return;
+    }
+    const in_type * source = std::ranges::data(in);
+    out_type * destination = std::ranges::data(out);
+    if constexpr (sizeof(in_type) == SIZE * sizeof(in_value) && sizeof(out_type) == SIZE * sizeof(out_value))
+    {
+        convertComponents(source->begin(), destination->begin(), count * SIZE);
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            destination[i] = out_type(source[i]);
+        }
+    }
+}
+
+namespace detail
 {
-    return scalar / rhs;
+    // Blocks of vectors keep one value per vector in local arrays (see forEachBlock)
+    inline constexpr std::size_t VECTOR_BLOCK_SIZE = 256;
+}
+
+// Normalizes every non null vector of a contiguous range of Vector, like
+// Vector::normalize. With Precision::fast, float vectors are multiplied by
+// math::rsqrt of their squared length instead of divided by their length, which
+// vectorizes (see FastMath.hpp). Their squared length must then be a normal float.
+template <math::Precision P = math::Precision::exact, std::ranges::contiguous_range RANGE>
+void normalizeVectors(RANGE && vectors) noexcept {
+    using vector_type = std::ranges::range_value_t<RANGE>;
+    using value_type = typename vector_type::value_type;
+    vector_type * data = std::ranges::data(vectors);
+    const std::size_t count = std::ranges::size(vectors);
+    if constexpr (math::useFast<P, value_type>)
+    {
+        std::array<float, detail::VECTOR_BLOCK_SIZE> scale;
+        detail::forEachBlock<detail::VECTOR_BLOCK_SIZE>(count, [&](std::size_t begin, auto block_count){
+            vector_type * block = data + begin;
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                scale[i] = block[i].lengthSquared();
+            }
+            // rsqrt(0) is finite, so null vectors stay null
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                scale[i] = math::rsqrt<P>(scale[i]);
+            }
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                block[i] *= scale[i];
+            }
+        });
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            data[i].normalize();
+        }
+    }
+}
+
+// out[i] = lhs[i].angle<U>(rhs[i]) for contiguous ranges of Vector and of U. With
+// Precision::fast and float vectors and angles, the cosines are computed with
+// math::rsqrt and clamped to [-1, 1] by math::acos, so rounding errors never give NaN.
+// Angles with a null vector are NaN with both precisions.
+template <math::Precision P = math::Precision::exact, std::ranges::contiguous_range LHS, std::ranges::contiguous_range RHS, std::ranges::contiguous_range OUT>
+void vectorAngles(const LHS & lhs, const RHS & rhs, OUT && out) noexcept {
+    using vector_type = std::ranges::range_value_t<LHS>;
+    using value_type = typename vector_type::value_type;
+    using out_type = std::ranges::range_value_t<OUT>;
+    static_assert(std::is_same_v<vector_type, std::ranges::range_value_t<RHS>>, "vectorAngles takes two ranges of the same Vector");
+    assert(std::ranges::size(lhs) == std::ranges::size(out) && std::ranges::size(rhs) == std::ranges::size(out));
+    const vector_type * lhs_data = std::ranges::data(lhs);
+    const vector_type * rhs_data = std::ranges::data(rhs);
+    out_type * out_data = std::ranges::data(out);
+    const std::size_t count = std::ranges::size(out);
+    if constexpr (math::useFast<P, value_type> && std::is_same_v<out_type, float>)
+    {
+        std::array<float, detail::VECTOR_BLOCK_SIZE> lhs_scale;
+        std::array<float, detail::VECTOR_BLOCK_SIZE> rhs_scale;
+        std::array<float, detail::VECTOR_BLOCK_SIZE> cosine;
+        detail::forEachBlock<detail::VECTOR_BLOCK_SIZE>(count, [&](std::size_t begin, auto block_count){
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                lhs_scale[i] = lhs_data[begin + i].lengthSquared();
+                rhs_scale[i] = rhs_data[begin + i].lengthSquared();
+                cosine[i] = lhs_data[begin + i] * rhs_data[begin + i];
+            }
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                cosine[i] *= math::rsqrt<P>(lhs_scale[i]) * math::rsqrt<P>(rhs_scale[i]);
+            }
+            float * block_out = out_data + begin;
+            for(std::size_t i = 0; i < block_count; ++i)
+            {
+                block_out[i] = detail::angleOrNaN(math::acos<P>(cosine[i]), lhs_scale[i], rhs_scale[i]);
+            }
+        });
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            out_data[i] = lhs_data[i].template angle<out_type>(rhs_data[i]);
+        }
+    }
 }
 
 template <typename T>
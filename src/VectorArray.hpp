@@ -0,0 +1,372 @@
+#ifndef VECTOR_ARRAY_HPP
+#define VECTOR_ARRAY_HPP
+
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "Vector.hpp"
+
+// Structure of arrays container of Vector<T, SIZE>: component i of every vector
+// is stored contiguously in its own aligned lane, so the bulk operations below
+// are plain loops over lanes that the compiler can vectorize across vectors.
+// Results are identical to applying the Vector operator to each element.
+template<typename T, std::size_t SIZE> requires (SIZE > 0)
+class VectorArray {
+public:
+    using value_type = T;
+    using vector_type = Vector<T, SIZE>;
+    using lane_type = std::vector<T, AlignedAllocator<T>>;
+
+    VectorArray() noexcept = default;
+
+    explicit VectorArray(std::size_t count, const vector_type & value = vector_type{}) {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            m_lanes[c].assign(count, value[c]);
+        }
+    }
+
+    explicit VectorArray(std::span<const vector_type> vectors) {
+        load(vectors);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return m_lanes[0].size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_lanes[0].empty();
+    }
+
+    void reserve(std::size_t count) {
+        for(auto & lane : m_lanes)
+        {
+            lane.reserve(count);
+        }
+    }
+
+    void resize(std::size_t count, const vector_type & value = vector_type{}) {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            m_lanes[c].resize(count, value[c]);
+        }
+    }
+
+    void clear() noexcept {
+        for(auto & lane : m_lanes)
+        {
+            lane.clear();
+        }
+    }
+
+    void push_back(const vector_type & vector) {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            m_lanes[c].push_back(vector[c]);
+        }
+    }
+
+    [[nodiscard]] vector_type get(std::size_t i) const noexcept {
+        assert(i < size());
+        vector_type result{};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = m_lanes[c][i];
+        }
+        return result;
+    }
+
+    void set(std::size_t i, const vector_type & vector) noexcept {
+        assert(i < size());
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            m_lanes[c][i] = vector[c];
+        }
+    }
+
+    [[nodiscard]] std::span<value_type> lane(std::size_t component) noexcept {
+        assert(component < SIZE);
+        return m_lanes[component];
+    }
+
+    [[nodiscard]] std::span<const value_type> lane(std::size_t component) const noexcept {
+        assert(component < SIZE);
+        return m_lanes[component];
+    }
+
+    // Replaces the contents with the given array of structures.
+    void load(std::span<const vector_type> vectors) {
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            auto & lane = m_lanes[c];
+            lane.resize(vectors.size());
+            for(std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                lane[i] = vectors[i][c];
+            }
+        }
+    }
+
+    // Writes the contents back as an array of structures, out must have size() elements.
+    void store(std::span<vector_type> out) const noexcept {
+        assert(out.size() == size());
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            const auto & lane = m_lanes[c];
+            for(std::size_t i = 0; i < out.size(); ++i)
+            {
+                out[i][c] = lane[i];
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<vector_type> toVectors() const {
+        std::vector<vector_type> result(size());
+        store(result);
+        return result;
+    }
+
+    // Evaluates an arithmetic expression in one pass per lane, see VectorExpression.hpp
+    template <VectorExpressionNode E> requires (VectorOperandOf<E, T, SIZE> && detail::ExpressionTraits<E>::batch)
+    VectorArray(const E & expression) {
+        assign(expression);
+    }
+
+    // The expression may refer to this array
+    template <VectorExpressionNode E> requires (VectorOperandOf<E, T, SIZE> && detail::ExpressionTraits<E>::batch)
+    VectorArray & operator=(const E & expression) {
+        assign(expression);
+        return *this;
+    }
+
+    // rhs is a VectorArray of the same size, a Vector added to every element or an expression
+    template <typename R> requires VectorOperandOf<R, T, SIZE>
+    VectorArray & operator+=(const R & rhs) noexcept {
+        evaluate(*this + rhs);
+        return *this;
+    }
+
+    template <typename R> requires VectorOperandOf<R, T, SIZE>
+    VectorArray & operator-=(const R & rhs) noexcept {
+        evaluate(*this - rhs);
+        return *this;
+    }
+
+    template <VectorScalar U>
+    VectorArray & operator*=(const U & scalar) noexcept {
+        evaluate(*this * scalar);
+        return *this;
+    }
+
+    template <VectorScalar U>
+    VectorArray & operator/=(const U & scalar) noexcept {
+        evaluate(*this / scalar);
+        return *this;
+    }
+
+    // out[i] = get(i) * rhs.get(i), accumulated in the same order as Vector::operator*.
+    void dot(const VectorArray & rhs, std::span<value_type> out) const noexcept {
+        assert(rhs.size() == size());
+        assert(out.size() == size());
+        std::fill(out.begin(), out.end(), T{});
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            const T * lhs_lane = m_lanes[c].data();
+            const T * rhs_lane = rhs.m_lanes[c].data();
+            T * result = out.data();
+            for(std::size_t i = 0, n = out.size(); i < n; ++i)
+            {
+                result[i] = toValue(result[i] + lhs_lane[i] * rhs_lane[i]);
+            }
+        }
+    }
+
+    void lengthSquared(std::span<value_type> out) const noexcept {
+        dot(*this, out);
+    }
+
+    template <typename U = value_type>
+    void length(std::span<U> out) const noexcept {
+        assert(out.size() == size());
+        std::array<T, BLOCK_SIZE> squared;
+        for(std::size_t begin = 0; begin < size(); begin += BLOCK_SIZE)
+        {
+            const std::size_t count = std::min(BLOCK_SIZE, size() - begin);
+            lengthSquaredBlock(begin, count, squared.data());
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                out[begin + i] = static_cast<U>(std::sqrt(squared[i]));
+            }
+        }
+    }
+
+    // Normalizes every non null vector, null vectors are left untouched like Vector::normalize.
+    // Precision::fast multiplies float vectors by math::rsqrt of their squared length,
+    // which must then be a normal float (see FastMath.hpp).
+    template <math::Precision P = math::Precision::exact>
+    void normalize() noexcept {
+        std::array<T, BLOCK_SIZE> divisor;
+        detail::forEachBlock<BLOCK_SIZE>(size(), [&](std::size_t begin, auto count){
+            lengthSquaredBlock(begin, count, divisor.data());
+            if constexpr (math::useFast<P, T>)
+            {
+                // rsqrt(0) is finite, so null vectors stay null
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    divisor[i] = math::rsqrt<P>(divisor[i]);
+                }
+                for(auto & lane : m_lanes)
+                {
+                    T * data = lane.data() + begin;
+                    for(std::size_t i = 0; i < count; ++i)
+                    {
+                        data[i] *= divisor[i];
+                    }
+                }
+            }
+            else
+            {
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    divisor[i] = toValue(std::sqrt(divisor[i]));
+                }
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    if(isNull(begin + i))
+                    {
+                        divisor[i] = T{1};
+                    }
+                }
+                for(auto & lane : m_lanes)
+                {
+                    T * data = lane.data() + begin;
+                    for(std::size_t i = 0; i < count; ++i)
+                    {
+                        data[i] = toValue(data[i] / divisor[i]);
+                    }
+                }
+            }
+        });
+    }
+
+    // out[i] = get(i).angle<U>(rhs.get(i)). With Precision::fast and float vectors and
+    // angles, the cosines use math::rsqrt and are clamped to [-1, 1] by math::acos.
+    // Angles with a null vector are NaN with both precisions.
+    template <math::Precision P = math::Precision::exact, typename U>
+    void angle(const VectorArray & rhs, std::span<U> out) const noexcept {
+        assert(rhs.size() == size());
+        assert(out.size() == size());
+        if constexpr (math::useFast<P, T> && std::is_same_v<U, float>)
+        {
+            std::array<T, BLOCK_SIZE> lhs_scale;
+            std::array<T, BLOCK_SIZE> rhs_scale;
+            std::array<T, BLOCK_SIZE> cosine;
+            detail::forEachBlock<BLOCK_SIZE>(size(), [&](std::size_t begin, auto count){
+                lengthSquaredBlock(begin, count, lhs_scale.data());
+                rhs.lengthSquaredBlock(begin, count, rhs_scale.data());
+                dotBlock(rhs, begin, count, cosine.data());
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    cosine[i] *= math::rsqrt<P>(lhs_scale[i]) * math::rsqrt<P>(rhs_scale[i]);
+                }
+                U * block_out = out.data() + begin;
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    block_out[i] = detail::angleOrNaN(math::acos<P>(cosine[i]), lhs_scale[i], rhs_scale[i]);
+                }
+            });
+        }
+        else
+        {
+            for(std::size_t i = 0; i < size(); ++i)
+            {
+                out[i] = get(i).template angle<U>(rhs.get(i));
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 256;
+
+    template <typename E>
+    void assign(const E & expression) {
+        const std::size_t count = expression.count();
+        for(auto & lane : m_lanes)
+        {
+            lane.resize(count);
+        }
+        evaluate(expression);
+    }
+
+    template <typename E>
+    void evaluate(const E & expression) noexcept {
+        assert(expression.count() == size());
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            const auto lane = expression.lane(c);
+            T * data = m_lanes[c].data();
+            for(std::size_t i = 0, n = size(); i < n; ++i)
+            {
+                data[i] = lane(i);
+            }
+        }
+    }
+
+    // Same implicit conversion Vector performs when storing an operator result
+    template <typename U>
+    [[nodiscard]] static constexpr T toValue(const U & value) noexcept {
+        if constexpr (std::is_same_v<T, U>)
+        {
+            return value;
+        }
+        else
+        {
+            return static_cast<T>(value);
+        }
+    }
+
+    template <typename COUNT>
+    void lengthSquaredBlock(std::size_t begin, COUNT count, T * out) const noexcept {
+        dotBlock(*this, begin, count, out);
+    }
+
+    template <typename COUNT>
+    void dotBlock(const VectorArray & rhs, std::size_t begin, COUNT count, T * out) const noexcept {
+        std::fill(out, out + count, T{});
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            const T * lhs_lane = m_lanes[c].data() + begin;
+            const T * rhs_lane = rhs.m_lanes[c].data() + begin;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = toValue(out[i] + lhs_lane[i] * rhs_lane[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] bool isNull(std::size_t i) const noexcept {
+        return std::all_of(m_lanes.begin(), m_lanes.end(), [i](const auto & lane){ return lane[i] == T{}; });
+    }
+
+    std::array<lane_type, SIZE> m_lanes;
+};
+
+template <typename T>
+using VectorArray2 = VectorArray<T, 2>;
+
+template <typename T>
+using VectorArray3 = VectorArray<T, 3>;
+
+using VectorArray2i = VectorArray2<int>;
+using VectorArray2f = VectorArray2<float>;
+
+using VectorArray3i = VectorArray3<int>;
+using VectorArray3f = VectorArray3<float>;
+
+#endif // VECTOR_ARRAY_HPP
@@ -0,0 +1,414 @@
+#ifndef VECTOR_EXPRESSION_HPP
+#define VECTOR_EXPRESSION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename T, std::size_t SIZE> requires (SIZE > 0)
+class Vector;
+
+template<typename T, std::size_t SIZE> requires (SIZE > 0)
+class VectorArray;
+
+// Lazy element-wise arithmetic for Vector and VectorArray.
+// The arithmetic operators build expression nodes instead of results, and a whole
+// chain such as a + b * s - c is computed in a single loop over the components
+// when it is assigned to, or used to construct, a Vector or VectorArray. Every
+// node converts its result to the value type, so the values are the same as
+// applying the operators one at a time.
+// Nodes refer to their Vector and VectorArray operands when these are lvalues, and
+// hold temporary operands by value: an expression stored in an `auto` variable must
+// not outlive the named vectors it uses. Expressions over single vectors also have
+// the const member functions of Vector (length, normalized, angle...), which
+// evaluate them first.
+
+namespace detail
+{
+    template <typename T, typename U>
+    [[nodiscard]] constexpr T convertTo(const U & value) noexcept {
+        if constexpr (std::is_same_v<T, U>)
+        {
+            return value;
+        }
+        else
+        {
+            return static_cast<T>(value);
+        }
+    }
+
+    // A lane evaluator computes one component for the vector at a given index.
+    // They only hold pointers and values, so loops over them vectorize.
+
+    template <typename T>
+    struct ConstantLane {
+        T value;
+
+        [[nodiscard]] constexpr T operator()(std::size_t) const noexcept {
+            return value;
+        }
+    };
+
+    template <typename T>
+    struct ArrayLane {
+        const T * data;
+
+        [[nodiscard]] constexpr T operator()(std::size_t index) const noexcept {
+            return data[index];
+        }
+    };
+
+    template <typename T, typename OPERATION, typename... LANES>
+    struct OperationLane {
+        OPERATION operation;
+        std::tuple<LANES...> operands;
+
+        [[nodiscard]] constexpr T operator()(std::size_t index) const noexcept {
+            return std::apply([this, index](const auto &... lanes){
+                return convertTo<T>(operation(lanes(index)...));
+            }, operands);
+        }
+    };
+
+    // Refers to a Vector operand, or holds a temporary one (OWNING)
+    template <typename T, std::size_t SIZE, bool OWNING = false>
+    class VectorLeaf {
+    public:
+        constexpr explicit VectorLeaf(const Vector<T, SIZE> & vector) noexcept requires (!OWNING) : m_vector{&vector} {
+        }
+
+        constexpr explicit VectorLeaf(Vector<T, SIZE> && vector) noexcept requires OWNING : m_vector{std::move(vector)} {
+        }
+
+        [[nodiscard]] constexpr ConstantLane<T> lane(std::size_t component) const noexcept {
+            return {data()[component]};
+        }
+
+        // Vectors are broadcast over the vectors of a batch
+        [[nodiscard]] constexpr std::size_t count() const noexcept {
+            return 0;
+        }
+
+        [[nodiscard]] constexpr const T * data() const noexcept {
+            if constexpr (OWNING)
+            {
+                return m_vector.begin();
+            }
+            else
+            {
+                return m_vector->begin();
+            }
+        }
+
+    private:
+        std::conditional_t<OWNING, Vector<T, SIZE>, const Vector<T, SIZE> *> m_vector;
+    };
+
+    template <typename LEAF>
+    inline constexpr bool is_vector_leaf = false;
+
+    template <typename T, std::size_t SIZE, bool OWNING>
+    inline constexpr bool is_vector_leaf<VectorLeaf<T, SIZE, OWNING>> = true;
+
+    // Refers to a VectorArray operand, or holds a temporary one (OWNING)
+    template <typename T, std::size_t SIZE, bool OWNING = false>
+    class VectorArrayLeaf {
+    public:
+        explicit VectorArrayLeaf(const VectorArray<T, SIZE> & array) noexcept requires (!OWNING) : m_array{&array} {
+        }
+
+        explicit VectorArrayLeaf(VectorArray<T, SIZE> && array) noexcept requires OWNING : m_array{std::move(array)} {
+        }
+
+        [[nodiscard]] ArrayLane<T> lane(std::size_t component) const noexcept {
+            return {array().lane(component).data()};
+        }
+
+        [[nodiscard]] std::size_t count() const noexcept {
+            return array().size();
+        }
+
+    private:
+        [[nodiscard]] const VectorArray<T, SIZE> & array() const noexcept {
+            if constexpr (OWNING)
+            {
+                return m_array;
+            }
+            else
+            {
+                return *m_array;
+            }
+        }
+
+        std::conditional_t<OWNING, VectorArray<T, SIZE>, const VectorArray<T, SIZE> *> m_array;
+    };
+
+    template <typename U>
+    class ScalarLeaf {
+    public:
+        constexpr explicit ScalarLeaf(const U & value) noexcept : m_value{value} {
+        }
+
+        [[nodiscard]] constexpr ConstantLane<U> lane(std::size_t) const noexcept {
+            return {m_value};
+        }
+
+        [[nodiscard]] constexpr std::size_t count() const noexcept {
+            return 0;
+        }
+
+        [[nodiscard]] constexpr const U & value() const noexcept {
+            return m_value;
+        }
+
+    private:
+        U m_value;
+    };
+}
+
+template <typename T, std::size_t SIZE, bool BATCH, typename OPERATION, typename... OPERANDS>
+class VectorExpression {
+public:
+    using value_type = T;
+    using operation_type = OPERATION;
+    using result_type = std::conditional_t<BATCH, VectorArray<T, SIZE>, Vector<T, SIZE>>;
+
+    constexpr explicit VectorExpression(OPERATION operation, OPERANDS... operands) noexcept((std::is_nothrow_move_constructible_v<OPERANDS> && ...)) :
+        m_operation{operation},
+        m_operands{std::move(operands)...} {
+    }
+
+    [[nodiscard]] constexpr auto lane(std::size_t component) const noexcept {
+        return std::apply([this, component](const auto &... operands){
+            return detail::OperationLane<T, OPERATION, decltype(operands.lane(component))...>{m_operation, {operands.lane(component)...}};
+        }, m_operands);
+    }
+
+    // Number of vectors of a batch expression, 0 when every operand is broadcast
+    [[nodiscard]] constexpr std::size_t count() const noexcept {
+        return std::apply([](const auto &... operands){
+            std::size_t result = 0;
+            ((result = std::max(result, operands.count())), ...);
+            assert(((operands.count() == 0 || operands.count() == result) && ...));
+            return result;
+        }, m_operands);
+    }
+
+    [[nodiscard]] constexpr const std::tuple<OPERANDS...> & operands() const noexcept {
+        return m_operands;
+    }
+
+    [[nodiscard]] constexpr result_type eval() const {
+        return result_type(*this);
+    }
+
+    [[nodiscard]] constexpr T operator[](std::size_t component) const noexcept requires (!BATCH) {
+        assert(component < SIZE);
+        return lane(component)(0);
+    }
+
+    template <typename U = T>
+    [[nodiscard]] constexpr U lengthSquared() const noexcept requires (!BATCH) {
+        return eval().template lengthSquared<U>();
+    }
+
+    template <typename U = T>
+    [[nodiscard]] constexpr U length() const noexcept requires (!BATCH) {
+        return eval().template length<U>();
+    }
+
+    [[nodiscard]] constexpr bool is_null() const noexcept requires (!BATCH) {
+        return eval().is_null();
+    }
+
+    [[nodiscard]] constexpr Vector<T, SIZE> normalized() const noexcept requires (!BATCH) {
+        return eval().normalized();
+    }
+
+    template <typename PRECISION = float>
+    [[nodiscard]] constexpr PRECISION angle(const Vector<T, SIZE> & other) const noexcept requires (!BATCH) {
+        return eval().template angle<PRECISION>(other);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept requires BATCH {
+        return count();
+    }
+
+    [[nodiscard]] Vector<T, SIZE> get(std::size_t index) const noexcept requires BATCH {
+        assert(index < count());
+        Vector<T, SIZE> result{};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = lane(c)(index);
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::vector<Vector<T, SIZE>> toVectors() const requires BATCH {
+        return eval().toVectors();
+    }
+
+private:
+    OPERATION m_operation;
+    std::tuple<OPERANDS...> m_operands;
+};
+
+namespace detail
+{
+    template <typename E>
+    struct ExpressionTraits {
+        static constexpr bool is_operand = false;
+        static constexpr bool is_expression = false;
+        static constexpr bool batch = false;
+        using leaf_type = E;
+        using owning_leaf_type = E;
+    };
+
+    template <typename T, std::size_t SIZE>
+    struct ExpressionTraits<Vector<T, SIZE>> {
+        static constexpr bool is_operand = true;
+        static constexpr bool is_expression = false;
+        static constexpr bool batch = false;
+        using leaf_type = VectorLeaf<T, SIZE>;
+        using owning_leaf_type = VectorLeaf<T, SIZE, true>;
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+    };
+
+    template <typename T, std::size_t SIZE>
+    struct ExpressionTraits<VectorArray<T, SIZE>> {
+        static constexpr bool is_operand = true;
+        static constexpr bool is_expression = false;
+        static constexpr bool batch = true;
+        using leaf_type = VectorArrayLeaf<T, SIZE>;
+        using owning_leaf_type = VectorArrayLeaf<T, SIZE, true>;
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+    };
+
+    template <typename T, std::size_t SIZE, bool BATCH, typename OPERATION, typename... OPERANDS>
+    struct ExpressionTraits<VectorExpression<T, SIZE, BATCH, OPERATION, OPERANDS...>> {
+        static constexpr bool is_operand = true;
+        static constexpr bool is_expression = true;
+        static constexpr bool batch = BATCH;
+        using leaf_type = VectorExpression<T, SIZE, BATCH, OPERATION, OPERANDS...>;
+        using owning_leaf_type = leaf_type;
+        using value_type = T;
+        static constexpr std::size_t size = SIZE;
+    };
+
+    // Expressions and scalar leaves are stored by value, vectors by reference unless
+    // they are temporaries, which are moved into the expression
+    template <typename E>
+    using LeafOf = std::conditional_t<std::is_lvalue_reference_v<E>,
+        typename ExpressionTraits<std::remove_cvref_t<E>>::leaf_type,
+        typename ExpressionTraits<std::remove_cvref_t<E>>::owning_leaf_type>;
+
+    // Copying an expression that holds a VectorArray may throw
+    template <typename... OPERANDS>
+    inline constexpr bool nothrow_leaves = (std::is_nothrow_constructible_v<LeafOf<OPERANDS>, OPERANDS> && ...);
+
+    template <typename E>
+    [[nodiscard]] constexpr LeafOf<E> toLeaf(E && operand) noexcept(nothrow_leaves<E>) {
+        return LeafOf<E>(std::forward<E>(operand));
+    }
+}
+
+// Vector, VectorArray or an expression over them
+template <typename E>
+concept VectorOperand = detail::ExpressionTraits<E>::is_operand;
+
+template <typename E>
+concept VectorExpressionNode = detail::ExpressionTraits<E>::is_expression;
+
+template <typename E, typename T, std::size_t SIZE>
+concept VectorOperandOf = VectorOperand<E>
+    && std::is_same_v<typename detail::ExpressionTraits<E>::value_type, T>
+    && detail::ExpressionTraits<E>::size == SIZE;
+
+template <typename L, typename R>
+concept CompatibleVectorOperands = VectorOperand<L> && VectorOperand<R>
+    && VectorOperandOf<R, typename detail::ExpressionTraits<L>::value_type, detail::ExpressionTraits<L>::size>;
+
+template <typename U>
+concept VectorScalar = std::integral<U> or std::floating_point<U>;
+
+namespace detail
+{
+    template <typename OPERATION, typename L, typename... OPERANDS>
+    [[nodiscard]] constexpr auto makeExpression(OPERATION operation, OPERANDS &&... operands)
+        noexcept(nothrow_leaves<OPERANDS...>) {
+        using traits = ExpressionTraits<L>;
+        constexpr bool batch = (ExpressionTraits<std::remove_cvref_t<OPERANDS>>::batch || ...);
+        return VectorExpression<typename traits::value_type, traits::size, batch, OPERATION, LeafOf<OPERANDS>...>(
+            operation, toLeaf(std::forward<OPERANDS>(operands))...);
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr ScalarLeaf<U> scalar(const U & value) noexcept {
+        return ScalarLeaf<U>(value);
+    }
+}
+
+template <typename L, typename R> requires CompatibleVectorOperands<std::remove_cvref_t<L>, std::remove_cvref_t<R>>
+[[nodiscard]] constexpr auto operator+(L && lhs, R && rhs) noexcept(detail::nothrow_leaves<L, R>) {
+    return detail::makeExpression<std::plus<>, std::remove_cvref_t<L>>(std::plus<>(), std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename L, typename R> requires CompatibleVectorOperands<std::remove_cvref_t<L>, std::remove_cvref_t<R>>
+[[nodiscard]] constexpr auto operator-(L && lhs, R && rhs) noexcept(detail::nothrow_leaves<L, R>) {
+    return detail::makeExpression<std::minus<>, std::remove_cvref_t<L>>(std::minus<>(), std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <typename E> requires VectorOperand<std::remove_cvref_t<E>>
+[[nodiscard]] constexpr auto operator-(E && operand) noexcept(detail::nothrow_leaves<E>) {
+    return detail::makeExpression<std::negate<>, std::remove_cvref_t<E>>(std::negate<>(), std::forward<E>(operand));
+}
+
+template <typename E, VectorScalar U> requires VectorOperand<std::remove_cvref_t<E>>
+[[nodiscard]] constexpr auto operator*(E && lhs, const U & scalar) noexcept(detail::nothrow_leaves<E>) {
+    return detail::makeExpression<std::multiplies<>, std::remove_cvref_t<E>>(std::multiplies<>(), std::forward<E>(lhs), detail::scalar(scalar));
+}
+
+template <typename E> requires VectorOperand<std::remove_cvref_t<E>>
+[[nodiscard]] constexpr auto operator*(const typename detail::ExpressionTraits<std::remove_cvref_t<E>>::value_type & scalar, E && rhs) noexcept(detail::nothrow_leaves<E>) {
+    return std::forward<E>(rhs) * scalar;
+}
+
+template <typename E, VectorScalar U> requires VectorOperand<std::remove_cvref_t<E>>
+[[nodiscard]] constexpr auto operator/(E && lhs, const U & scalar) noexcept(detail::nothrow_leaves<E>) {
+    return detail::makeExpression<std::divides<>, std::remove_cvref_t<E>>(std::divides<>(), std::forward<E>(lhs), detail::scalar(scalar));
+}
+
+// Dot product when any side is an expression, Vector * Vector is a member of Vector
+template <typename L, typename R> requires CompatibleVectorOperands<L, R>
+    && (VectorExpressionNode<L> || VectorExpressionNode<R>)
+    && (!detail::ExpressionTraits<L>::batch && !detail::ExpressionTraits<R>::batch)
+[[nodiscard]] constexpr auto operator*(const L & lhs, const R & rhs) noexcept {
+    using vector_type = Vector<typename detail::ExpressionTraits<L>::value_type, detail::ExpressionTraits<L>::size>;
+    return vector_type(lhs) * vector_type(rhs);
+}
+
+template <typename L, typename R> requires CompatibleVectorOperands<L, R>
+    && (VectorExpressionNode<L> || VectorExpressionNode<R>)
+    && (!detail::ExpressionTraits<L>::batch && !detail::ExpressionTraits<R>::batch)
+[[nodiscard]] constexpr bool operator==(const L & lhs, const R & rhs) noexcept {
+    const auto lhs_leaf = detail::toLeaf(lhs);
+    const auto rhs_leaf = detail::toLeaf(rhs);
+    for(std::size_t c = 0; c < detail::ExpressionTraits<L>::size; ++c)
+    {
+        if(lhs_leaf.lane(c)(0) != rhs_leaf.lane(c)(0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // VECTOR_EXPRESSION_HPP
@@ -0,0 +1,370 @@
+#ifndef VECTOR_FILE_HPP
+#define VECTOR_FILE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "MemoryMap.hpp"
+#include "Vector.hpp"
+#include "VectorArray.hpp"
+
+class Half;
+
+// Binary files of Vector<T, SIZE>. A 64 byte VectorFileHeader is followed by either
+//   - VectorFileLayout::vectors: count vectors of SIZE packed components, or
+//   - VectorFileLayout::lanes: SIZE lanes of count components, each one starting at a
+//     multiple of 64 bytes like the lanes of VectorArray.
+// Numbers are stored in the byte order of the writer, which the header records, so a
+// file can be used in place on machines with the same byte order and is rejected on
+// the others. MappedVectorFile maps a file and views its data without copies.
+
+enum class VectorFileLayout : std::uint32_t {
+    vectors = 0,
+    lanes = 1
+};
+
+struct VectorFileHeader {
+    static constexpr std::array<char, 8> MAGIC{'C', 'P', 'P', 'U', 'V', 'E', 'C', '\0'};
+    static constexpr std::uint32_t VERSION = 1;
+    // Reads as 0x04030201 when the byte order of the file is not the native one
+    static constexpr std::uint32_t ENDIANNESS_TAG = 0x01020304u;
+    static constexpr std::size_t DATA_ALIGNMENT = 64;
+
+    enum class ComponentType : std::uint32_t {
+        signed_integer = 1,
+        unsigned_integer = 2,
+        floating_point = 3,
+        half = 4
+    };
+
+    std::array<char, 8> magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t byte_order = ENDIANNESS_TAG;
+    ComponentType component_type{};
+    std::uint32_t component_size = 0;
+    std::uint32_t components = 0;
+    VectorFileLayout layout = VectorFileLayout::vectors;
+    std::uint64_t count = 0;
+    // Bytes from the start of one lane to the next, 0 for the vectors layout
+    std::uint64_t lane_stride = 0;
+    std::array<std::byte, 16> reserved{};
+
+    template <typename T, std::size_t SIZE>
+    [[nodiscard]] static constexpr VectorFileHeader create(VectorFileLayout data_layout, std::uint64_t vector_count) noexcept {
+        VectorFileHeader header;
+        header.component_type = componentType<T>();
+        header.component_size = sizeof(T);
+        header.components = SIZE;
+        header.layout = data_layout;
+        header.count = vector_count;
+        if(data_layout == VectorFileLayout::lanes)
+        {
+            const std::uint64_t lane_bytes = vector_count * sizeof(T);
+            header.lane_stride = (lane_bytes + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        }
+        return header;
+    }
+
+    template <typename T>
+    [[nodiscard]] static constexpr ComponentType componentType() noexcept {
+        if constexpr (std::is_same_v<T, Half>)
+            return ComponentType::half;
+        else if constexpr (std::floating_point<T>)
+            return ComponentType::floating_point;
+        else if constexpr (std::signed_integral<T>)
+            return ComponentType::signed_integer;
+        else
+        {
+            static_assert(std::unsigned_integral<T>, "Vector files store integer, floating point or Half components");
+            return ComponentType::unsigned_integer;
+        }
+    }
+
+    // Bytes after the header
+    [[nodiscard]] constexpr std::uint64_t dataSize() const noexcept {
+        if(layout == VectorFileLayout::lanes)
+        {
+            return lane_stride * components;
+        }
+        return count * components * component_size;
+    }
+};
+
+static_assert(sizeof(VectorFileHeader) == VectorFileHeader::DATA_ALIGNMENT && std::is_trivially_copyable_v<VectorFileHeader>);
+
+namespace detail
+{
+    [[nodiscard]] inline std::ofstream openVectorFile(const std::filesystem::path & path, const VectorFileHeader & header) {
+        std::ofstream file;
+        file.exceptions(std::ios::failbit | std::ios::badbit);
+        file.open(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        return file;
+    }
+
+    inline void writeBytes(std::ofstream & file, const void * data, std::size_t bytes) {
+        file.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+    }
+
+    // Read only view of a whole file: a private mapping, or a copy in aligned memory
+    // where mmap is not available
+    class ReadOnlyFile {
+    public:
+        explicit ReadOnlyFile(const std::filesystem::path & path) {
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open " + path.string());
+            }
+            struct stat status{};
+            if(::fstat(fd, &status) != 0)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+            }
+            m_size = static_cast<std::size_t>(status.st_size);
+            if(m_size > 0)
+            {
+                void * data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(data == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+                }
+                m_data = static_cast<const std::byte *>(data);
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(fd);
+#else
+            std::ifstream file;
+            file.exceptions(std::ios::failbit | std::ios::badbit);
+            file.open(path, std::ios::binary);
+            m_size = std::filesystem::file_size(path);
+            m_buffer.resize(m_size);
+            file.read(reinterpret_cast<char *>(m_buffer.data()), static_cast<std::streamsize>(m_size));
+            m_data = m_buffer.data();
+#endif
+        }
+
+        ~ReadOnlyFile() {
+#ifdef CPPUTILS_DETAIL_HAS_MMAP
+            if(m_data != nullptr)
+            {
+                ::munmap(const_cast<std::byte *>(m_data), m_size);
+            }
+#endif
+        }
+
+        ReadOnlyFile(ReadOnlyFile && other) noexcept :
+            m_data{std::exchange(other.m_data, nullptr)},
+            m_size{std::exchange(other.m_size, 0)}
+#ifndef CPPUTILS_DETAIL_HAS_MMAP
+            , m_buffer{std::move(other.m_buffer)}
+#endif
+        {
+        }
+
+        ReadOnlyFile & operator=(ReadOnlyFile && other) noexcept {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+#ifndef CPPUTILS_DETAIL_HAS_MMAP
+            std::swap(m_buffer, other.m_buffer);
+#endif
+            return *this;
+        }
+
+        ReadOnlyFile(const ReadOnlyFile &) = delete;
+        ReadOnlyFile & operator=(const ReadOnlyFile &) = delete;
+
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+            return {m_data, m_size};
+        }
+
+    private:
+        const std::byte * m_data = nullptr;
+        std::size_t m_size = 0;
+#ifndef CPPUTILS_DETAIL_HAS_MMAP
+        std::vector<std::byte, AlignedAllocator<std::byte, VectorFileHeader::DATA_ALIGNMENT>> m_buffer;
+#endif
+    };
+}
+
+// Writes a contiguous range of Vector<T, SIZE> with the vectors layout. Throws
+// std::ios_base::failure when the file cannot be written.
+template <std::ranges::contiguous_range VECTORS>
+void writeVectorFile(const std::filesystem::path & path, const VECTORS & vectors) {
+    using vector_type = std::ranges::range_value_t<VECTORS>;
+    using T = typename vector_type::value_type;
+    constexpr std::size_t SIZE = detail::ExpressionTraits<vector_type>::size;
+    static_assert(std::is_same_v<vector_type, Vector<T, SIZE>>, "writeVectorFile writes ranges of Vector");
+
+    const std::size_t count = std::ranges::size(vectors);
+    std::ofstream file = detail::openVectorFile(path, VectorFileHeader::create<T, SIZE>(VectorFileLayout::vectors, count));
+    const vector_type * data = std::ranges::data(vectors);
+    if constexpr (sizeof(vector_type) == SIZE * sizeof(T))
+    {
+        if(count > 0)
+        {
+            detail::writeBytes(file, data->begin(), count * sizeof(vector_type));
+        }
+    }
+    else
+    {
+        // Padded vectors, e.g. Vector3f with CPPUTILS_VECTOR_SIMD, are packed in chunks
+        constexpr std::size_t CHUNK_SIZE = 4096;
+        std::vector<T> packed(std::min(count, CHUNK_SIZE) * SIZE);
+        for(std::size_t begin = 0; begin < count; begin += CHUNK_SIZE)
+        {
+            const std::size_t chunk = std::min(CHUNK_SIZE, count - begin);
+            for(std::size_t i = 0; i < chunk; ++i)
+            {
+                std::copy(data[begin + i].begin(), data[begin + i].end(), packed.begin() + static_cast<std::ptrdiff_t>(i * SIZE));
+            }
+            detail::writeBytes(file, packed.data(), chunk * SIZE * sizeof(T));
+        }
+    }
+    // The last bytes are only written here, the destructor would swallow the error
+    file.close();
+}
+
+// Writes the lanes of a VectorArray with the lanes layout. Throws std::ios_base::failure
+// when the file cannot be written.
+template <typename T, std::size_t SIZE>
+void writeVectorFile(const std::filesystem::path & path, const VectorArray<T, SIZE> & array) {
+    const VectorFileHeader header = VectorFileHeader::create<T, SIZE>(VectorFileLayout::lanes, array.size());
+    std::ofstream file = detail::openVectorFile(path, header);
+    constexpr std::array<std::byte, VectorFileHeader::DATA_ALIGNMENT> padding{};
+    for(std::size_t c = 0; c < SIZE; ++c)
+    {
+        const auto lane = array.lane(c);
+        detail::writeBytes(file, lane.data(), lane.size_bytes());
+        detail::writeBytes(file, padding.data(), static_cast<std::size_t>(header.lane_stride) - lane.size_bytes());
+    }
+    file.close();
+}
+
+// Read only view of a vector file, mapped into memory: opening it costs the same for
+// any size, and pages are loaded by the operating system when they are first used.
+// The header is checked against T and SIZE, and std::runtime_error is thrown when it
+// does not match or the file is truncated. Spans are valid while the object lives.
+template <typename T, std::size_t SIZE> requires (SIZE > 0)
+class MappedVectorFile {
+public:
+    using value_type = T;
+    using vector_type = Vector<T, SIZE>;
+
+    static_assert(std::is_trivially_copyable_v<vector_type>);
+
+    explicit MappedVectorFile(const std::filesystem::path & path) :
+        m_file{path} {
+        const auto bytes = m_file.bytes();
+        if(bytes.size() < sizeof(VectorFileHeader))
+        {
+            throw std::runtime_error(path.string() + ": not a vector file");
+        }
+        std::memcpy(&m_header, bytes.data(), sizeof(m_header));
+        if(m_header.magic != VectorFileHeader::MAGIC)
+        {
+            throw std::runtime_error(path.string() + ": not a vector file");
+        }
+        if(m_header.byte_order != VectorFileHeader::ENDIANNESS_TAG)
+        {
+            throw std::runtime_error(path.string() + ": written with a different byte order");
+        }
+        if(m_header.version > VectorFileHeader::VERSION)
+        {
+            throw std::runtime_error(path.string() + ": unsupported version " + std::to_string(m_header.version));
+        }
+        if(m_header.component_type != VectorFileHeader::componentType<T>() || m_header.component_size != sizeof(T) || m_header.components != SIZE)
+        {
+            throw std::runtime_error(path.string() + ": the file does not contain vectors of this type");
+        }
+        if(m_header.layout != VectorFileLayout::vectors && m_header.layout != VectorFileLayout::lanes)
+        {
+            throw std::runtime_error(path.string() + ": unknown layout");
+        }
+        // Checked before computing sizes from the count, which could overflow
+        const std::size_t data_size = bytes.size() - sizeof(VectorFileHeader);
+        if(m_header.count > data_size / sizeof(T) / SIZE
+            || m_header.lane_stride != VectorFileHeader::create<T, SIZE>(m_header.layout, m_header.count).lane_stride
+            || m_header.dataSize() > data_size)
+        {
+            throw std::runtime_error(path.string() + ": truncated file");
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return static_cast<std::size_t>(m_header.count);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]] VectorFileLayout layout() const noexcept {
+        return m_header.layout;
+    }
+
+    [[nodiscard]] const VectorFileHeader & header() const noexcept {
+        return m_header;
+    }
+
+    // Vectors layout only, for vectors without padding
+    [[nodiscard]] std::span<const vector_type> vectors() const noexcept requires (sizeof(vector_type) == SIZE * sizeof(T)) {
+        assert(layout() == VectorFileLayout::vectors);
+        return {reinterpret_cast<const vector_type *>(data()), size()};
+    }
+
+    // Vectors layout only, the components of all the vectors in order
+    [[nodiscard]] std::span<const T> components() const noexcept {
+        assert(layout() == VectorFileLayout::vectors);
+        return {reinterpret_cast<const T *>(data()), size() * SIZE};
+    }
+
+    // Lanes layout only, component c of every vector
+    [[nodiscard]] std::span<const T> lane(std::size_t component) const noexcept {
+        assert(layout() == VectorFileLayout::lanes && component < SIZE);
+        return {reinterpret_cast<const T *>(data() + component * m_header.lane_stride), size()};
+    }
+
+    // Any layout
+    [[nodiscard]] vector_type get(std::size_t i) const noexcept {
+        assert(i < size());
+        vector_type result{};
+        for(std::size_t c = 0; c < SIZE; ++c)
+        {
+            result[c] = layout() == VectorFileLayout::vectors ? components()[i * SIZE + c] : lane(c)[i];
+        }
+        return result;
+    }
+
+private:
+    [[nodiscard]] const std::byte * data() const noexcept {
+        return m_file.bytes().data() + sizeof(VectorFileHeader);
+    }
+
+    detail::ReadOnlyFile m_file;
+    VectorFileHeader m_header;
+};
+
+#endif // VECTOR_FILE_HPP
@@ -0,0 +1,136 @@
+#ifndef VECTOR_KERNELS_HPP
+#define VECTOR_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "VectorExpression.hpp"
+
+// Loops over the components of Vector and of large contiguous VectorTuple, picked at
+// compile time from the size:
+// * Up to UNROLLED_MAX_SIZE components, the loops are fully unrolled, so the
+//   components stay in registers and comparisons need no branches.
+// * Above, components are processed in blocks of COMPONENT_BLOCK_SIZE with a compile
+//   time count through a local buffer. The output cannot alias the buffer, so GCC
+//   vectorizes the loops without runtime alias checks, even for a += b.
+// The values are the same for every size: sums are accumulated in component order,
+// like std::inner_product.
+namespace detail
+{
+    inline constexpr std::size_t UNROLLED_MAX_SIZE = 8;
+    inline constexpr std::size_t COMPONENT_BLOCK_SIZE = 64;
+
+    // function(j) for j in [0, N) without a loop. GCC may vectorize a short loop with
+    // a remainder instead of unrolling it, and then the arrays it uses stay in memory.
+    template <std::size_t N, typename FUNCTION>
+    constexpr void unroll(FUNCTION && function) {
+        [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+            (function(Js), ...);
+        }(std::make_index_sequence<N>());
+    }
+
+    // block(begin, count) over [0, SIZE), count is a std::integral_constant
+    template <std::size_t SIZE, typename BLOCK>
+    constexpr void forEachComponentBlock(BLOCK && block) {
+        constexpr std::size_t FULL_BLOCKS = SIZE / COMPONENT_BLOCK_SIZE;
+        for(std::size_t begin = 0; begin < FULL_BLOCKS * COMPONENT_BLOCK_SIZE; begin += COMPONENT_BLOCK_SIZE)
+        {
+            block(begin, std::integral_constant<std::size_t, COMPONENT_BLOCK_SIZE>());
+        }
+        if constexpr (SIZE % COMPONENT_BLOCK_SIZE != 0)
+        {
+            block(FULL_BLOCKS * COMPONENT_BLOCK_SIZE, std::integral_constant<std::size_t, SIZE % COMPONENT_BLOCK_SIZE>());
+        }
+    }
+
+    // block(begin, count) over [0, size) for sizes only known at run time. Full blocks
+    // get a std::integral_constant count, so the loops over them have a fixed trip count
+    // and vectorize, and the last partial block gets a std::size_t count.
+    template <std::size_t BLOCK_SIZE, typename BLOCK>
+    constexpr void forEachBlock(std::size_t size, BLOCK && block) {
+        std::size_t begin = 0;
+        for(; begin + BLOCK_SIZE <= size; begin += BLOCK_SIZE)
+        {
+            block(begin, std::integral_constant<std::size_t, BLOCK_SIZE>());
+        }
+        if(begin < size)
+        {
+            block(begin, size - begin);
+        }
+    }
+
+    // out[c] = function(c) for c in [0, SIZE). function(c) may read out[c].
+    template <std::size_t SIZE, typename T, typename FUNCTION>
+    constexpr void generateComponents(T * out, FUNCTION && function) {
+        if constexpr (SIZE <= UNROLLED_MAX_SIZE)
+        {
+            unroll<SIZE>([&](std::size_t c){ out[c] = function(c); });
+        }
+        else
+        {
+            std::array<T, std::min(SIZE, COMPONENT_BLOCK_SIZE)> buffer;
+            forEachComponentBlock<SIZE>([&](std::size_t begin, auto count){
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    buffer[i] = function(begin + i);
+                }
+                std::copy_n(buffer.begin(), count(), out + begin);
+            });
+        }
+    }
+
+    // ((T{} + function(0)) + function(1)) + ... in component order. Blocks of large
+    // sizes compute their terms first, which vectorizes, and then add them in order.
+    template <std::size_t SIZE, typename T, typename FUNCTION>
+    [[nodiscard]] constexpr T sumComponents(FUNCTION && function) {
+        T result{};
+        if constexpr (SIZE <= UNROLLED_MAX_SIZE)
+        {
+            unroll<SIZE>([&](std::size_t c){ result = convertTo<T>(result + function(c)); });
+        }
+        else
+        {
+            std::array<decltype(function(std::size_t{0})), std::min(SIZE, COMPONENT_BLOCK_SIZE)> terms;
+            forEachComponentBlock<SIZE>([&](std::size_t begin, auto count){
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    terms[i] = function(begin + i);
+                }
+                for(std::size_t i = 0; i < count; ++i)
+                {
+                    result = convertTo<T>(result + terms[i]);
+                }
+            });
+        }
+        return result;
+    }
+
+    // function(c) holds for every c in [0, SIZE). The conditions are combined with &
+    // instead of &&, without branches, in the unrolled loop and inside the blocks.
+    template <std::size_t SIZE, typename FUNCTION>
+    [[nodiscard]] constexpr bool allComponents(FUNCTION && function) {
+        bool result = true;
+        if constexpr (SIZE <= UNROLLED_MAX_SIZE)
+        {
+            unroll<SIZE>([&](std::size_t c){ result &= function(c); });
+        }
+        else
+        {
+            forEachComponentBlock<SIZE>([&](std::size_t begin, auto count){
+                if(result)
+                {
+                    for(std::size_t i = 0; i < count; ++i)
+                    {
+                        result &= function(begin + i);
+                    }
+                }
+            });
+        }
+        return result;
+    }
+}
+
+#endif // VECTOR_KERNELS_HPP
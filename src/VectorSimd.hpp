@@ -0,0 +1,123 @@
+#ifndef VECTOR_SIMD_HPP
+#define VECTOR_SIMD_HPP
+
+#include <cstddef>
+
+#if defined(CPPUTILS_VECTOR_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(CPPUTILS_VECTOR_SIMD) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+// Opt-in SIMD kernels used by Vector when CPPUTILS_VECTOR_SIMD is defined.
+// Enabled types store their components padded to one full 4 lane register.
+// Every kernel produces exactly the same bits as the std::transform /
+// std::inner_product path: lanes are computed independently and horizontal
+// sums are accumulated in component order.
+template <typename T, std::size_t SIZE>
+struct VectorSimd {
+    static constexpr bool enabled = false;
+    static constexpr std::size_t storage_size = SIZE;
+    static constexpr std::size_t alignment = alignof(T);
+};
+
+#if defined(CPPUTILS_VECTOR_SIMD) && defined(__SSE2__)
+
+template <std::size_t SIZE> requires (SIZE == 3 || SIZE == 4)
+struct VectorSimd<float, SIZE> {
+    static constexpr bool enabled = true;
+    static constexpr std::size_t storage_size = 4;
+    static constexpr std::size_t alignment = 16;
+
+    static void add(const float * lhs, const float * rhs, float * out) noexcept {
+        _mm_store_ps(out, _mm_add_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    }
+
+    static void sub(const float * lhs, const float * rhs, float * out) noexcept {
+        _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    }
+
+    static void mul(const float * lhs, float scalar, float * out) noexcept {
+        _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(lhs), _mm_set1_ps(scalar)));
+    }
+
+    static void div(const float * lhs, float scalar, float * out) noexcept {
+        _mm_store_ps(out, _mm_div_ps(_mm_load_ps(lhs), _mm_set1_ps(scalar)));
+    }
+
+    [[nodiscard]] static float dot(const float * lhs, const float * rhs) noexcept {
+        alignas(16) float products[4];
+        _mm_store_ps(products, _mm_mul_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+        float result{};
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            result += products[i];
+        }
+        return result;
+    }
+
+    [[nodiscard]] static bool isNull(const float * data) noexcept {
+        constexpr int mask = (1 << SIZE) - 1;
+        return (_mm_movemask_ps(_mm_cmpeq_ps(_mm_load_ps(data), _mm_setzero_ps())) & mask) == mask;
+    }
+};
+
+template <std::size_t SIZE> requires (SIZE == 3 || SIZE == 4)
+struct VectorSimd<int, SIZE> {
+    static constexpr bool enabled = true;
+    static constexpr std::size_t storage_size = 4;
+    static constexpr std::size_t alignment = 16;
+
+    static void add(const int * lhs, const int * rhs, int * out) noexcept {
+        _mm_store_si128(reinterpret_cast<__m128i *>(out), _mm_add_epi32(load(lhs), load(rhs)));
+    }
+
+    static void sub(const int * lhs, const int * rhs, int * out) noexcept {
+        _mm_store_si128(reinterpret_cast<__m128i *>(out), _mm_sub_epi32(load(lhs), load(rhs)));
+    }
+
+    static void mul(const int * lhs, int scalar, int * out) noexcept {
+#if defined(__SSE4_1__)
+        _mm_store_si128(reinterpret_cast<__m128i *>(out), _mm_mullo_epi32(load(lhs), _mm_set1_epi32(scalar)));
+#else
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            out[i] = lhs[i] * scalar;
+        }
+#endif
+    }
+
+    [[nodiscard]] static int dot(const int * lhs, const int * rhs) noexcept {
+        int result{};
+#if defined(__SSE4_1__)
+        alignas(16) int products[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(products), _mm_mullo_epi32(load(lhs), load(rhs)));
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            result += products[i];
+        }
+#else
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            result += lhs[i] * rhs[i];
+        }
+#endif
+        return result;
+    }
+
+    [[nodiscard]] static bool isNull(const int * data) noexcept {
+        constexpr int mask = (1 << SIZE) - 1;
+        const __m128i equal = _mm_cmpeq_epi32(load(data), _mm_setzero_si128());
+        return (_mm_movemask_ps(_mm_castsi128_ps(equal)) & mask) == mask;
+    }
+
+private:
+    [[nodiscard]] static __m128i load(const int * data) noexcept {
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(data));
+    }
+};
+
+#endif
+
+#endif // VECTOR_SIMD_HPP
@@ -5,39 +5,87 @@
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <ranges>
+#include <span>
 #include <tuple>
 #include <utility>
 
 #include "VectorTupleHelpers.hpp"
 
-template<typename T, std::size_t SIZE> requires (SIZE > 0)
+// Storage policies of VectorTuple.
+// TupleStorage keeps one tuple element per component, its layout is up to the compiler.
+// ContiguousStorage keeps the components in order in one array aligned to ALIGNMENT
+// (alignof(T) when 0), so vectors can be copied as bytes and spans of them seen as
+// spans of components.
+struct TupleStorage {
+    static constexpr bool contiguous = false;
+
+    template <typename T, std::size_t SIZE>
+    using type = typename TupleOfN<T, SIZE>::type;
+};
+
+template <std::size_t ALIGNMENT = 0>
+struct ContiguousStorage {
+    static constexpr bool contiguous = true;
+
+    template <typename T, std::size_t SIZE>
+    using type = ContiguousTuple<T, SIZE, ALIGNMENT>;
+};
+
+// MixedStorage keeps components of different types in a std::tuple, e.g. quantized
+// components next to full precision ones. The VectorTuple value type is their
+// std::common_type_t, see MixedVectorTuple below.
+template <typename... COMPONENTS>
+struct MixedStorage {
+    static constexpr bool contiguous = false;
+
+    template <typename T, std::size_t SIZE> requires (SIZE == sizeof...(COMPONENTS))
+    using type = std::tuple<COMPONENTS...>;
+};
+
+template<typename T, std::size_t SIZE, typename STORAGE = TupleStorage> requires (SIZE > 0)
 class VectorTuple {
 private:
-    using tuple_type = typename TupleOfN<T, SIZE>::type;
+    using tuple_type = typename STORAGE::template type<T, SIZE>;
     tuple_type m_data;
+
+    // Every argument must have the exact type of its component
+    template <typename... ARGS, std::size_t... Is>
+    static consteval bool argumentsMatch(std::index_sequence<Is...>) noexcept {
+        if constexpr (sizeof...(ARGS) != SIZE)
+        {
+            return false;
+        }
+        else
+        {
+            return (std::is_same_v<std::tuple_element_t<Is, tuple_type>, std::decay_t<ARGS>> && ...);
+        }
+    }
 public:
     using value_type = T;
     using reference = value_type &;
+    using storage_type = STORAGE;
 
-    template <typename... ARGS, typename = std::enable_if_t<std::conjunction_v<std::is_same<T, std::decay_t<ARGS>>...>>>
+    template <typename... ARGS> requires (sizeof...(ARGS) == 0 || argumentsMatch<ARGS...>(std::make_index_sequence<SIZE>()))
     consteval VectorTuple(ARGS&&... args) : m_data(std::forward<ARGS>(args)...) {}
 
     template <T VALUE>
     [[nodiscard]] consteval static VectorTuple from_val() noexcept {
-        VectorTuple<T, SIZE> ret;
-        ret.m_data = createTupleWithSameValue<T, SIZE>(VALUE);
+        VectorTuple ret;
+        ret.m_data = createTupleWithSameValue<T, SIZE, tuple_type>(VALUE);
         return ret;
     }
 
-    template <typename U>
-    [[nodiscard]] constexpr VectorTuple(const VectorTuple<U, SIZE> & other) noexcept : m_data{other.m_data} { }
+    // Converts the components and, if needed, the storage
+    template <typename U, typename OTHER_STORAGE>
+    [[nodiscard]] constexpr VectorTuple(const VectorTuple<U, SIZE, OTHER_STORAGE> & other) noexcept : m_data{tupleConvert<tuple_type>(other.m_data)} { }
 
-    template <typename U, std::size_t S>
+    template <typename U, std::size_t S, typename OTHER_STORAGE> requires (S > 0)
     friend class VectorTuple;
 
     template <typename U, typename S>
     [[nodiscard]] consteval static VectorTuple fromAngleAndLength(const U & angle, const S & scalar) noexcept {
-        return VectorTuple<T, 2>{
+        return VectorTuple<T, 2, STORAGE>{
             static_cast<T>(std::cos(angle) * static_cast<U>(scalar)),
             static_cast<T>(std::sin(angle) * static_cast<U>(scalar))
         };
@@ -45,8 +93,8 @@ public:
 
     template <typename U = value_type>
     [[nodiscard]] constexpr U lengthSquared() const noexcept {
-        return std::apply([](const auto & ... args){
-            return ((args * args) + ...);
+        return tupleApply([](const auto & ... args){
+            return ((tupleElementCast<T>(args) * tupleElementCast<T>(args)) + ...);
         }, m_data);
     }
 
@@ -56,7 +104,7 @@ public:
     }
 
     constexpr bool is_null() const noexcept {
-        return std::apply([](const auto&... args){
+        return tupleApply([](const auto&... args){
             return ((args == 0) && ...);
         }, m_data);
     }
@@ -68,99 +116,121 @@ public:
         }
     }
 
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> normalized() const noexcept {
-        VectorTuple<T, SIZE> result = *this;
+    [[nodiscard]] constexpr VectorTuple normalized() const noexcept {
+        VectorTuple result = *this;
         result.normalize();
         return result;
     }
 
     template <typename PRECISION = float>
-    [[nodiscard]] constexpr PRECISION angle(const VectorTuple<T, SIZE> & other) const noexcept {
+    [[nodiscard]] constexpr PRECISION angle(const VectorTuple & other) const noexcept {
         auto dot = *this * other;
         return static_cast<PRECISION>(std::acos(dot / (length() * other.length())));
     }
 
+    // value_type, or the type of the component with MixedStorage
     template <std::size_t IDX>
-    [[nodiscard]] constexpr const value_type & get() const noexcept {
+    using component_type = std::tuple_element_t<IDX, tuple_type>;
+
+    template <std::size_t IDX>
+    [[nodiscard]] constexpr const component_type<IDX> & get() const noexcept {
         static_assert(IDX < SIZE);
-        return std::get<IDX>(m_data);
+        return tupleGet<IDX>(m_data);
     }
 
     template <std::size_t IDX>
-    [[nodiscard]] constexpr value_type & get() noexcept {
+    [[nodiscard]] constexpr component_type<IDX> & get() noexcept {
         static_assert(IDX < SIZE);
-        return std::get<IDX>(m_data);
+        return tupleGet<IDX>(m_data);
+    }
+
+    [[nodiscard]] constexpr const value_type * data() const noexcept requires STORAGE::contiguous {
+        return m_data.values.data();
     }
 
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> operator+(const VectorTuple<T, SIZE> & rhs) const noexcept {
-        VectorTuple<T, SIZE> result;
+    [[nodiscard]] constexpr value_type * data() noexcept requires STORAGE::contiguous {
+        return m_data.values.data();
+    }
+
+    // The components of a contiguous range of vectors, only when there is no padding between them
+    template <std::ranges::contiguous_range R>
+        requires (std::ranges::borrowed_range<R> && std::ranges::sized_range<R>
+            && std::is_same_v<std::ranges::range_value_t<R>, VectorTuple>
+            && STORAGE::contiguous && sizeof(tuple_type) == SIZE * sizeof(T))
+    [[nodiscard]] static auto components(R && vectors) noexcept {
+        using component_type = std::conditional_t<std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>>, const T, T>;
+        return std::span<component_type>(std::ranges::empty(vectors) ? nullptr : std::ranges::data(vectors)->data(), std::ranges::size(vectors) * SIZE);
+    }
+
+    [[nodiscard]] constexpr VectorTuple operator+(const VectorTuple & rhs) const noexcept {
+        VectorTuple result;
         result.m_data = tupleElementWiseOp(m_data, rhs.m_data, std::plus());
         return result;
     }
 
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> operator-(const VectorTuple<T, SIZE> & rhs) const noexcept {
-        VectorTuple<T, SIZE> result;
+    [[nodiscard]] constexpr VectorTuple operator-(const VectorTuple & rhs) const noexcept {
+        VectorTuple result;
         result.m_data = tupleElementWiseOp(m_data, rhs.m_data, std::minus());
         return result;
     }
 
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> operator-() const noexcept {
-        VectorTuple<T, SIZE> result;
+    [[nodiscard]] constexpr VectorTuple operator-() const noexcept {
+        VectorTuple result;
         result.m_data = tupleUnaryOp(m_data, std::negate<>());
         return result;
     }
 
     template <typename U> requires (std::integral<U> or std::floating_point<U>)
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> operator*(const U & scalar) const noexcept {
-        VectorTuple<T, SIZE> result;
+    [[nodiscard]] constexpr VectorTuple operator*(const U & scalar) const noexcept {
+        VectorTuple result;
         result.m_data = tupleBinaryOp(m_data, std::multiplies<>(), scalar);
         return result;
     }
 
-    [[nodiscard]] constexpr T operator*(const VectorTuple<T, SIZE> & rhs) const noexcept {
+    [[nodiscard]] constexpr T operator*(const VectorTuple & rhs) const noexcept {
         return tupleDotProduct(m_data, rhs.m_data);
     }
 
     template <typename U>
-    [[nodiscard]] constexpr VectorTuple<T, SIZE> operator/(const U & scalar) const noexcept {
-        VectorTuple<T, SIZE> result;
+    [[nodiscard]] constexpr VectorTuple operator/(const U & scalar) const noexcept {
+        VectorTuple result;
         result.m_data = tupleBinaryOp(m_data, std::divides<>(), scalar);
         return result;
     }
 
-    constexpr VectorTuple<T, SIZE> operator+=(const VectorTuple<T, SIZE> & rhs) noexcept {
+    constexpr VectorTuple operator+=(const VectorTuple & rhs) noexcept {
         m_data = tupleElementWiseOp(m_data, rhs.m_data, std::plus());
         return *this;
     }
 
-    constexpr VectorTuple<T, SIZE> operator-=(const VectorTuple<T, SIZE> & rhs) noexcept {
+    constexpr VectorTuple operator-=(const VectorTuple & rhs) noexcept {
         m_data = tupleElementWiseOp(m_data, rhs.m_data, std::minus());
         return *this;
     }
 
     template <typename U>
-    constexpr VectorTuple<T, SIZE> operator*=(const U & scalar) noexcept {
+    constexpr VectorTuple operator*=(const U & scalar) noexcept {
         *this = *this * scalar;
         return *this;
     }
 
     template <typename U>
-    constexpr VectorTuple<T, SIZE> operator/=(const U & scalar) noexcept {
+    constexpr VectorTuple operator/=(const U & scalar) noexcept {
         *this = *this / scalar;
         return *this;
     }
 
-    [[nodiscard]] constexpr auto operator<=>(const VectorTuple<T, SIZE>&) const = default;
+    [[nodiscard]] constexpr auto operator<=>(const VectorTuple &) const = default;
 };
 
-template <typename T, std::size_t SIZE>
-constexpr VectorTuple<T, SIZE> operator*(const T & scalar, const VectorTuple<T, SIZE> & rhs) noexcept
+template <typename T, std::size_t SIZE, typename STORAGE>
+constexpr VectorTuple<T, SIZE, STORAGE> operator*(const T & scalar, const VectorTuple<T, SIZE, STORAGE> & rhs) noexcept
 {
     return rhs * scalar;
 }
 
-template <typename T, std::size_t SIZE>
-constexpr VectorTuple<T, SIZE> operator/(const T & scalar, const VectorTuple<T, SIZE> & rhs) noexcept
+template <typename T, std::size_t SIZE, typename STORAGE>
+constexpr VectorTuple<T, SIZE, STORAGE> operator/(const T & scalar, const VectorTuple<T, SIZE, STORAGE> & rhs) noexcept
 {
     return scalar / rhs;
 }
@@ -188,4 +258,13 @@ using VectorTupleu = VectorTuple<unsigned int, SIZE>;
 template <std::size_t SIZE>
 using VectorTuplef = VectorTuple<float, SIZE>;
 
+template <typename T, std::size_t SIZE, std::size_t ALIGNMENT = 0>
+using ContiguousVectorTuple = VectorTuple<T, SIZE, ContiguousStorage<ALIGNMENT>>;
+
+// Components of different types, e.g. MixedVectorTuple<float, float, std::int16_t>.
+// Arithmetic promotes each pair of components to their common type and converts the
+// result back to the component type (see tupleElementWiseOp and tupleDotProduct).
+template <typename... COMPONENTS>
+using MixedVectorTuple = VectorTuple<std::common_type_t<COMPONENTS...>, sizeof...(COMPONENTS), MixedStorage<COMPONENTS...>>;
+
 #endif // VECTOR_HPP
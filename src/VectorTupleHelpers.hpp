@@ -1,41 +1,191 @@
 #ifndef VECTOR_TUPLE_HELPERS_HPP
-#define VERTOR_TUPLE_HELPERS_HPP
+#define VECTOR_TUPLE_HELPERS_HPP
 
+#include <array>
+#include <compare>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
-template <typename T, std::size_t N>
-struct TupleOfN {
-    using type = decltype(std::tuple_cat(std::declval<std::tuple<T>>(), std::declval<typename TupleOfN<T, N - 1>::type>()));
+#include "VectorKernels.hpp"
+
+// Every helper expands a single index pack instead of recursing once per element,
+// so the number of instantiations grows linearly with the tuple size.
+// The helpers access elements with an unqualified get<I>, which works for std::tuple
+// and for the FlatTuple and ContiguousTuple storages below.
+
+template <typename T, typename U>
+[[nodiscard]] constexpr T tupleElementCast(U && value) noexcept {
+    if constexpr (std::is_same_v<T, std::remove_cvref_t<U>>)
+    {
+        return std::forward<U>(value);
+    }
+    else
+    {
+        return static_cast<T>(value);
+    }
+}
+
+template <typename T, std::size_t I>
+struct TupleLeaf {
+    T value{};
+
+    [[nodiscard]] constexpr auto operator<=>(const TupleLeaf &) const = default;
 };
 
-template <typename T>
-struct TupleOfN<T, 0> {
-    using type = std::tuple<>;
+template <typename T, typename INDICES>
+class FlatTupleImpl;
+
+// Tuple of identical types with every element in its own direct base, so get<I> is a
+// single derived to base conversion. std::tuple nests one base per element, which
+// makes each get<I> and each comparison cost linear in the size at compile time.
+template <typename T, std::size_t... Is>
+class FlatTupleImpl<T, std::index_sequence<Is...>> : private TupleLeaf<T, Is>... {
+public:
+    constexpr FlatTupleImpl() noexcept = default;
+
+    template <typename... U> requires (sizeof...(U) == sizeof...(Is) && sizeof...(U) > 0 && (std::is_convertible_v<U, T> && ...))
+    constexpr FlatTupleImpl(U &&... values) noexcept : TupleLeaf<T, Is>{tupleElementCast<T>(std::forward<U>(values))}... {
+    }
+
+    template <typename U>
+    constexpr FlatTupleImpl(const FlatTupleImpl<U, std::index_sequence<Is...>> & other) noexcept :
+        TupleLeaf<T, Is>{tupleElementCast<T>(get<Is>(other))}... {
+    }
+
+    template <std::size_t I, typename U, typename INDICES>
+    friend constexpr U & get(FlatTupleImpl<U, INDICES> & tuple) noexcept;
+
+    template <std::size_t I, typename U, typename INDICES>
+    friend constexpr const U & get(const FlatTupleImpl<U, INDICES> & tuple) noexcept;
+
+    [[nodiscard]] constexpr auto operator<=>(const FlatTupleImpl &) const = default;
 };
 
+template <std::size_t I, typename T, typename INDICES>
+[[nodiscard]] constexpr T & get(FlatTupleImpl<T, INDICES> & tuple) noexcept {
+    return static_cast<TupleLeaf<T, I> &>(tuple).value;
+}
+
+template <std::size_t I, typename T, typename INDICES>
+[[nodiscard]] constexpr const T & get(const FlatTupleImpl<T, INDICES> & tuple) noexcept {
+    return static_cast<const TupleLeaf<T, I> &>(tuple).value;
+}
+
+template <typename T, std::size_t N>
+using FlatTuple = FlatTupleImpl<T, std::make_index_sequence<N>>;
+
 template <typename T, std::size_t... Is>
-consteval auto fillTupleWithValue(const T& value, std::index_sequence<Is...>) {
-    return std::make_tuple((static_cast<void>(Is), value)...);
+struct std::tuple_size<FlatTupleImpl<T, std::index_sequence<Is...>>> : std::integral_constant<std::size_t, sizeof...(Is)> {
+};
+
+template <std::size_t I, typename T, typename INDICES>
+struct std::tuple_element<I, FlatTupleImpl<T, INDICES>> {
+    using type = T;
+};
+
+// Tuple of identical types stored in one array: components are contiguous, in order
+// and without padding between them. The whole tuple is aligned to ALIGNMENT, or to
+// alignof(T) when ALIGNMENT is 0.
+template <typename T, std::size_t N, std::size_t ALIGNMENT = 0>
+    requires (ALIGNMENT == 0 || (ALIGNMENT >= alignof(T) && (ALIGNMENT & (ALIGNMENT - 1)) == 0))
+struct ContiguousTuple {
+    alignas(ALIGNMENT == 0 ? alignof(T) : ALIGNMENT) std::array<T, N> values{};
+
+    constexpr ContiguousTuple() noexcept = default;
+
+    template <typename... U> requires (sizeof...(U) == N && (std::is_convertible_v<U, T> && ...))
+    constexpr ContiguousTuple(U &&... args) noexcept : values{tupleElementCast<T>(std::forward<U>(args))...} {
+    }
+
+    [[nodiscard]] constexpr auto operator<=>(const ContiguousTuple &) const = default;
+};
+
+template <std::size_t I, typename T, std::size_t N, std::size_t ALIGNMENT>
+[[nodiscard]] constexpr T & get(ContiguousTuple<T, N, ALIGNMENT> & tuple) noexcept {
+    return std::get<I>(tuple.values);
+}
+
+template <std::size_t I, typename T, std::size_t N, std::size_t ALIGNMENT>
+[[nodiscard]] constexpr const T & get(const ContiguousTuple<T, N, ALIGNMENT> & tuple) noexcept {
+    return std::get<I>(tuple.values);
 }
 
+template <typename T, std::size_t N, std::size_t ALIGNMENT>
+struct std::tuple_size<ContiguousTuple<T, N, ALIGNMENT>> : std::integral_constant<std::size_t, N> {
+};
+
+template <std::size_t I, typename T, std::size_t N, std::size_t ALIGNMENT>
+struct std::tuple_element<I, ContiguousTuple<T, N, ALIGNMENT>> {
+    using type = T;
+};
+
 template <typename T, std::size_t N>
-consteval auto createTupleWithSameValue(const T& value) {
-    return fillTupleWithValue(value, std::make_index_sequence<N>());
+struct TupleOfN {
+    using type = FlatTuple<T, N>;
+};
+
+template <typename TUPLE, typename T, std::size_t... Is>
+consteval TUPLE fillTupleWithValue(const T& value, std::index_sequence<Is...>) {
+    return TUPLE((static_cast<void>(Is), value)...);
+}
+
+template <typename T, std::size_t N, typename TUPLE = typename TupleOfN<T, N>::type>
+consteval TUPLE createTupleWithSameValue(const T& value) {
+    return fillTupleWithValue<TUPLE>(value, std::make_index_sequence<N>());
+}
+
+// get<I> for std::tuple, FlatTuple and ContiguousTuple, for classes with their own get member
+template <std::size_t I, typename TUPLE>
+[[nodiscard]] constexpr decltype(auto) tupleGet(TUPLE & tuple) noexcept {
+    return get<I>(tuple);
+}
+
+template <typename TUPLE, typename Func, std::size_t... Indices>
+constexpr decltype(auto) tupleApplyHelper(Func && func, TUPLE & tuple, std::index_sequence<Indices...>) {
+    return std::forward<Func>(func)(get<Indices>(tuple)...);
+}
+
+// std::apply for std::tuple, FlatTuple and ContiguousTuple
+template <typename TUPLE, typename Func>
+constexpr decltype(auto) tupleApply(Func && func, TUPLE & tuple) {
+    return tupleApplyHelper(std::forward<Func>(func), tuple, std::make_index_sequence<std::tuple_size_v<std::remove_const_t<TUPLE>>>());
 }
 
+template <typename TUPLE, typename OTHER, std::size_t... Indices>
+constexpr TUPLE tupleConvertHelper(const OTHER & other, std::index_sequence<Indices...>) {
+    return TUPLE(tupleElementCast<std::tuple_element_t<Indices, TUPLE>>(get<Indices>(other))...);
+}
+
+// Element by element conversion between tuples of the same size and any storage
+template <typename TUPLE, typename OTHER>
+constexpr TUPLE tupleConvert(const OTHER & other) {
+    static_assert(std::tuple_size_v<TUPLE> == std::tuple_size_v<OTHER>, "Tuples must have the same size.");
+    return tupleConvertHelper<TUPLE>(other, std::make_index_sequence<std::tuple_size_v<TUPLE>>());
+}
+
+// Promotion between tuples of different element types: element I of an element wise
+// operation is computed in std::common_type_t of the two elements and the result is
+// converted back to the element type of the first tuple.
+template <std::size_t I, typename Tuple1, typename Tuple2>
+using TupleCommonElement = std::common_type_t<std::tuple_element_t<I, Tuple1>, std::tuple_element_t<I, Tuple2>>;
+
 template <typename Tuple1, typename Tuple2, std::size_t... Indices, typename BinaryOp>
-constexpr auto tupleElementWiseOpHelper(const Tuple1& t1, const Tuple2& t2, std::index_sequence<Indices...>, BinaryOp op) {
-    return std::make_tuple(op(std::get<Indices>(t1), std::get<Indices>(t2))...);
+constexpr Tuple1 tupleElementWiseOpHelper(const Tuple1& t1, const Tuple2& t2, std::index_sequence<Indices...>, BinaryOp op) {
+    return Tuple1(tupleElementCast<std::tuple_element_t<Indices, Tuple1>>(op(
+        tupleElementCast<TupleCommonElement<Indices, Tuple1, Tuple2>>(get<Indices>(t1)),
+        tupleElementCast<TupleCommonElement<Indices, Tuple1, Tuple2>>(get<Indices>(t2))))...);
 }
 
 template <typename Tuple1, typename Tuple2, typename BinaryOp>
-constexpr auto tupleElementWiseOp(const Tuple1& t1, const Tuple2& t2, BinaryOp op) {
+constexpr Tuple1 tupleElementWiseOp(const Tuple1& t1, const Tuple2& t2, BinaryOp op) {
+    static_assert(std::tuple_size_v<Tuple1> == std::tuple_size_v<Tuple2>, "Tuples must have the same size.");
     return tupleElementWiseOpHelper(t1, t2, std::make_index_sequence<std::tuple_size_v<Tuple1>>(), op);
 }
 
 template <typename TUPLE, std::size_t... Indices, typename BinaryOp, typename T>
-constexpr auto tupleBinaryOpHelper(const TUPLE& tuple, std::index_sequence<Indices...>, BinaryOp op, const T & scalar) {
-    return std::make_tuple(op(std::get<Indices>(tuple), scalar)...);
+constexpr TUPLE tupleBinaryOpHelper(const TUPLE& tuple, std::index_sequence<Indices...>, BinaryOp op, const T & scalar) {
+    return TUPLE(tupleElementCast<std::tuple_element_t<Indices, TUPLE>>(op(get<Indices>(tuple), scalar))...);
 }
 
 template <typename TUPLE, typename BinaryOp, typename T>
@@ -44,8 +194,8 @@ constexpr TUPLE tupleBinaryOp(const TUPLE& tuple, BinaryOp op, const T & scalar)
 }
 
 template <typename TUPLE, std::size_t... Indices, typename UnaryOp>
-constexpr auto tupleUnaryOpHelper(const TUPLE& tuple, std::index_sequence<Indices...>, UnaryOp op) {
-    return std::make_tuple(op(std::get<Indices>(tuple))...);
+constexpr TUPLE tupleUnaryOpHelper(const TUPLE& tuple, std::index_sequence<Indices...>, UnaryOp op) {
+    return TUPLE(tupleElementCast<std::tuple_element_t<Indices, TUPLE>>(op(get<Indices>(tuple)))...);
 }
 
 template <typename TUPLE, typename UnaryOp>
@@ -53,24 +203,70 @@ constexpr TUPLE tupleUnaryOp(const TUPLE& tuple, UnaryOp op) {
     return tupleUnaryOpHelper(tuple, std::make_index_sequence<std::tuple_size_v<TUPLE>>(), op);
 }
 
-template <std::size_t Index, typename Tuple1, typename Tuple2>
-std::enable_if_t<Index == 0, decltype(std::get<0>(std::declval<Tuple1>()) * std::get<0>(std::declval<Tuple2>()))>
-tupleDotProductHelper(const Tuple1&, const Tuple2&) {
-    return decltype(std::get<0>(std::declval<Tuple1>()) * std::get<0>(std::declval<Tuple2>()))(0);
+template <typename Tuple1, typename Tuple2, typename INDICES>
+struct TupleDotProductResult;
+
+template <typename Tuple1, typename Tuple2, std::size_t... Indices>
+struct TupleDotProductResult<Tuple1, Tuple2, std::index_sequence<Indices...>> {
+    using type = std::common_type_t<decltype(std::declval<std::tuple_element_t<Indices, Tuple1>>() * std::declval<std::tuple_element_t<Indices, Tuple2>>())...>;
+};
+
+// The dot product is the common type of the element products (int for int16_t
+// elements, float for float and int16_t elements). Both factors are converted to it
+// before multiplying, and the products are added in a left fold from zero:
+// ((0 + a0 * b0) + a1 * b1) + ...
+template <typename Tuple1, typename Tuple2>
+using TupleDotProductType = typename TupleDotProductResult<Tuple1, Tuple2, std::make_index_sequence<std::tuple_size_v<Tuple1>>>::type;
+
+template <typename Tuple1, typename Tuple2, std::size_t... Indices>
+constexpr auto tupleDotProductHelper(const Tuple1& t1, const Tuple2& t2, std::index_sequence<Indices...>) {
+    using result_type = TupleDotProductType<Tuple1, Tuple2>;
+    return (result_type(0) + ... + (tupleElementCast<result_type>(get<Indices>(t1)) * tupleElementCast<result_type>(get<Indices>(t2))));
+}
+
+template <typename Tuple1, typename Tuple2>
+constexpr auto tupleDotProduct(const Tuple1& t1, const Tuple2& t2) {
+    static_assert(std::tuple_size_v<Tuple1> == std::tuple_size_v<Tuple2>, "Tuples must have the same size.");
+    return tupleDotProductHelper(t1, t2, std::make_index_sequence<std::tuple_size_v<Tuple1>>());
+}
+
+// Large ContiguousTuple: loops over the array instead of one expression per element,
+// unrolled or blocked like Vector (see VectorKernels.hpp), with the same results as
+// the helpers above. Partial ordering picks them over the generic ones.
+
+template <typename T, std::size_t N, std::size_t ALIGNMENT, typename BinaryOp> requires (N > detail::UNROLLED_MAX_SIZE)
+constexpr ContiguousTuple<T, N, ALIGNMENT> tupleElementWiseOp(const ContiguousTuple<T, N, ALIGNMENT> & t1, const ContiguousTuple<T, N, ALIGNMENT> & t2, BinaryOp op) {
+    ContiguousTuple<T, N, ALIGNMENT> result;
+    detail::generateComponents<N>(result.values.data(), [&](std::size_t i){
+        return tupleElementCast<T>(op(t1.values[i], t2.values[i]));
+    });
+    return result;
+}
+
+template <typename T, std::size_t N, std::size_t ALIGNMENT, typename BinaryOp, typename U> requires (N > detail::UNROLLED_MAX_SIZE)
+constexpr ContiguousTuple<T, N, ALIGNMENT> tupleBinaryOp(const ContiguousTuple<T, N, ALIGNMENT> & tuple, BinaryOp op, const U & scalar) {
+    ContiguousTuple<T, N, ALIGNMENT> result;
+    detail::generateComponents<N>(result.values.data(), [&](std::size_t i){
+        return tupleElementCast<T>(op(tuple.values[i], scalar));
+    });
+    return result;
 }
 
-template <std::size_t Index, typename Tuple1, typename Tuple2>
-std::enable_if_t<Index != 0, decltype(std::get<0>(std::declval<Tuple1>()) * std::get<0>(std::declval<Tuple2>()))>
-tupleDotProductHelper(const Tuple1& t1, const Tuple2& t2) {
-    auto tail = tupleDotProductHelper<Index - 1>(t1, t2);
-    auto product = std::get<Index - 1>(t1) * std::get<Index - 1>(t2);
-    return tail + product;
+template <typename T, std::size_t N, std::size_t ALIGNMENT, typename UnaryOp> requires (N > detail::UNROLLED_MAX_SIZE)
+constexpr ContiguousTuple<T, N, ALIGNMENT> tupleUnaryOp(const ContiguousTuple<T, N, ALIGNMENT> & tuple, UnaryOp op) {
+    ContiguousTuple<T, N, ALIGNMENT> result;
+    detail::generateComponents<N>(result.values.data(), [&](std::size_t i){
+        return tupleElementCast<T>(op(tuple.values[i]));
+    });
+    return result;
 }
 
-template <typename... Args1, typename... Args2>
-auto tupleDotProduct(const std::tuple<Args1...>& t1, const std::tuple<Args2...>& t2) {
-    static_assert(sizeof...(Args1) == sizeof...(Args2), "Tuples must have the same size.");
-    return tupleDotProductHelper<sizeof...(Args1)>(t1, t2);
+template <typename T, std::size_t N, std::size_t ALIGNMENT> requires (N > detail::UNROLLED_MAX_SIZE)
+constexpr auto tupleDotProduct(const ContiguousTuple<T, N, ALIGNMENT> & t1, const ContiguousTuple<T, N, ALIGNMENT> & t2) {
+    using result_type = TupleDotProductType<ContiguousTuple<T, N, ALIGNMENT>, ContiguousTuple<T, N, ALIGNMENT>>;
+    return detail::sumComponents<N, result_type>([&](std::size_t i){
+        return tupleElementCast<result_type>(t1.values[i]) * tupleElementCast<result_type>(t2.values[i]);
+    });
 }
 
-#endif
+#endif // VECTOR_TUPLE_HELPERS_HPP
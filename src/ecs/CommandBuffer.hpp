@@ -0,0 +1,265 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SlotMap.hpp"
+
+// Records inserts and erases on a slot map handing out its own keys while it is being
+// iterated and applies them later in one batch (see WorldCommandBuffer for worlds). A buffer is not thread safe: give every thread its own
+// (e.g. indexed by juan::ThreadPool::threadIndex()) and flush them together.
+template <typename MAP>
+class CommandBuffer {
+public:
+    using map_type = MAP;
+    using key_type = typename MAP::key_type;
+    using value_type = typename MAP::value_type;
+
+    void insert(const value_type & element) {
+        m_inserts.push_back(element);
+    }
+
+    void insert(value_type && element) {
+        m_inserts.push_back(std::move(element));
+    }
+
+    // Erasing the same key several times, or a key that is already gone, is harmless
+    void erase(const key_type & key) {
+        m_erases.push_back(key);
+    }
+
+    [[nodiscard]] std::size_t insertCount() const noexcept {
+        return m_inserts.size();
+    }
+
+    [[nodiscard]] std::size_t eraseCount() const noexcept {
+        return m_erases.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_inserts.empty() && m_erases.empty();
+    }
+
+    // Drops the recorded commands, keeping the capacity for the next pass
+    void clear() noexcept {
+        m_inserts.clear();
+        m_erases.clear();
+    }
+
+    // Applies the erases and then the inserts, appending the new keys in insertion order
+    void flush(map_type & map, std::vector<key_type> * inserted_keys = nullptr) {
+        CommandBuffer * self = this;
+        flushAll(map, std::span<CommandBuffer>(self, 1), inserted_keys);
+    }
+
+    // Flushes several buffers at once: all the erases, then all the inserts buffer by buffer,
+    // with the map capacity reserved once for the whole batch
+    static void flushAll(map_type & map, std::span<CommandBuffer> buffers, std::vector<key_type> * inserted_keys = nullptr) {
+        std::size_t inserts = 0;
+        for(auto & buffer : buffers)
+        {
+            for(const auto & key : buffer.m_erases)
+            {
+                map.erase(key);
+            }
+            inserts += buffer.m_inserts.size();
+        }
+
+        map.reserve(map.size() + inserts);
+        if(inserted_keys != nullptr)
+        {
+            inserted_keys->reserve(inserted_keys->size() + inserts);
+        }
+        for(auto & buffer : buffers)
+        {
+            for(auto & element : buffer.m_inserts)
+            {
+                const auto key = map.insert(std::move(element));
+                if(inserted_keys != nullptr)
+                {
+                    inserted_keys->push_back(key);
+                }
+            }
+            buffer.clear();
+        }
+    }
+
+private:
+    std::vector<value_type> m_inserts;
+    std::vector<key_type> m_erases;
+};
+
+template <typename WORLD>
+class WorldCommandBuffer;
+
+// Records the structural changes of a SlotMap world (create, emplace, destroy) while it
+// is being iterated and applies them later in one batch. Entities created by the buffer
+// get their keys at the flush, until then they are referred to by a PendingEntity.
+// A buffer is not thread safe, like CommandBuffer.
+template <typename... MAPS>
+class WorldCommandBuffer<SlotMap<MAPS...>> {
+public:
+    using world_type = SlotMap<MAPS...>;
+    using key_type = typename world_type::key_type;
+
+    // Entity created by the next flush, only meaningful to the buffer that returned it
+    struct PendingEntity {
+        std::size_t index;
+    };
+
+    [[nodiscard]] PendingEntity create() noexcept {
+        return {m_create_count++};
+    }
+
+    // Destroying the same key several times, or a key that is already stale, is harmless
+    void destroy(const key_type & key) {
+        m_destroys.push_back(key);
+    }
+
+    // The entity must not have a component of this type yet. Components of entities
+    // that are stale by the time of the flush are dropped.
+    template <typename T, typename... ARGS>
+    void emplace(const key_type & key, ARGS&&... args) {
+        components<T>().existing.emplace_back(key, T(std::forward<ARGS>(args)...));
+    }
+
+    template <typename T, typename... ARGS>
+    void emplace(PendingEntity entity, ARGS&&... args) {
+        assert(entity.index < m_create_count);
+        components<T>().created.emplace_back(entity.index, T(std::forward<ARGS>(args)...));
+    }
+
+    template <typename VALUE>
+    void insert(const key_type & key, VALUE && value) {
+        emplace<std::remove_cvref_t<VALUE>>(key, std::forward<VALUE>(value));
+    }
+
+    template <typename VALUE>
+    void insert(PendingEntity entity, VALUE && value) {
+        emplace<std::remove_cvref_t<VALUE>>(entity, std::forward<VALUE>(value));
+    }
+
+    [[nodiscard]] std::size_t createCount() const noexcept {
+        return m_create_count;
+    }
+
+    [[nodiscard]] std::size_t destroyCount() const noexcept {
+        return m_destroys.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return m_create_count == 0 && m_destroys.empty()
+            && std::apply([](const auto & ... lists){ return (lists.empty() && ...); }, m_components);
+    }
+
+    // Drops the recorded commands, keeping the capacity for the next pass
+    void clear() noexcept {
+        m_create_count = 0;
+        m_destroys.clear();
+        std::apply([](auto & ... lists){ (lists.clear(), ...); }, m_components);
+    }
+
+    // Applies the destroys, then the creates and the components, appending the keys of
+    // the created entities in creation order
+    void flush(world_type & world, std::vector<key_type> * created_keys = nullptr) {
+        WorldCommandBuffer * self = this;
+        flushAll(world, std::span<WorldCommandBuffer>(self, 1), created_keys);
+    }
+
+    // Flushes several buffers at once: all the destroys, then the entities and components
+    // of every buffer in turn, with the capacity of every map reserved once for the batch
+    static void flushAll(world_type & world, std::span<WorldCommandBuffer> buffers, std::vector<key_type> * created_keys = nullptr) {
+        std::size_t creates = 0;
+        for(auto & buffer : buffers)
+        {
+            for(const auto & key : buffer.m_destroys)
+            {
+                world.destroy(key);
+            }
+            creates += buffer.m_create_count;
+        }
+
+        (reserve<typename MAPS::value_type>(world, buffers), ...);
+        if(created_keys != nullptr)
+        {
+            created_keys->reserve(created_keys->size() + creates);
+        }
+        for(auto & buffer : buffers)
+        {
+            buffer.m_created_keys.clear();
+            for(std::size_t i = 0; i < buffer.m_create_count; ++i)
+            {
+                buffer.m_created_keys.push_back(world.create());
+            }
+            if(created_keys != nullptr)
+            {
+                created_keys->insert(created_keys->end(), buffer.m_created_keys.begin(), buffer.m_created_keys.end());
+            }
+            (buffer.template apply<typename MAPS::value_type>(world), ...);
+            buffer.clear();
+        }
+    }
+
+private:
+    template <typename T>
+    struct Components {
+        std::vector<std::pair<key_type, T>> existing;
+        // Index of the PendingEntity and value
+        std::vector<std::pair<std::size_t, T>> created;
+
+        [[nodiscard]] bool empty() const noexcept {
+            return existing.empty() && created.empty();
+        }
+
+        void clear() noexcept {
+            existing.clear();
+            created.clear();
+        }
+    };
+
+    template <typename T>
+    [[nodiscard]] Components<T> & components() noexcept {
+        return std::get<Components<T>>(m_components);
+    }
+
+    template <typename T>
+    static void reserve(world_type & world, std::span<WorldCommandBuffer> buffers) {
+        std::size_t count = 0;
+        for(auto & buffer : buffers)
+        {
+            count += buffer.template components<T>().existing.size() + buffer.template components<T>().created.size();
+        }
+        auto & map = world.template get<T>();
+        map.reserve(map.size() + count);
+    }
+
+    template <typename T>
+    void apply(world_type & world) {
+        auto & list = components<T>();
+        for(auto & [key, value] : list.existing)
+        {
+            if(world.contains(key))
+            {
+                world.insert(key, std::move(value));
+            }
+        }
+        for(auto & [index, value] : list.created)
+        {
+            world.insert(m_created_keys[index], std::move(value));
+        }
+    }
+
+    std::size_t m_create_count = 0;
+    std::vector<key_type> m_destroys;
+    std::tuple<Components<typename MAPS::value_type>...> m_components;
+    // Keys of the entities created by the current flush
+    std::vector<key_type> m_created_keys;
+};
+
+#endif // COMMAND_BUFFER_HPP
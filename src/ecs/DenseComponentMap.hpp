@@ -0,0 +1,196 @@
+#ifndef DENSE_COMPONENT_MAP_HPP
+#define DENSE_COMPONENT_MAP_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "KeyAllocator.hpp"
+
+// Densely packed values stored under keys handed out elsewhere, by the KeyAllocator
+// of a SlotMap world, so that several maps share the keys of the same entities.
+// Unlike DenseSlotMap it never hands out keys itself, so the two cannot be mixed up.
+// A sparse table maps key indices to value positions, and a key is present when the
+// value at its position was stored under that very key. The generations of the keys
+// are checked by that comparison, so clear() does not touch the table.
+template <typename VALUE_TYPE, typename KEY_TYPE = EntityKey, typename ALLOCATOR = std::allocator<VALUE_TYPE>>
+class DenseComponentMap {
+    template <typename T>
+    using rebind_allocator = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<T>;
+
+public:
+    using value_type = VALUE_TYPE;
+    using key_type = KEY_TYPE;
+    using index_type = decltype(key_type::index);
+    using allocator_type = ALLOCATOR;
+    using iterator = typename std::vector<value_type, allocator_type>::iterator;
+    using const_iterator = typename std::vector<value_type, allocator_type>::const_iterator;
+
+    constexpr DenseComponentMap() = default;
+
+    constexpr explicit DenseComponentMap(const allocator_type & allocator) :
+        m_values(allocator),
+        m_value_keys(rebind_allocator<key_type>(allocator)),
+        m_positions(rebind_allocator<index_type>(allocator)) {
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept {
+        return m_values.size();
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return m_values.empty();
+    }
+
+    constexpr void reserve(std::size_t count) {
+        m_values.reserve(count);
+        m_value_keys.reserve(count);
+        m_positions.reserve(count);
+    }
+
+    [[nodiscard]] constexpr bool contains(const key_type & key) const noexcept {
+        return key.index < m_positions.size()
+            && m_positions[key.index] < m_values.size()
+            && m_value_keys[m_positions[key.index]] == key;
+    }
+
+    [[nodiscard]] constexpr value_type & get(const key_type & key) noexcept {
+        assert(contains(key));
+        return m_values[m_positions[key.index]];
+    }
+
+    [[nodiscard]] constexpr const value_type & get(const key_type & key) const noexcept {
+        assert(contains(key));
+        return m_values[m_positions[key.index]];
+    }
+
+    [[nodiscard]] constexpr value_type * find(const key_type & key) noexcept {
+        return contains(key) ? &m_values[m_positions[key.index]] : nullptr;
+    }
+
+    [[nodiscard]] constexpr const value_type * find(const key_type & key) const noexcept {
+        return contains(key) ? &m_values[m_positions[key.index]] : nullptr;
+    }
+
+    // Checks the given position of the dense array before doing the table lookup, maps
+    // filled in the same order keep their values at the same positions for the same key
+    [[nodiscard]] constexpr value_type * find(const key_type & key, std::size_t position_hint) noexcept {
+        if(position_hint < m_values.size() && m_value_keys[position_hint] == key)
+        {
+            return &m_values[position_hint];
+        }
+        return find(key);
+    }
+
+    constexpr value_type & insert(const key_type & key, value_type && element) {
+        return emplace_at(key, std::move(element));
+    }
+
+    constexpr value_type & insert(const key_type & key, const value_type & element) {
+        return emplace_at(key, element);
+    }
+
+    // No value may be stored under the index of the key. If constructing the value
+    // throws, the map is left unchanged.
+    template <typename... ARGS>
+    constexpr value_type & emplace_at(const key_type & key, ARGS&&... args) {
+        if(key.index >= m_positions.size())
+        {
+            m_positions.resize(static_cast<std::size_t>(key.index) + 1, 0);
+        }
+        assert(!occupied(key.index));
+        m_values.emplace_back(std::forward<ARGS>(args)...);
+        try
+        {
+            m_value_keys.push_back(key);
+        }
+        catch(...)
+        {
+            m_values.pop_back();
+            throw;
+        }
+        m_positions[key.index] = static_cast<index_type>(m_values.size() - 1);
+        return m_values.back();
+    }
+
+    // Moves the last value into the erased position. Returns false for absent keys.
+    constexpr bool erase(const key_type & key) noexcept(std::is_nothrow_move_assignable_v<value_type>) {
+        if(!contains(key))
+        {
+            return false;
+        }
+
+        const auto position = m_positions[key.index];
+        const auto last = m_values.size() - 1;
+        if(position != last)
+        {
+            m_values[position] = std::move(m_values[last]);
+            m_value_keys[position] = m_value_keys[last];
+            m_positions[m_value_keys[position].index] = position;
+        }
+        m_values.pop_back();
+        m_value_keys.pop_back();
+        return true;
+    }
+
+    // Key of the value stored at the given position of the dense array
+    [[nodiscard]] constexpr key_type keyAt(std::size_t position) const noexcept {
+        assert(position < m_values.size());
+        return m_value_keys[position];
+    }
+
+    [[nodiscard]] constexpr value_type * data() noexcept {
+        return m_values.data();
+    }
+
+    [[nodiscard]] constexpr const value_type * data() const noexcept {
+        return m_values.data();
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return m_values.begin();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return m_values.end();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return m_values.begin();
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return m_values.end();
+    }
+
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept {
+        return m_values.cbegin();
+    }
+
+    [[nodiscard]] constexpr const_iterator cend() const noexcept {
+        return m_values.cend();
+    }
+
+    // Destroys the values, the table is left as is since no key matches an empty map.
+    // Constant time for trivially destructible values.
+    constexpr void clear() noexcept {
+        m_values.clear();
+        m_value_keys.clear();
+    }
+
+private:
+    [[nodiscard]] constexpr bool occupied(index_type index) const noexcept {
+        return m_positions[index] < m_values.size() && m_value_keys[m_positions[index]].index == index;
+    }
+
+    std::vector<value_type, allocator_type> m_values;
+    // Key of every value, so iterating keys is as contiguous as iterating values
+    std::vector<key_type, rebind_allocator<key_type>> m_value_keys;
+    // Position in m_values for every key index, meaningful only if m_value_keys agrees
+    std::vector<index_type, rebind_allocator<index_type>> m_positions;
+};
+
+#endif // DENSE_COMPONENT_MAP_HPP
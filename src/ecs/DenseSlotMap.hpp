@@ -0,0 +1,233 @@
+#ifndef DENSE_SLOT_MAP_HPP
+#define DENSE_SLOT_MAP_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "KeyAllocator.hpp"
+
+// Slot map with densely packed values.
+// Values live contiguously in insertion order (modulo swap-and-pop on erase), a
+// sparse slot table maps key indices to value positions, and every slot carries
+// a generation so keys to erased values are detected instead of aliasing the new
+// occupant. A slot is occupied when its generation is odd. The map hands out its own
+// keys, the components of a SlotMap world are stored in DenseComponentMap instead.
+template <typename VALUE_TYPE, typename INDEX_TYPE = std::uint32_t, typename ALLOCATOR = std::allocator<VALUE_TYPE>>
+class DenseSlotMap {
+    template <typename T>
+    using rebind_allocator = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<T>;
+
+public:
+    using value_type = VALUE_TYPE;
+    using index_type = INDEX_TYPE;
+    using allocator_type = ALLOCATOR;
+    using iterator = typename std::vector<value_type, allocator_type>::iterator;
+    using const_iterator = typename std::vector<value_type, allocator_type>::const_iterator;
+
+    using key_type = SlotMapKey<index_type>;
+
+    constexpr DenseSlotMap() = default;
+
+    constexpr explicit DenseSlotMap(const allocator_type & allocator) :
+        m_values(allocator),
+        m_value_keys(rebind_allocator<key_type>(allocator)),
+        m_slots(rebind_allocator<Slot>(allocator)) {
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept {
+        return m_values.size();
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return m_values.empty();
+    }
+
+    constexpr void reserve(std::size_t count) {
+        m_values.reserve(count);
+        m_value_keys.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    [[nodiscard]] constexpr bool contains(const key_type & key) const noexcept {
+        return key.index < m_slots.size()
+            && m_slots[key.index].generation == key.generation
+            && (key.generation & 1) != 0;
+    }
+
+    [[nodiscard]] constexpr value_type & get(const key_type & key) noexcept {
+        assert(contains(key));
+        return m_values[m_slots[key.index].position];
+    }
+
+    [[nodiscard]] constexpr const value_type & get(const key_type & key) const noexcept {
+        assert(contains(key));
+        return m_values[m_slots[key.index].position];
+    }
+
+    [[nodiscard]] constexpr value_type * find(const key_type & key) noexcept {
+        return contains(key) ? &m_values[m_slots[key.index].position] : nullptr;
+    }
+
+    [[nodiscard]] constexpr const value_type * find(const key_type & key) const noexcept {
+        return contains(key) ? &m_values[m_slots[key.index].position] : nullptr;
+    }
+
+    // Checks the given position of the dense array before doing the slot lookup, maps
+    // filled in the same order keep their values at the same positions for the same key
+    [[nodiscard]] constexpr value_type * find(const key_type & key, std::size_t position_hint) noexcept {
+        if(position_hint < m_values.size() && m_value_keys[position_hint] == key)
+        {
+            return &m_values[position_hint];
+        }
+        return find(key);
+    }
+
+    [[nodiscard]] constexpr key_type insert(value_type && element) {
+        return emplace(std::move(element));
+    }
+
+    [[nodiscard]] constexpr key_type insert(const value_type & element) {
+        return emplace(element);
+    }
+
+    // If constructing the value throws, the map is left unchanged
+    template <typename... ARGS>
+    [[nodiscard]] constexpr key_type emplace(ARGS&&... args) {
+        reserveFreeSlot();
+        const index_type index = m_free_head;
+        const index_type next_free = m_slots[index].position;
+        store({index, static_cast<index_type>(m_slots[index].generation + 1)}, std::forward<ARGS>(args)...);
+        m_free_head = next_free;
+        return m_value_keys.back();
+    }
+
+    // Moves the last value into the erased position. Returns false for stale keys.
+    constexpr bool erase(const key_type & key) noexcept(std::is_nothrow_move_assignable_v<value_type>) {
+        if(!contains(key))
+        {
+            return false;
+        }
+
+        auto & slot = m_slots[key.index];
+        const auto position = slot.position;
+        const auto last = m_values.size() - 1;
+        if(position != last)
+        {
+            m_values[position] = std::move(m_values[last]);
+            m_value_keys[position] = m_value_keys[last];
+            m_slots[m_value_keys[position].index].position = position;
+        }
+        m_values.pop_back();
+        m_value_keys.pop_back();
+
+        releaseSlot(key.index);
+        return true;
+    }
+
+    // Key of the value stored at the given position of the dense array
+    [[nodiscard]] constexpr key_type keyAt(std::size_t position) const noexcept {
+        assert(position < m_values.size());
+        return m_value_keys[position];
+    }
+
+    [[nodiscard]] constexpr value_type * data() noexcept {
+        return m_values.data();
+    }
+
+    [[nodiscard]] constexpr const value_type * data() const noexcept {
+        return m_values.data();
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return m_values.begin();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return m_values.end();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return m_values.begin();
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return m_values.end();
+    }
+
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept {
+        return m_values.cbegin();
+    }
+
+    [[nodiscard]] constexpr const_iterator cend() const noexcept {
+        return m_values.cend();
+    }
+
+    // Invalidates every outstanding key, the slot table is kept for reuse
+    constexpr void clear() noexcept {
+        for(const auto & key : m_value_keys)
+        {
+            releaseSlot(key.index);
+        }
+        m_values.clear();
+        m_value_keys.clear();
+    }
+
+private:
+    static constexpr index_type NO_SLOT = std::numeric_limits<index_type>::max();
+
+    struct Slot {
+        // Position in m_values when occupied, next free slot otherwise
+        index_type position;
+        index_type generation;
+    };
+
+    // Appends the value and its key and points the slot of the key at them
+    template <typename... ARGS>
+    constexpr void store(const key_type & key, ARGS&&... args) {
+        m_values.emplace_back(std::forward<ARGS>(args)...);
+        try
+        {
+            m_value_keys.push_back(key);
+        }
+        catch(...)
+        {
+            m_values.pop_back();
+            throw;
+        }
+
+        // Nothing below throws, the slot is only taken once the value is stored
+        auto & slot = m_slots[key.index];
+        slot.position = static_cast<index_type>(m_values.size() - 1);
+        slot.generation = key.generation;
+    }
+
+    // Makes sure the free list is not empty, a new slot starts free
+    constexpr void reserveFreeSlot() {
+        if(m_free_head == NO_SLOT)
+        {
+            assert(m_slots.size() < NO_SLOT);
+            m_slots.push_back({NO_SLOT, 0});
+            m_free_head = static_cast<index_type>(m_slots.size() - 1);
+        }
+    }
+
+    constexpr void releaseSlot(index_type index) noexcept {
+        auto & slot = m_slots[index];
+        ++slot.generation;
+        slot.position = m_free_head;
+        m_free_head = index;
+    }
+
+    std::vector<value_type, allocator_type> m_values;
+    // Key of every value, so iterating keys is as contiguous as iterating values
+    std::vector<key_type, rebind_allocator<key_type>> m_value_keys;
+    std::vector<Slot, rebind_allocator<Slot>> m_slots;
+    index_type m_free_head = NO_SLOT;
+};
+
+#endif // DENSE_SLOT_MAP_HPP
@@ -0,0 +1,149 @@
+#ifndef KEY_ALLOCATOR_HPP
+#define KEY_ALLOCATOR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Key handed out by DenseSlotMap
+template <typename INDEX_TYPE>
+struct SlotMapKey {
+    INDEX_TYPE index;
+    INDEX_TYPE generation;
+
+    [[nodiscard]] constexpr bool operator==(const SlotMapKey &) const noexcept = default;
+};
+
+template <typename INDEX_TYPE>
+struct std::hash<SlotMapKey<INDEX_TYPE>> {
+    [[nodiscard]] std::size_t operator()(const SlotMapKey<INDEX_TYPE> & key) const noexcept {
+        const std::size_t index = key.index;
+        const std::size_t generation = key.generation;
+        return index ^ (generation << (sizeof(std::size_t) * 4));
+    }
+};
+
+// Key handed out by KeyAllocator, the epoch is the number of clears before its creation
+template <typename INDEX_TYPE>
+struct WorldKey {
+    INDEX_TYPE index;
+    INDEX_TYPE generation;
+    INDEX_TYPE epoch;
+
+    [[nodiscard]] constexpr bool operator==(const WorldKey &) const noexcept = default;
+};
+
+template <typename INDEX_TYPE>
+struct std::hash<WorldKey<INDEX_TYPE>> {
+    [[nodiscard]] std::size_t operator()(const WorldKey<INDEX_TYPE> & key) const noexcept {
+        const std::size_t index = key.index;
+        const std::size_t generation = key.generation ^ (static_cast<std::size_t>(key.epoch) << 1);
+        return index ^ (generation << (sizeof(std::size_t) * 4));
+    }
+};
+
+// Key of the entities of a SlotMap world
+using EntityKey = WorldKey<std::uint32_t>;
+
+// Hands out the keys of the entities of a world, with the generations of DenseSlotMap:
+// a slot is in use when its generation is odd and destroying a key bumps it, so stale
+// keys are rejected and only handed out again once the generation wraps around.
+// clear() takes constant time: it starts a new epoch, which every key records, and
+// forgets the slots. They are handed out again in index order, starting over from
+// generation 1, and keys of older epochs are rejected. Epochs wrap around after
+// 2^32 clears with the default index type.
+template <typename INDEX_TYPE = std::uint32_t, typename ALLOCATOR = std::allocator<INDEX_TYPE>>
+class KeyAllocator {
+    template <typename T>
+    using rebind_allocator = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<T>;
+
+public:
+    using index_type = INDEX_TYPE;
+    using key_type = WorldKey<index_type>;
+    using allocator_type = ALLOCATOR;
+
+    constexpr KeyAllocator() = default;
+
+    constexpr explicit KeyAllocator(const allocator_type & allocator) :
+        m_slots(rebind_allocator<Slot>(allocator)) {
+    }
+
+    // Number of live keys
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // Slots at or above m_used were not handed out in this epoch, whatever their generation
+    [[nodiscard]] constexpr bool contains(const key_type & key) const noexcept {
+        return key.epoch == m_epoch
+            && key.index < m_used
+            && m_slots[key.index].generation == key.generation
+            && (key.generation & 1) != 0;
+    }
+
+    [[nodiscard]] constexpr key_type create() {
+        if(m_free_head == NO_SLOT)
+        {
+            if(m_used == m_slots.size())
+            {
+                assert(m_slots.size() < NO_SLOT);
+                m_slots.emplace_back();
+            }
+            m_slots[m_used] = {NO_SLOT, 0};
+            m_free_head = m_used++;
+        }
+        const index_type index = m_free_head;
+        auto & slot = m_slots[index];
+        m_free_head = slot.next_free;
+        ++slot.generation;
+        ++m_size;
+        return {index, slot.generation, m_epoch};
+    }
+
+    // Returns false for stale keys
+    constexpr bool destroy(const key_type & key) noexcept {
+        if(!contains(key))
+        {
+            return false;
+        }
+        release(key.index);
+        --m_size;
+        return true;
+    }
+
+    // Invalidates every key in constant time, the slots keep their memory
+    constexpr void clear() noexcept {
+        ++m_epoch;
+        m_used = 0;
+        m_free_head = NO_SLOT;
+        m_size = 0;
+    }
+
+private:
+    static constexpr index_type NO_SLOT = std::numeric_limits<index_type>::max();
+
+    struct Slot {
+        index_type next_free;
+        index_type generation;
+    };
+
+    constexpr void release(index_type index) noexcept {
+        auto & slot = m_slots[index];
+        ++slot.generation;
+        slot.next_free = m_free_head;
+        m_free_head = index;
+    }
+
+    std::vector<Slot, rebind_allocator<Slot>> m_slots;
+    index_type m_free_head = NO_SLOT;
+    // Number of slots handed out in the current epoch, the others are free
+    index_type m_used = 0;
+    index_type m_epoch = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // KEY_ALLOCATOR_HPP
@@ -0,0 +1,60 @@
+#ifndef PARALLEL_FOR_EACH_HPP
+#define PARALLEL_FOR_EACH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../ThreadPool.hpp"
+
+// Parallel loops over the dense storage of a slot map (DenseSlotMap).
+// The values are split in chunks of grain consecutive elements, one task per chunk.
+
+inline constexpr std::size_t PARALLEL_FOR_EACH_GRAIN = 4096;
+
+template <typename MAP>
+concept DenseStorage = requires (MAP & map) {
+    map.data();
+    map.keyAt(std::size_t{});
+    map.size();
+};
+
+// Calls function(value) or function(key, value) for every value of the map.
+// The map must not be modified structurally while the loop runs.
+template <DenseStorage MAP, typename FUNCTION>
+void parallelForEach(juan::ThreadPool & pool, MAP & map, FUNCTION && function, std::size_t grain = PARALLEL_FOR_EACH_GRAIN)
+{
+    auto * values = map.data();
+    pool.parallelFor(map.size(), grain, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            if constexpr (std::is_invocable_v<FUNCTION &, decltype(map.keyAt(i)), decltype(values[i])>)
+            {
+                function(map.keyAt(i), values[i]);
+            }
+            else
+            {
+                function(values[i]);
+            }
+        }
+    });
+}
+
+// reduce(..., reduce(reduce(identity, transform(v0)), transform(v1)) ...) computed per chunk,
+// chunk results are then combined with reduce as well. With Reduction::Deterministic the
+// result does not depend on the number of threads or on scheduling.
+template <DenseStorage MAP, typename T, typename TRANSFORM, typename REDUCE>
+[[nodiscard]] T parallelReduce(juan::ThreadPool & pool, const MAP & map, T identity, TRANSFORM && transform, REDUCE && reduce,
+    juan::Reduction mode = juan::Reduction::Deterministic, std::size_t grain = PARALLEL_FOR_EACH_GRAIN)
+{
+    const auto * values = map.data();
+    return pool.parallelReduce(map.size(), grain, identity, [&](std::size_t begin, std::size_t end){
+        T accumulated = identity;
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            accumulated = reduce(std::move(accumulated), transform(values[i]));
+        }
+        return accumulated;
+    }, reduce, mode);
+}
+
+#endif // PARALLEL_FOR_EACH_HPP
@@ -0,0 +1,240 @@
+#ifndef SLOTMAP_HPP
+#define SLOTMAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "DenseComponentMap.hpp"
+#include "DenseSlotMap.hpp"
+#include "KeyAllocator.hpp"
+#include "UnorderedMapSlotMap.hpp"
+
+// One map per component type. Every SlotMap instance is an independent world
+// owning its own storage, so several of them can be used from different threads.
+// The world hands out the keys of its entities and the components of an entity are
+// stored under its key in every map (see create and insert), so the maps take their
+// keys from the world: DenseComponentMap, or UnorderedMapSlotMap keyed by EntityKey.
+template <typename... MAPS>
+class SlotMap {
+    using tuple_type = std::tuple<MAPS...>;
+    using key_allocator_type = KeyAllocator<std::uint32_t, std::pmr::polymorphic_allocator<std::uint32_t>>;
+    tuple_type m_data;
+    key_allocator_type m_keys;
+
+    static_assert((std::is_same_v<typename MAPS::key_type, typename key_allocator_type::key_type> && ...), "The maps must be keyed by the world");
+
+    static constexpr bool supports_arena = (std::is_constructible_v<MAPS, std::pmr::polymorphic_allocator<std::byte>> && ...);
+
+    template<typename T, std::size_t I = 0>
+    [[nodiscard]] consteval static std::size_t index() noexcept
+    {
+        using slotmap_type = std::tuple_element_t<I, tuple_type>;
+        using element_type = typename slotmap_type::value_type;
+
+        if constexpr (std::is_same_v<T, element_type>)
+        {
+            return I;
+        }
+        else if constexpr(I + 1 != std::tuple_size_v<tuple_type>)
+        {
+            return index<T, I + 1>();
+        }
+        else
+        {
+            static_assert(std::is_same_v<T, element_type>, "Type not found");
+            return I;
+        }
+    }
+
+    template<std::size_t DRIVER, typename... TYPES, typename FUNCTION>
+    constexpr void eachDrivenBy(FUNCTION & function)
+    {
+        using driver_type = std::tuple_element_t<DRIVER, std::tuple<TYPES...>>;
+
+        auto & driver = get<driver_type>();
+        auto visit = [&]<std::size_t... Is>(const key_type & key, driver_type & value, std::size_t position, std::index_sequence<Is...>)
+        {
+            const std::tuple<TYPES *...> components{probe<Is == DRIVER, TYPES>(key, value, position)...};
+            if(((std::get<Is>(components) != nullptr) && ...))
+            {
+                if constexpr (std::is_invocable_v<FUNCTION &, const key_type &, TYPES &...>)
+                {
+                    function(key, *std::get<Is>(components)...);
+                }
+                else
+                {
+                    function(*std::get<Is>(components)...);
+                }
+            }
+        };
+
+        if constexpr (requires { driver.keyAt(std::size_t{}); driver.data(); })
+        {
+            auto * values = driver.data();
+            for(std::size_t position = 0; position < driver.size(); ++position)
+            {
+                visit(driver.keyAt(position), values[position], position, std::index_sequence_for<TYPES...>());
+            }
+        }
+        else
+        {
+            std::size_t position = 0;
+            for(auto & [key, value] : driver)
+            {
+                visit(key, value, position++, std::index_sequence_for<TYPES...>());
+            }
+        }
+    }
+
+    template<bool IS_DRIVER, typename T, typename KEY, typename DRIVER_VALUE>
+    [[nodiscard]] constexpr T * probe(const KEY & key, DRIVER_VALUE & driver_value, std::size_t position) noexcept
+    {
+        if constexpr (IS_DRIVER)
+        {
+            return &driver_value;
+        }
+        else if constexpr (requires (map_type<T> & map) { map.find(key, position); })
+        {
+            return get<T>().find(key, position);
+        }
+        else
+        {
+            return get<T>().find(key);
+        }
+    }
+
+public:
+    template<typename T>
+    using map_type = std::tuple_element_t<index<T>(), tuple_type>;
+
+    using key_type = typename key_allocator_type::key_type;
+
+    SlotMap() = default;
+
+    // All the maps allocate from the arena (MonotonicArena, PoolArena, ...), which must outlive the world.
+    // The world never resets the arena, so it can be shared; reset it only once the world is destroyed.
+    template <typename ARENA> requires supports_arena && std::derived_from<ARENA, std::pmr::memory_resource>
+    explicit SlotMap(ARENA & arena) :
+        m_data{MAPS(std::pmr::polymorphic_allocator<std::byte>(&arena))...},
+        m_keys{std::pmr::polymorphic_allocator<std::uint32_t>(&arena)}
+    {
+    }
+
+    SlotMap(const SlotMap &) = delete;
+    SlotMap(SlotMap &&) noexcept = default;
+    SlotMap & operator=(const SlotMap &) = delete;
+    SlotMap & operator=(SlotMap &&) noexcept = default;
+
+    ~SlotMap() = default;
+
+    template<typename T>
+    [[nodiscard]] constexpr auto & get() noexcept
+    {
+        return std::get<index<T>()>(m_data);
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr const auto & get() const noexcept
+    {
+        return std::get<index<T>()>(m_data);
+    }
+
+    // Key of a new entity, without components
+    [[nodiscard]] constexpr key_type create()
+    {
+        return m_keys.create();
+    }
+
+    [[nodiscard]] constexpr bool contains(const key_type & key) const noexcept
+    {
+        return m_keys.contains(key);
+    }
+
+    // Number of live entities
+    [[nodiscard]] constexpr std::size_t entityCount() const noexcept
+    {
+        return m_keys.size();
+    }
+
+    // Adds a component to a live entity that has none of this type yet
+    template<typename T, typename... ARGS>
+    constexpr T & emplace(const key_type & key, ARGS&&... args)
+    {
+        assert(contains(key));
+        return get<T>().emplace_at(key, std::forward<ARGS>(args)...);
+    }
+
+    template<typename VALUE>
+    constexpr auto & insert(const key_type & key, VALUE && value)
+    {
+        return emplace<std::remove_cvref_t<VALUE>>(key, std::forward<VALUE>(value));
+    }
+
+    // Erases the components of the entity and invalidates its key. Returns false for stale keys.
+    constexpr bool destroy(const key_type & key)
+    {
+        if(!m_keys.destroy(key))
+        {
+            return false;
+        }
+        std::apply([&](auto & ... maps){ (maps.erase(key), ...); }, m_data);
+        return true;
+    }
+
+    // Calls function(components &...) for every key present in all the requested maps,
+    // or function(key, components &...) if it accepts the key. The smallest map drives
+    // the iteration and the others are probed by key.
+    template<typename... TYPES, typename FUNCTION>
+    constexpr void each(FUNCTION && function)
+    {
+        static_assert(sizeof...(TYPES) > 0, "At least one component type is needed");
+        const std::array<std::size_t, sizeof...(TYPES)> sizes{static_cast<std::size_t>(get<TYPES>().size())...};
+        const auto driver = static_cast<std::size_t>(std::min_element(sizes.begin(), sizes.end()) - sizes.begin());
+
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            ((driver == Is ? eachDrivenBy<Is, TYPES...>(function) : void()), ...);
+        }(std::index_sequence_for<TYPES...>());
+    }
+
+    // Invalidates every key of the world in constant time (see KeyAllocator), and so
+    // is clearing a DenseComponentMap of trivially destructible components. The maps
+    // keep their memory, so refilling the world up to its previous size does not allocate.
+    constexpr void clear() noexcept
+    {
+        std::apply([](auto & ... maps){ (maps.clear(), ...); }, m_data);
+        m_keys.clear();
+    }
+};
+
+// World whose components are all stored densely
+template <typename... TYPES>
+using DenseSlotMapWorld = SlotMap<DenseComponentMap<TYPES>...>;
+
+template <typename T>
+using UnorderedComponentMap = UnorderedMapSlotMap<T, EntityKey>;
+
+template <typename T>
+using PmrDenseSlotMap = DenseSlotMap<T, std::uint32_t, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using PmrUnorderedMapSlotMap = UnorderedMapSlotMap<T, std::size_t, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using PmrDenseComponentMap = DenseComponentMap<T, EntityKey, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using PmrUnorderedComponentMap = UnorderedMapSlotMap<T, EntityKey, std::pmr::polymorphic_allocator<T>>;
+
+// World allocating from an arena, see SlotMap(ARENA &)
+template <typename... TYPES>
+using PmrDenseSlotMapWorld = SlotMap<PmrDenseComponentMap<TYPES>...>;
+
+#endif
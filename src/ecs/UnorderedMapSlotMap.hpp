@@ -0,0 +1,138 @@
+#ifndef UNORDERED_MAP_SLOT_MAP
+#define UNORDERED_MAP_SLOT_MAP
+
+#include <cassert>
+#include <concepts>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <stack>
+#include <utility>
+
+template <typename VALUE_TYPE, typename KEY_TYPE = std::size_t, typename ALLOCATOR = std::allocator<VALUE_TYPE>>
+class UnorderedMapSlotMap {
+    template <typename T>
+    using rebind_allocator = typename std::allocator_traits<ALLOCATOR>::template rebind_alloc<T>;
+
+public:
+    using value_type = VALUE_TYPE;
+    using key_type = KEY_TYPE;
+    using allocator_type = ALLOCATOR;
+
+    UnorderedMapSlotMap() = default;
+
+    explicit UnorderedMapSlotMap(const allocator_type & allocator) :
+        m_data(rebind_allocator<typename map_type::value_type>(allocator)),
+        key_stack(stack_container_type(rebind_allocator<key_type>(allocator))) {
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept {
+        return m_data.size();
+    }
+
+    [[nodiscard]] constexpr value_type & get(const key_type & key) noexcept {
+        return m_data[key];
+    }
+
+    [[nodiscard]] constexpr const value_type & get(const key_type & key) const noexcept {
+        return m_data.find(key)->second;
+    }
+
+    [[nodiscard]] value_type * find(const key_type & key) noexcept {
+        auto it = m_data.find(key);
+        return it != m_data.end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] const value_type * find(const key_type & key) const noexcept {
+        auto it = m_data.find(key);
+        return it != m_data.end() ? &it->second : nullptr;
+    }
+
+    // Integral keys are handed out by the map, other keys (EntityKey) by a SlotMap world
+    [[nodiscard]] constexpr key_type insert(value_type && element) noexcept requires std::integral<key_type> {
+        auto id = nextId();
+        m_data[id] = element;
+        return id;
+    }
+
+    [[nodiscard]] constexpr key_type insert(const value_type & element) noexcept requires std::integral<key_type> {
+        auto id = nextId();
+        m_data[id] = element;
+        return id;
+    }
+
+    constexpr value_type & insert(const key_type & key, value_type && element) requires (!std::integral<key_type>) {
+        return emplace_at(key, std::move(element));
+    }
+
+    constexpr value_type & insert(const key_type & key, const value_type & element) requires (!std::integral<key_type>) {
+        return emplace_at(key, element);
+    }
+
+    // Stores a value under a key handed out elsewhere, see DenseComponentMap::emplace_at.
+    // The key must not be in use.
+    template <typename... ARGS>
+    value_type & emplace_at(const key_type & key, ARGS&&... args) requires (!std::integral<key_type>) {
+        auto [it, inserted] = m_data.try_emplace(key, std::forward<ARGS>(args)...);
+        assert(inserted);
+        return it->second;
+    }
+
+    constexpr void erase(const key_type & key) noexcept {
+        if(m_data.erase(key) != 0 && std::integral<key_type>)
+        {
+            key_stack.push(key);
+        }
+    }
+
+    void reserve(std::size_t count) {
+        m_data.reserve(count);
+    }
+
+    [[nodiscard]] constexpr auto begin() noexcept {
+        return m_data.begin();
+    }
+
+    [[nodiscard]] constexpr auto end() noexcept {
+        return m_data.end();
+    }
+
+    [[nodiscard]] constexpr auto cbegin() const noexcept {
+        return m_data.cbegin();
+    }
+
+    [[nodiscard]] constexpr auto cend() const noexcept {
+        return m_data.cend();
+    }
+
+    // Keys are not handed out again after a clear, so the old ones are never reused
+    constexpr void clear() noexcept {
+        m_data.clear();
+        while(!key_stack.empty())
+        {
+            key_stack.pop();
+        }
+    }
+
+private:
+    [[nodiscard]] constexpr key_type nextId() noexcept {
+        if (key_stack.empty()) {
+            return current_key++;
+        }
+        else {
+            auto top = key_stack.top();
+            key_stack.pop();
+            return top;
+        }
+    } 
+
+    using map_type = std::unordered_map<key_type, value_type, std::hash<key_type>, std::equal_to<key_type>,
+        rebind_allocator<std::pair<const key_type, value_type>>>;
+    using stack_container_type = std::deque<key_type, rebind_allocator<key_type>>;
+
+    map_type m_data = {};
+    key_type current_key{};
+    std::stack<key_type, stack_container_type> key_stack = {};
+};
+
+#endif
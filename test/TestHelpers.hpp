@@ -0,0 +1,46 @@
+#ifndef TEST_HELPERS_HPP
+#define TEST_HELPERS_HPP
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+// New directory in the temporary directory, removed with its content at the end of
+// the test. Its name is random and creating it fails if it exists, so concurrent runs
+// never share files and no one else can have put links in it.
+struct TemporaryDirectory
+{
+    TemporaryDirectory()
+    {
+        std::random_device random;
+        do
+        {
+            path = std::filesystem::temp_directory_path() / ("cpputils_" + std::to_string(random()));
+        }
+        while(!std::filesystem::create_directory(path));
+    }
+
+    ~TemporaryDirectory()
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+    TemporaryDirectory & operator=(const TemporaryDirectory &) = delete;
+
+    std::filesystem::path path;
+};
+
+// File in its own TemporaryDirectory
+struct TemporaryFile
+{
+    explicit TemporaryFile(const std::string & name):
+        path{directory.path / name}
+    {
+    }
+
+    TemporaryDirectory directory;
+    std::filesystem::path path;
+};
+
+#endif // TEST_HELPERS_HPP
@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/Aabb.hpp"
+
+TEST_CASE("Test Aabb Overlaps And Contains") {
+    constexpr Aabb2f box{{0.f, 0.f}, {2.f, 1.f}};
+    STATIC_REQUIRE(box.overlaps(Aabb2f{{1.f, 0.5f}, {3.f, 3.f}}));
+    // Touching boxes overlap
+    STATIC_REQUIRE(box.overlaps(Aabb2f{{2.f, 1.f}, {3.f, 3.f}}));
+    STATIC_REQUIRE(!box.overlaps(Aabb2f{{2.5f, 0.f}, {3.f, 1.f}}));
+    STATIC_REQUIRE(!box.overlaps(Aabb2f{{0.f, -2.f}, {2.f, -1.f}}));
+
+    STATIC_REQUIRE(box.contains(Aabb2f{{0.5f, 0.f}, {1.f, 1.f}}));
+    STATIC_REQUIRE(box.contains(box));
+    STATIC_REQUIRE(!box.contains(Aabb2f{{0.5f, 0.f}, {3.f, 1.f}}));
+    STATIC_REQUIRE(box.contains(Vector2<float>{2.f, 0.5f}));
+    STATIC_REQUIRE(!box.contains(Vector2<float>{2.f, 1.5f}));
+}
+
+TEST_CASE("Test Aabb Construction") {
+    constexpr Aabb3f sphere = Aabb3f::around({1.f, 2.f, 3.f}, 0.5f);
+    STATIC_REQUIRE(sphere == Aabb3f{{0.5f, 1.5f, 2.5f}, {1.5f, 2.5f, 3.5f}});
+    STATIC_REQUIRE(sphere.center() == Vector3f{1.f, 2.f, 3.f});
+    STATIC_REQUIRE(sphere.extent() == Vector3f{1.f, 1.f, 1.f});
+    STATIC_REQUIRE(sphere.halfPerimeter() == 3.f);
+    STATIC_REQUIRE(sphere.expanded(0.5f) == Aabb3f::around({1.f, 2.f, 3.f}, 1.f));
+
+    constexpr Aabb3f other{{-1.f, 2.f, 3.f}, {0.f, 4.f, 3.f}};
+    STATIC_REQUIRE(sphere.merged(other) == Aabb3f{{-1.f, 1.5f, 2.5f}, {1.5f, 4.f, 3.5f}});
+    STATIC_REQUIRE(Aabb3f::inverted().merged(other) == other);
+    STATIC_REQUIRE(!Aabb3f::inverted().overlaps(other));
+    STATIC_REQUIRE(Aabb3f::inverted().merged(Vector3f{1.f, 1.f, 1.f}) == Aabb3f{{1.f, 1.f, 1.f}, {1.f, 1.f, 1.f}});
+
+    constexpr Aabb2<int> integers{{0, 0}, {3, 4}};
+    STATIC_REQUIRE(integers.halfPerimeter() == 7);
+    STATIC_REQUIRE(integers.overlaps(Aabb2<int>{{3, 4}, {5, 5}}));
+}
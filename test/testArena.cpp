@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/Arena.hpp"
+#include "../src/ecs/SlotMap.hpp"
+
+namespace
+{
+    // Counts the calls reaching the global heap
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations = 0;
+
+    private:
+        void * do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void * pointer, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("Test MonotonicArena") {
+    CountingResource upstream;
+    MonotonicArena arena(1024, &upstream);
+
+    void * first = arena.allocate(100, 8);
+    void * second = arena.allocate(1, 64);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+    REQUIRE(second != first);
+    REQUIRE(upstream.allocations == 1);
+
+    void * big = arena.allocate(4096, 16);
+    REQUIRE(big != nullptr);
+    REQUIRE(upstream.allocations == 2);
+    REQUIRE(arena.capacity() >= 1024 + 4096);
+
+    arena.reset();
+    REQUIRE(arena.allocate(100, 8) == first);
+    REQUIRE(upstream.allocations == 2);
+}
+
+TEST_CASE("Test PoolArena") {
+    CountingResource upstream;
+    PoolArena pool(24, 4, &upstream);
+    REQUIRE(pool.blockSize() % alignof(std::max_align_t) == 0);
+
+    void * a = pool.allocate(24);
+    void * b = pool.allocate(16);
+    REQUIRE(a != b);
+    pool.deallocate(a, 24);
+    REQUIRE(pool.allocate(24) == a);
+
+    void * big = pool.allocate(1000);
+    REQUIRE(upstream.allocations == 2);
+    pool.deallocate(big, 1000);
+
+    pool.reset();
+    REQUIRE(pool.allocate(8) == a);
+    REQUIRE(upstream.allocations == 2);
+}
+
+TEST_CASE("Test SlotMap On Arena") {
+    CountingResource upstream;
+    MonotonicArena arena(1 << 16, &upstream);
+    PmrDenseSlotMapWorld<int, float> world(arena);
+
+    for(int round = 0; round < 3; ++round)
+    {
+        for(int i = 0; i < 1000; ++i)
+        {
+            const auto entity = world.create();
+            world.insert(entity, i);
+            world.insert(entity, static_cast<float>(i));
+        }
+        REQUIRE(world.get<int>().size() == 1000);
+        world.clear();
+        REQUIRE(world.get<int>().empty());
+        REQUIRE(world.get<float>().empty());
+    }
+    // Only the first round reached the upstream resource
+    const auto allocations = upstream.allocations;
+    world.insert(world.create(), 1);
+    world.clear();
+    REQUIRE(upstream.allocations == allocations);
+}
+
+TEST_CASE("Test SlotMap Clear On Arena Keeps Keys Stale") {
+    MonotonicArena arena(1 << 12);
+    SlotMap<PmrDenseComponentMap<int>, PmrUnorderedComponentMap<float>> world(arena);
+    const auto entity = world.create();
+    world.insert(entity, 1);
+    world.insert(entity, 1.f);
+    world.destroy(world.create());
+
+    // Other users of the arena keep their memory
+    void * shared = arena.allocate(64);
+    world.clear();
+    REQUIRE(arena.allocate(64) != shared);
+
+    REQUIRE(!world.contains(entity));
+    REQUIRE(!world.get<int>().contains(entity));
+    REQUIRE(world.get<float>().find(entity) == nullptr);
+    const auto new_entity = world.create();
+    world.insert(new_entity, 2);
+    world.insert(new_entity, 2.f);
+    REQUIRE(new_entity != entity);
+    REQUIRE(!world.contains(entity));
+    REQUIRE(!world.get<int>().contains(entity));
+    REQUIRE(world.get<float>().find(entity) == nullptr);
+}
+
+TEST_CASE("Test UnorderedMapSlotMap On Pool") {
+    CountingResource upstream;
+    PoolArena pool(64, 1024, &upstream);
+    PmrUnorderedMapSlotMap<int> map(&pool);
+
+    std::vector<std::size_t> keys;
+    for(int i = 0; i < 100; ++i)
+    {
+        keys.push_back(map.insert(i));
+    }
+    const auto allocations = upstream.allocations;
+    for(int round = 0; round < 10; ++round)
+    {
+        for(auto & key : keys)
+        {
+            map.erase(key);
+            key = map.insert(round);
+        }
+    }
+    REQUIRE(map.size() == 100);
+    REQUIRE(upstream.allocations == allocations);
+}
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/AabbTree.hpp"
+#include "../src/SweepAndPrune.hpp"
+
+namespace
+{
+    std::vector<Aabb3f> randomBoxes(std::size_t count, std::mt19937 & rng)
+    {
+        std::uniform_real_distribution<float> position{-20.f, 20.f};
+        std::uniform_real_distribution<float> radius{0.1f, 1.5f};
+        std::vector<Aabb3f> boxes(count);
+        for(auto & box : boxes)
+        {
+            box = Aabb3f::around({position(rng), position(rng), position(rng)}, radius(rng));
+        }
+        return boxes;
+    }
+
+    std::vector<CollisionPair> sorted(std::vector<CollisionPair> pairs)
+    {
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    // Tree whose leaves are larger than their boxes, so updates often keep them in place
+    struct FatAabbTree : AabbTree<float, 3>
+    {
+        FatAabbTree() : AabbTree<float, 3>(0.5f) {}
+    };
+}
+
+// Every broad phase against bruteForcePairs
+TEMPLATE_TEST_CASE("Test BroadPhase Pairs", "", (SweepAndPrune<float, 3>), (AabbTree<float, 3>), FatAabbTree) {
+    std::mt19937 rng{1};
+    const auto boxes = randomBoxes(2000, rng);
+    std::vector<CollisionPair> expected;
+    std::vector<CollisionPair> actual;
+
+    TestType broad_phase;
+    broad_phase.update(boxes);
+    REQUIRE(broad_phase.size() == boxes.size());
+    broad_phase.findPairs(actual);
+    bruteForcePairs<float, 3>(boxes, expected);
+    REQUIRE(!expected.empty());
+    REQUIRE(sorted(actual) == expected);
+    for(const CollisionPair pair : actual)
+    {
+        REQUIRE(pair.first < pair.second);
+    }
+
+    // Nothing, and one box
+    TestType empty;
+    empty.findPairs(actual);
+    REQUIRE(actual.empty());
+    empty.insert(5, boxes[0]);
+    empty.findPairs(actual);
+    REQUIRE(actual.empty());
+    REQUIRE(empty.contains(5));
+    REQUIRE(!empty.contains(0));
+    REQUIRE(empty.box(5) == boxes[0]);
+}
+
+TEMPLATE_TEST_CASE("Test BroadPhase Incremental Updates", "", (SweepAndPrune<float, 3>), (AabbTree<float, 3>), FatAabbTree) {
+    std::mt19937 rng{2};
+    auto boxes = randomBoxes(1000, rng);
+    TestType broad_phase;
+    broad_phase.update(boxes);
+    std::vector<CollisionPair> expected;
+    std::vector<CollisionPair> actual;
+
+    std::uniform_real_distribution<float> step{-0.3f, 0.3f};
+    for(int frame = 0; frame < 20; ++frame)
+    {
+        for(auto & box : boxes)
+        {
+            const Vector3f offset{step(rng), step(rng), step(rng)};
+            box = Aabb3f{box.min + offset, box.max + offset};
+        }
+        // Teleports, which break the order by a lot
+        if(frame % 5 == 4)
+        {
+            std::shuffle(boxes.begin(), boxes.end(), rng);
+        }
+        broad_phase.update(boxes);
+        broad_phase.findPairs(actual);
+        bruteForcePairs<float, 3>(boxes, expected);
+        REQUIRE(sorted(actual) == expected);
+    }
+}
+
+TEMPLATE_TEST_CASE("Test BroadPhase Insert And Erase", "", (SweepAndPrune<float, 3>), (AabbTree<float, 3>), FatAabbTree) {
+    std::mt19937 rng{3};
+    const auto boxes = randomBoxes(500, rng);
+    TestType broad_phase;
+    std::vector<bool> alive(boxes.size(), false);
+    std::vector<CollisionPair> expected;
+    std::vector<CollisionPair> actual;
+
+    std::uniform_int_distribution<std::uint32_t> pick{0, static_cast<std::uint32_t>(boxes.size() - 1)};
+    for(int round = 0; round < 20; ++round)
+    {
+        for(int i = 0; i < 100; ++i)
+        {
+            const std::uint32_t index = pick(rng);
+            if(alive[index])
+            {
+                broad_phase.erase(index);
+            }
+            else
+            {
+                broad_phase.insert(index, boxes[index]);
+            }
+            alive[index] = !alive[index];
+        }
+        broad_phase.findPairs(actual);
+        bruteForcePairs<float, 3>(boxes, expected);
+        std::erase_if(expected, [&](const CollisionPair pair){ return !alive[pair.first] || !alive[pair.second]; });
+        REQUIRE(sorted(actual) == expected);
+        REQUIRE(broad_phase.size() == static_cast<std::size_t>(std::count(alive.begin(), alive.end(), true)));
+        for(std::uint32_t index = 0; index < boxes.size(); ++index)
+        {
+            REQUIRE(broad_phase.contains(index) == alive[index]);
+        }
+    }
+
+    // Erased then inserted again before finding pairs
+    broad_phase.clear();
+    broad_phase.insert(0, boxes[0]);
+    broad_phase.erase(0);
+    broad_phase.insert(0, boxes[0]);
+    broad_phase.insert(1, boxes[0]);
+    broad_phase.findPairs(actual);
+    REQUIRE(actual == std::vector<CollisionPair>{{0, 1}});
+    REQUIRE(broad_phase.size() == 2);
+}
+
+TEST_CASE("Test SweepAndPrune Axes") {
+    std::mt19937 rng{1};
+    const auto boxes = randomBoxes(2000, rng);
+    std::vector<CollisionPair> expected;
+    std::vector<CollisionPair> actual;
+    bruteForcePairs<float, 3>(boxes, expected);
+
+    for(std::size_t axis = 0; axis < 3; ++axis)
+    {
+        SweepAndPrune<float, 3> broad_phase(axis);
+        broad_phase.update(boxes);
+        broad_phase.findPairs(actual);
+        REQUIRE(sorted(actual) == expected);
+    }
+}
+
+TEST_CASE("Test AabbTree Margins") {
+    std::mt19937 rng{1};
+    const auto boxes = randomBoxes(2000, rng);
+    std::vector<CollisionPair> expected;
+    std::vector<CollisionPair> actual;
+    bruteForcePairs<float, 3>(boxes, expected);
+
+    // The margin never adds pairs
+    for(const float margin : {0.f, 0.5f, 5.f})
+    {
+        AabbTree<float, 3> tree(margin);
+        tree.update(boxes);
+        tree.findPairs(actual);
+        REQUIRE(sorted(actual) == expected);
+        // Balanced
+        REQUIRE(tree.height() < 40);
+    }
+}
+
+TEST_CASE("Test AabbTree Queries") {
+    std::mt19937 rng{4};
+    const auto boxes = randomBoxes(2000, rng);
+    const auto queries = randomBoxes(50, rng);
+    AabbTree<float, 3> tree(0.25f);
+    tree.update(boxes);
+
+    std::vector<std::uint32_t> actual;
+    for(const Aabb3f & query : queries)
+    {
+        std::vector<std::uint32_t> expected;
+        for(std::uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            if(boxes[i].overlaps(query))
+            {
+                expected.push_back(i);
+            }
+        }
+        actual.clear();
+        tree.query(query, [&](std::uint32_t index){ actual.push_back(index); });
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(actual == expected);
+    }
+}
+
+TEST_CASE("Test AabbTree Fat Boxes") {
+    AabbTree<float, 2> tree(1.f);
+    tree.insert(0, Aabb2f::around({0.f, 0.f}, 1.f));
+    tree.insert(1, Aabb2f::around({3.5f, 0.f}, 1.f));
+    std::vector<CollisionPair> pairs;
+    tree.findPairs(pairs);
+    REQUIRE(pairs.empty());
+
+    // Moves within the margin keep the leaf in place
+    REQUIRE(!tree.update(0, Aabb2f::around({0.5f, 0.f}, 1.f)));
+    REQUIRE(!tree.update(0, Aabb2f::around({1.f, 0.f}, 1.f)));
+    REQUIRE(tree.box(0) == Aabb2f::around({1.f, 0.f}, 1.f));
+    // The fat boxes overlap, the boxes do not
+    tree.findPairs(pairs);
+    REQUIRE(pairs.empty());
+    REQUIRE(tree.update(0, Aabb2f::around({1.5f, 0.f}, 1.f)));
+    tree.findPairs(pairs);
+    REQUIRE(pairs == std::vector<CollisionPair>{{0, 1}});
+    REQUIRE(tree.height() == 1);
+
+    tree.erase(1);
+    tree.findPairs(pairs);
+    REQUIRE(pairs.empty());
+    REQUIRE(tree.height() == 0);
+    tree.erase(0);
+    REQUIRE(tree.empty());
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/ecs/CommandBuffer.hpp"
+#include "../src/ecs/DenseSlotMap.hpp"
+#include "../src/ecs/ParallelForEach.hpp"
+#include "../src/ecs/SlotMap.hpp"
+#include "../src/ecs/UnorderedMapSlotMap.hpp"
+
+TEST_CASE("Test CommandBuffer Flush") {
+    DenseSlotMap<int> map;
+    auto a = map.insert(1);
+    auto b = map.insert(2);
+
+    CommandBuffer<DenseSlotMap<int>> buffer;
+    for(const auto value : map)
+    {
+        buffer.insert(value * 10);
+    }
+    buffer.erase(a);
+    buffer.erase(a);
+    REQUIRE(buffer.insertCount() == 2);
+    REQUIRE(buffer.eraseCount() == 2);
+    REQUIRE(map.size() == 2);
+
+    std::vector<DenseSlotMap<int>::key_type> inserted;
+    buffer.flush(map, &inserted);
+    REQUIRE(buffer.empty());
+    REQUIRE(map.size() == 3);
+    REQUIRE(!map.contains(a));
+    REQUIRE(map.get(b) == 2);
+    REQUIRE(inserted.size() == 2);
+    REQUIRE(map.get(inserted[0]) == 10);
+    REQUIRE(map.get(inserted[1]) == 20);
+}
+
+TEST_CASE("Test CommandBuffer Unordered Map") {
+    UnorderedMapSlotMap<int> map;
+    auto a = map.insert(1);
+
+    CommandBuffer<UnorderedMapSlotMap<int>> buffer;
+    buffer.erase(a);
+    buffer.erase(a);
+    buffer.insert(2);
+    buffer.insert(3);
+    std::vector<std::size_t> inserted;
+    buffer.flush(map, &inserted);
+    REQUIRE(map.size() == 2);
+    REQUIRE(inserted.size() == 2);
+    REQUIRE(map.get(inserted[0]) == 2);
+    REQUIRE(map.get(inserted[1]) == 3);
+}
+
+TEST_CASE("Test CommandBuffer Per Thread") {
+    juan::ThreadPool pool(3);
+    DenseSlotMap<int> map;
+    for(int i = 0; i < 10'000; ++i)
+    {
+        std::ignore = map.insert(i);
+    }
+
+    std::vector<CommandBuffer<DenseSlotMap<int>>> buffers(pool.size() + 1);
+    parallelForEach(pool, map, [&](const auto & key, int value){
+        auto & buffer = buffers[pool.threadIndex()];
+        if(value % 2 == 0)
+        {
+            buffer.erase(key);
+        }
+        else
+        {
+            buffer.insert(-value);
+        }
+    }, 100);
+    CommandBuffer<DenseSlotMap<int>>::flushAll(map, buffers);
+
+    REQUIRE(map.size() == 10'000);
+    REQUIRE(std::none_of(map.begin(), map.end(), [](int value){ return value > 0 && value % 2 == 0; }));
+    REQUIRE(std::count_if(map.begin(), map.end(), [](int value){ return value < 0; }) == 5'000);
+}
+
+namespace
+{
+    struct Health
+    {
+        int points;
+    };
+
+    struct Name
+    {
+        int id;
+    };
+}
+
+TEST_CASE("Test WorldCommandBuffer Flush") {
+    using world_type = SlotMap<DenseComponentMap<Health>, UnorderedComponentMap<Name>>;
+    world_type world;
+    const auto a = world.create();
+    const auto b = world.create();
+    world.insert(a, Health{10});
+    world.insert(b, Health{20});
+
+    WorldCommandBuffer<world_type> buffer;
+    world.each<Health>([&](const EntityKey & key, const Health & health){
+        if(health.points < 15)
+        {
+            buffer.destroy(key);
+        }
+        else
+        {
+            buffer.insert(key, Name{health.points});
+        }
+    });
+    const auto spawned = buffer.create();
+    buffer.emplace<Health>(spawned, 30);
+    buffer.insert(spawned, Name{3});
+    // Dropped, a is destroyed by the same flush
+    buffer.insert(a, Name{1});
+    buffer.destroy(a);
+    REQUIRE(buffer.createCount() == 1);
+    REQUIRE(buffer.destroyCount() == 2);
+    REQUIRE(world.entityCount() == 2);
+    REQUIRE(world.get<Name>().size() == 0);
+
+    std::vector<EntityKey> created;
+    buffer.flush(world, &created);
+    REQUIRE(buffer.empty());
+    REQUIRE(created.size() == 1);
+    REQUIRE(world.entityCount() == 2);
+    REQUIRE(!world.contains(a));
+    REQUIRE(world.get<Name>().find(a) == nullptr);
+    REQUIRE(world.get<Name>().get(b).id == 20);
+    REQUIRE(world.get<Health>().get(created[0]).points == 30);
+    REQUIRE(world.get<Name>().get(created[0]).id == 3);
+}
+
+TEST_CASE("Test WorldCommandBuffer Per Thread") {
+    using world_type = DenseSlotMapWorld<Health, Name>;
+    juan::ThreadPool pool(3);
+    world_type world;
+    for(int i = 0; i < 10'000; ++i)
+    {
+        world.insert(world.create(), Health{i});
+    }
+
+    // Every even entity is destroyed and every odd one spawns a named child
+    std::vector<WorldCommandBuffer<world_type>> buffers(pool.size() + 1);
+    parallelForEach(pool, world.get<Health>(), [&](const EntityKey & key, const Health & health){
+        auto & buffer = buffers[pool.threadIndex()];
+        if(health.points % 2 == 0)
+        {
+            buffer.destroy(key);
+        }
+        else
+        {
+            const auto child = buffer.create();
+            buffer.insert(child, Health{-health.points});
+            buffer.insert(child, Name{health.points});
+        }
+    }, 100);
+    std::vector<EntityKey> created;
+    WorldCommandBuffer<world_type>::flushAll(world, buffers, &created);
+
+    REQUIRE(created.size() == 5'000);
+    REQUIRE(world.entityCount() == 10'000);
+    REQUIRE(world.get<Name>().size() == 5'000);
+    std::size_t children = 0;
+    world.each<Health, Name>([&](const Health & health, const Name & name){
+        REQUIRE(health.points == -name.id);
+        ++children;
+    });
+    REQUIRE(children == 5'000);
+    REQUIRE(std::none_of(world.get<Health>().begin(), world.get<Health>().end(), [](const Health & health){
+        return health.points >= 0 && health.points % 2 == 0;
+    }));
+}
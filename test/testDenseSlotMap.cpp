@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/ecs/DenseComponentMap.hpp"
+#include "../src/ecs/DenseSlotMap.hpp"
+#include "../src/ecs/KeyAllocator.hpp"
+
+TEST_CASE("Test DenseSlotMap Insert And Get") {
+    DenseSlotMap<std::string> map;
+    REQUIRE(map.empty());
+
+    auto a = map.insert("a");
+    auto b = map.insert(std::string("b"));
+    auto c = map.emplace(3, 'c');
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.get(a) == "a");
+    REQUIRE(map.get(b) == "b");
+    REQUIRE(map.get(c) == "ccc");
+    REQUIRE(map.contains(a));
+
+    map.get(b) = "bb";
+    const auto * found = map.find(b);
+    REQUIRE(found == &map.get(b));
+}
+
+TEST_CASE("Test DenseSlotMap Erase Keeps Values Dense") {
+    DenseSlotMap<int> map;
+    auto a = map.insert(1);
+    auto b = map.insert(2);
+    auto c = map.insert(3);
+
+    REQUIRE(map.erase(a));
+    REQUIRE(map.size() == 2);
+    REQUIRE(std::vector<int>(map.begin(), map.end()) == std::vector<int>{3, 2});
+    REQUIRE(map.get(b) == 2);
+    REQUIRE(map.get(c) == 3);
+    REQUIRE(map.keyAt(0) == c);
+    REQUIRE(map.keyAt(1) == b);
+}
+
+TEST_CASE("Test DenseSlotMap Stale Keys") {
+    DenseSlotMap<int> map;
+    auto a = map.insert(1);
+    REQUIRE(map.erase(a));
+    REQUIRE(!map.contains(a));
+    REQUIRE(map.find(a) == nullptr);
+    REQUIRE(!map.erase(a));
+
+    auto b = map.insert(2);
+    REQUIRE(b.index == a.index);
+    REQUIRE(b.generation != a.generation);
+    REQUIRE(!map.contains(a));
+    REQUIRE(map.get(b) == 2);
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(!map.contains(b));
+    auto c = map.insert(3);
+    REQUIRE(!map.contains(b));
+    REQUIRE(map.get(c) == 3);
+}
+
+TEST_CASE("Test DenseSlotMap Many Elements") {
+    DenseSlotMap<std::size_t> map;
+    std::vector<DenseSlotMap<std::size_t>::key_type> keys;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        keys.push_back(map.insert(i));
+    }
+    for(std::size_t i = 0; i < keys.size(); i += 2)
+    {
+        REQUIRE(map.erase(keys[i]));
+    }
+    REQUIRE(map.size() == 500);
+    for(std::size_t i = 1; i < keys.size(); i += 2)
+    {
+        REQUIRE(map.get(keys[i]) == i);
+    }
+    for(std::size_t position = 0; position < map.size(); ++position)
+    {
+        REQUIRE(map.get(map.keyAt(position)) == map.data()[position]);
+    }
+    REQUIRE(std::all_of(map.cbegin(), map.cend(), [](auto value){ return value % 2 == 1; }));
+}
+
+namespace
+{
+    struct ThrowingValue {
+        int value = 0;
+
+        explicit ThrowingValue(int v) : value(v) {
+            if(v < 0)
+            {
+                throw std::invalid_argument("negative");
+            }
+        }
+    };
+
+    struct ThrowingMove {
+        std::string value;
+
+        ThrowingMove() = default;
+        ThrowingMove(ThrowingMove && other) noexcept(false) : value(std::move(other.value)) {}
+        ThrowingMove & operator=(ThrowingMove && other) noexcept(false) {
+            value = std::move(other.value);
+            return *this;
+        }
+    };
+}
+
+namespace
+{
+    template <typename MAP>
+    concept HandsOutKeys = requires (MAP & map, const typename MAP::value_type & value) {
+        map.insert(value);
+        map.emplace(value);
+    };
+
+    template <typename MAP>
+    concept TakesKeys = requires (MAP & map, const typename MAP::key_type & key, const typename MAP::value_type & value) {
+        map.insert(key, value);
+        map.emplace_at(key, value);
+    };
+}
+
+TEST_CASE("Test DenseComponentMap Keys From Elsewhere") {
+    // A map either hands out its own keys or takes them from a KeyAllocator, never both
+    static_assert(HandsOutKeys<DenseSlotMap<int>> && !TakesKeys<DenseSlotMap<int>>);
+    static_assert(TakesKeys<DenseComponentMap<int>> && !HandsOutKeys<DenseComponentMap<int>>);
+
+    KeyAllocator<> keys;
+    DenseSlotMap<int> own;
+    DenseComponentMap<int> shared;
+    const auto a = keys.create();
+    const auto b = keys.create();
+    const auto c = keys.create();
+    const auto own_key = own.insert(100);
+    shared.insert(c, 3);
+    shared.insert(a, 1);
+    REQUIRE(own_key.index == a.index);
+    REQUIRE(shared.get(a) == 1);
+    REQUIRE(shared.get(c) == 3);
+    REQUIRE(!shared.contains(b));
+    REQUIRE(shared.find(b) == nullptr);
+
+    // A key that reuses the index of a destroyed one does not see its value
+    REQUIRE(shared.erase(a));
+    REQUIRE(!shared.erase(a));
+    REQUIRE(keys.destroy(a));
+    const auto d = keys.create();
+    REQUIRE(d.index == a.index);
+    REQUIRE(!shared.contains(d));
+    shared.emplace_at(d, 4);
+    REQUIRE(shared.get(d) == 4);
+    REQUIRE(!shared.contains(a));
+    REQUIRE(shared.keyAt(0) == c);
+    REQUIRE(own.get(own_key) == 100);
+
+    shared.clear();
+    REQUIRE(shared.empty());
+    REQUIRE(!shared.contains(c));
+    REQUIRE(!shared.contains(d));
+    shared.insert(b, 2);
+    REQUIRE(shared.get(b) == 2);
+    REQUIRE(!shared.contains(c));
+}
+
+TEST_CASE("Test DenseSlotMap Exception Safety") {
+    DenseSlotMap<ThrowingValue> map;
+    auto a = map.emplace(1);
+    REQUIRE_THROWS_AS(map.emplace(-1), std::invalid_argument);
+    REQUIRE(map.size() == 1);
+    REQUIRE(map.get(a).value == 1);
+
+    // The slot of a failed emplace is not leaked: it is the next one handed out
+    REQUIRE(map.erase(a));
+    REQUIRE_THROWS_AS(map.emplace(-2), std::invalid_argument);
+    REQUIRE(map.empty());
+    auto b = map.emplace(2);
+    REQUIRE(b.index == a.index);
+    REQUIRE(!map.contains(a));
+    REQUIRE(map.get(b).value == 2);
+    auto c = map.emplace(3);
+    REQUIRE(c.index != b.index);
+
+    static_assert(noexcept(std::declval<DenseSlotMap<int> &>().erase({})));
+    static_assert(!noexcept(std::declval<DenseSlotMap<ThrowingMove> &>().erase({})));
+}
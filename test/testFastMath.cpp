@@ -0,0 +1,263 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/FastMath.hpp"
+#include "../src/VectorArray.hpp"
+
+namespace
+{
+    // Distance in representable floats between value and the rounded reference
+    std::int64_t ulpError(float value, double reference)
+    {
+        const auto ordered = [](float f){
+            const auto bits = std::bit_cast<std::int32_t>(f);
+            return bits < 0 ? std::int64_t{INT32_MIN} - bits : std::int64_t{bits};
+        };
+        return std::llabs(ordered(value) - ordered(static_cast<float>(reference)));
+    }
+
+    // Every step-th float from first to last, both positive
+    template <typename FUNCTION>
+    void forEachFloat(float first, float last, std::uint32_t step, FUNCTION function)
+    {
+        for(std::uint32_t bits = std::bit_cast<std::uint32_t>(first); bits <= std::bit_cast<std::uint32_t>(last); bits += step)
+        {
+            function(std::bit_cast<float>(bits));
+        }
+    }
+
+    std::vector<float> randomFloats(std::size_t count, float low, float high, std::uint32_t seed)
+    {
+        std::mt19937 rng{seed};
+        std::uniform_real_distribution<float> distribution{low, high};
+        std::vector<float> values(count);
+        for(auto & value : values)
+        {
+            value = distribution(rng);
+        }
+        return values;
+    }
+
+    std::vector<Vector3f> randomVectors(std::size_t count, std::uint32_t seed)
+    {
+        const std::vector<float> components = randomFloats(3 * count, -10.f, 10.f, seed);
+        std::vector<Vector3f> vectors(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            vectors[i] = {components[3 * i], components[3 * i + 1], components[3 * i + 2]};
+        }
+        return vectors;
+    }
+}
+
+TEST_CASE("Test FastMath Errors") {
+    std::int64_t rsqrt = 0;
+    std::int64_t sqrt = 0;
+    forEachFloat(std::numeric_limits<float>::min(), std::numeric_limits<float>::max(), 4099, [&](float x){
+        rsqrt = std::max(rsqrt, ulpError(math::rsqrt(x), 1. / std::sqrt(static_cast<double>(x))));
+        sqrt = std::max(sqrt, ulpError(math::sqrt(x), std::sqrt(static_cast<double>(x))));
+    });
+    REQUIRE(rsqrt <= 3);
+    REQUIRE(sqrt <= 1);
+    REQUIRE(math::sqrt(0.f) == 0.f);
+
+    std::int64_t acos = 0;
+    forEachFloat(0.f, 1.f, 1021, [&](float x){
+        acos = std::max(acos, ulpError(math::acos(x), std::acos(static_cast<double>(x))));
+        acos = std::max(acos, ulpError(math::acos(-x), std::acos(-static_cast<double>(x))));
+    });
+    REQUIRE(acos <= 1);
+
+    std::int64_t sin = 0;
+    std::int64_t cos = 0;
+    forEachFloat(0.f, 64.f, 1021, [&](float x){
+        for(const float value : {x, -x})
+        {
+            sin = std::max(sin, ulpError(math::sin(value), std::sin(static_cast<double>(value))));
+            cos = std::max(cos, ulpError(math::cos(value), std::cos(static_cast<double>(value))));
+        }
+    });
+    forEachFloat(64.f, 1e6f, 10007, [&](float x){
+        sin = std::max(sin, ulpError(math::sin(x), std::sin(static_cast<double>(x))));
+        cos = std::max(cos, ulpError(math::cos(x), std::cos(static_cast<double>(x))));
+    });
+    // Next to the multiples of pi / 2, where the result is much smaller than x
+    for(int k = 1; k < 20'000; ++k)
+    {
+        const auto multiple = static_cast<float>(k * std::numbers::pi / 2.);
+        const auto bits = std::bit_cast<std::uint32_t>(multiple);
+        for(std::uint32_t neighbor = bits - 4; neighbor <= bits + 4; ++neighbor)
+        {
+            const auto x = std::bit_cast<float>(neighbor);
+            sin = std::max(sin, ulpError(math::sin(x), std::sin(static_cast<double>(x))));
+            cos = std::max(cos, ulpError(math::cos(x), std::cos(static_cast<double>(x))));
+        }
+    }
+    REQUIRE(ulpError(math::cos(4.712389f), std::cos(static_cast<double>(4.712389f))) <= 2);
+    REQUIRE(ulpError(math::sin(9.424778f), std::sin(static_cast<double>(9.424778f))) <= 2);
+    REQUIRE(sin <= 2);
+    REQUIRE(cos <= 2);
+
+    // Both small and large ratios of y and x
+    std::mt19937 rng{1};
+    std::uniform_real_distribution<float> mantissa{-1.f, 1.f};
+    std::uniform_int_distribution<int> exponent{-40, 40};
+    std::int64_t atan2 = 0;
+    for(int i = 0; i < 1'000'000; ++i)
+    {
+        const float y = std::ldexp(mantissa(rng), exponent(rng));
+        const float x = std::ldexp(mantissa(rng), exponent(rng));
+        atan2 = std::max(atan2, ulpError(math::atan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x))));
+    }
+    REQUIRE(atan2 <= 3);
+}
+
+TEST_CASE("Test FastMath Special Values") {
+    // Rounding errors of cosines do not give NaN
+    REQUIRE(math::acos(1.0001f) == 0.f);
+    REQUIRE(math::acos(-1.0001f) == std::acos(-1.f));
+    REQUIRE(math::acos(1.f) == 0.f);
+
+    // Signs of zeros like std::atan2
+    for(const float y : {0.f, -0.f})
+    {
+        for(const float x : {0.f, -0.f, 1.f, -1.f})
+        {
+            REQUIRE(math::atan2(y, x) == std::atan2(y, x));
+            REQUIRE(std::signbit(math::atan2(y, x)) == std::signbit(std::atan2(y, x)));
+        }
+    }
+    REQUIRE(math::atan2(1.f, 0.f) == std::atan2(1.f, 0.f));
+    REQUIRE(math::atan2(-1.f, -0.f) == std::atan2(-1.f, -0.f));
+
+    REQUIRE(math::sin(0.f) == 0.f);
+    REQUIRE(math::cos(0.f) == 1.f);
+    REQUIRE(std::isfinite(math::rsqrt(0.f)));
+
+    // Outside |x| <= 1e6 sin and cos are the <cmath> ones, in batches too
+    const std::vector<float> arguments{4e9f, -4e9f, 2e6f, std::numeric_limits<float>::max(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), 1.f};
+    const auto same = [](float a, float b){ return std::bit_cast<std::uint32_t>(a) == std::bit_cast<std::uint32_t>(b); };
+    std::vector<float> sines(arguments.size());
+    std::vector<float> cosines = arguments;
+    math::sin(arguments, sines);
+    math::cos(cosines, cosines);
+    for(std::size_t i = 0; i < arguments.size(); ++i)
+    {
+        const float x = arguments[i];
+        REQUIRE(same(math::sin(x), i + 1 < arguments.size() ? std::sin(x) : detail::fastSin(x)));
+        REQUIRE(same(math::cos(x), i + 1 < arguments.size() ? std::cos(x) : detail::fastCos(x)));
+        REQUIRE(same(sines[i], math::sin(x)));
+        REQUIRE(same(cosines[i], math::cos(x)));
+    }
+}
+
+TEST_CASE("Test FastMath Precision") {
+    // Precision::exact is <cmath>, and double always is
+    REQUIRE(math::acos<math::Precision::exact>(0.3f) == std::acos(0.3f));
+    REQUIRE(math::rsqrt<math::Precision::exact>(2.f) == 1.f / std::sqrt(2.f));
+    REQUIRE(math::sin<math::Precision::exact>(2.f) == std::sin(2.f));
+    REQUIRE(math::atan2(0.3, -0.2) == std::atan2(0.3, -0.2));
+    REQUIRE(math::cos(0.3) == std::cos(0.3));
+
+    // Batches give the same results as single calls, also in place
+    const std::vector<float> values = randomFloats(1000, -1.f, 1.f, 2);
+    const std::vector<float> others = randomFloats(1000, -1.f, 1.f, 3);
+    std::vector<float> out(values.size());
+    math::acos(values, out);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(out[i] == math::acos(values[i]));
+    }
+    math::atan2(values, others, out);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(out[i] == math::atan2(values[i], others[i]));
+    }
+    math::sin<math::Precision::exact>(values, out);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(out[i] == std::sin(values[i]));
+    }
+    out = values;
+    math::cos(out, out);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(out[i] == math::cos(values[i]));
+    }
+}
+
+TEST_CASE("Test FastMath Bulk Normalize And Angle") {
+    std::vector<Vector3f> vectors = randomVectors(1000, 4);
+    const std::vector<Vector3f> others = randomVectors(1000, 5);
+    // Null vectors stay null, their angles are NaN with both precisions
+    vectors[10] = Vector3f{};
+
+    // Exact is the same as the Vector functions
+    std::vector<Vector3f> exact = vectors;
+    normalizeVectors(exact);
+    std::vector<float> exact_angles(vectors.size());
+    vectorAngles(vectors, others, exact_angles);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(exact[i] == vectors[i].normalized());
+        REQUIRE((exact_angles[i] == vectors[i].angle(others[i]) || i == 10));
+    }
+    REQUIRE(std::isnan(exact_angles[10]));
+
+    std::vector<Vector3f> fast = vectors;
+    normalizeVectors<math::Precision::fast>(fast);
+    std::vector<float> fast_angles(vectors.size());
+    vectorAngles<math::Precision::fast>(vectors, others, fast_angles);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            REQUIRE(std::abs(fast[i][c] - exact[i][c]) <= 1e-6f);
+        }
+        REQUIRE((std::abs(fast_angles[i] - exact_angles[i]) <= 1e-4f || i == 10));
+    }
+    REQUIRE(fast[10] == Vector3f{});
+    REQUIRE(std::isnan(fast_angles[10]));
+    std::vector<float> swapped_angles(vectors.size());
+    vectorAngles<math::Precision::fast>(others, vectors, swapped_angles);
+    REQUIRE(std::isnan(swapped_angles[10]));
+
+    // Parallel vectors, where the cosine can round above 1
+    const std::vector<Vector3f> parallel(vectors.size(), Vector3f{0.1f, 0.2f, 0.3f});
+    std::vector<float> parallel_angles(vectors.size());
+    vectorAngles<math::Precision::fast>(parallel, parallel, parallel_angles);
+    for(const float angle : parallel_angles)
+    {
+        REQUIRE(angle >= 0.f);
+        REQUIRE(angle <= 1e-3f);
+    }
+
+    // VectorArray gives the same results as the functions on Vector
+    VectorArray3f array(vectors);
+    const VectorArray3f other_array(others);
+    std::vector<float> array_angles(vectors.size());
+    array.angle(other_array, std::span(array_angles));
+    REQUIRE(std::isnan(array_angles[10]));
+    array_angles[10] = exact_angles[10] = 0.f;
+    REQUIRE(array_angles == exact_angles);
+    array.angle<math::Precision::fast>(other_array, std::span(array_angles));
+    REQUIRE(std::isnan(array_angles[10]));
+    other_array.angle<math::Precision::fast>(array, std::span(array_angles));
+    REQUIRE(std::isnan(array_angles[10]));
+    array.angle<math::Precision::fast>(other_array, std::span(array_angles));
+    array_angles[10] = fast_angles[10] = 0.f;
+    REQUIRE(array_angles == fast_angles);
+    array.normalize<math::Precision::fast>();
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(array.get(i) == fast[i]);
+    }
+}
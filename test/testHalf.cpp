@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/Vector.hpp"
+#include "../src/Half.hpp"
+
+
+static_assert(sizeof(Half) == 2);
+static_assert(sizeof(Vector<Half, 4>) == 8);
+static_assert(Half(1.f).bits() == 0x3c00);
+static_assert(Half(-2.f).bits() == 0xc000);
+static_assert(Half(65504.f).bits() == 0x7bff);
+static_assert(static_cast<float>(Half::fromBits(0x3555)) == 0.333251953125f);
+static_assert(Vector3f(Vector<Half, 3>(Vector3f{1.f, 0.5f, -4.f})) == Vector3f{1.f, 0.5f, -4.f});
+
+TEST_CASE("Test Half Conversions") {
+    // Every half converts to a float and back to the same bits, NaNs stay NaNs
+    for(std::uint32_t bits = 0; bits <= 0xffffu; ++bits)
+    {
+        const Half half = Half::fromBits(static_cast<std::uint16_t>(bits));
+        const float value = half;
+        const bool is_nan = (bits & 0x7c00u) == 0x7c00u && (bits & 0x3ffu) != 0;
+        REQUIRE(std::isnan(value) == is_nan);
+        if(!is_nan)
+        {
+            REQUIRE(Half(value).bits() == bits);
+            REQUIRE(detail::halfBitsToFloat(static_cast<std::uint16_t>(bits)) == value);
+        }
+    }
+
+    // Round to nearest even, overflow to infinity, subnormals
+    REQUIRE(Half(1.f + 1.f / 2048.f).bits() == 0x3c00);
+    REQUIRE(Half(1.f + 3.f / 2048.f).bits() == 0x3c02);
+    REQUIRE(Half(65520.f).bits() == 0x7c00);
+    REQUIRE(Half(-std::numeric_limits<float>::infinity()).bits() == 0xfc00);
+    REQUIRE(std::isnan(static_cast<float>(Half(std::numeric_limits<float>::quiet_NaN()))));
+    REQUIRE(Half(std::ldexp(1.f, -24)).bits() == 0x0001);
+    REQUIRE(Half(std::ldexp(1.f, -26)).bits() == 0x0000);
+    REQUIRE(Half(-0.f).bits() == 0x8000);
+    REQUIRE(detail::floatToHalfBits(std::ldexp(1.f, -24)) == 0x0001);
+    REQUIRE(detail::floatToHalfBits(65520.f) == 0x7c00);
+}
+
+TEST_CASE("Test Half Vector Conversions") {
+    std::vector<Vector3f> vectors(37);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        const float value = static_cast<float>(i) * 0.37f - 5.f;
+        vectors[i] = {value, value * value, -value / 3.f};
+    }
+
+    std::vector<Vector<Half, 3>> halves(vectors.size());
+    convertVectors(vectors, halves);
+    std::vector<Vector3f> back(vectors.size());
+    convertVectors(halves, back);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        const Vector<Half, 3> half(vectors[i]);
+        const Vector3f expected(half);
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            REQUIRE(halves[i][c].bits() == half[c].bits());
+            REQUIRE(back[i][c] == expected[c]);
+            // 11 significant bits
+            REQUIRE(std::abs(back[i][c] - vectors[i][c]) <= std::abs(vectors[i][c]) / 2048.f);
+        }
+    }
+
+    // Padding free vectors are converted as one run of components
+    std::vector<Vector<float, 5>> wide(7, Vector<float, 5>{1.f, 2.f, 3.f, 4.f, 5.f});
+    std::vector<Vector<Half, 5>> wide_halves(wide.size());
+    convertVectors(wide, wide_halves);
+    std::vector<Vector<double, 5>> wide_doubles(wide.size());
+    convertVectors(wide_halves, wide_doubles);
+    REQUIRE(wide_doubles.back() == Vector<double, 5>{1., 2., 3., 4., 5.});
+
+    std::vector<Vector<float, 5>> empty;
+    convertVectors(empty, std::vector<Vector<Half, 5>>{});
+}
@@ -1,3 +1,9 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "../src/Math.hpp"
@@ -7,3 +13,92 @@ TEST_CASE("Test Equals") {
     REQUIRE(equals(1.F, 1.00000001F));
     REQUIRE(!equals(1.F, 1.0000001F));
 }
+
+TEST_CASE("Test IsClose") {
+    STATIC_REQUIRE(is_close(1.f, 1.f));
+    STATIC_REQUIRE(is_close(0.f, -0.f));
+    STATIC_REQUIRE(!is_close(1.f, std::nextafter(1.f, 2.f)));
+
+    // Absolute, relative and ULP tolerances
+    REQUIRE(is_close(1e-9, 0., {.absolute = 1e-8}));
+    REQUIRE(!is_close(1e-7, 0., {.absolute = 1e-8}));
+    REQUIRE(is_close(1000.f, 1000.1f, {.relative = 1e-3f}));
+    REQUIRE(!is_close(1.f, 1.1f, {.relative = 1e-3f}));
+    REQUIRE(is_close(1.f, std::nextafter(std::nextafter(1.f, 2.f), 2.f), {.ulps = 2}));
+    REQUIRE(!is_close(1.f, std::nextafter(std::nextafter(1.f, 2.f), 2.f), {.ulps = 1}));
+    // Across zero, every float in between counts
+    REQUIRE(is_close(std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(), {.ulps = 3}));
+    REQUIRE(!is_close(std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(), {.ulps = 2}));
+    REQUIRE(is_close(-2.0, std::nextafter(-2.0, 0.), {.ulps = 1}));
+
+    // NaN and infinities
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    constexpr Tolerance<float> loose{.absolute = 1e30f, .relative = 1e30f, .ulps = 1u << 31};
+    REQUIRE(!is_close(nan, nan, loose));
+    REQUIRE(!is_close(nan, 1.f, loose));
+    REQUIRE(is_close(infinity, infinity));
+    REQUIRE(!is_close(infinity, -infinity, loose));
+    REQUIRE(!is_close(infinity, std::numeric_limits<float>::max(), loose));
+}
+
+TEST_CASE("Test IsClose Vectors") {
+    constexpr Tolerance<float> tolerance{.absolute = 1e-3f};
+    STATIC_REQUIRE(is_close(Vector3f{1.f, 2.f, 3.f}, Vector3f{1.f, 2.0005f, 3.f}, tolerance));
+    STATIC_REQUIRE(!is_close(Vector3f{1.f, 2.f, 3.f}, Vector3f{1.f, 2.f, 3.01f}, tolerance));
+    REQUIRE(is_close(VectorTuple3f{1.f, 2.f, 3.f}, VectorTuple3f{1.0005f, 2.f, 3.f}, tolerance));
+    REQUIRE(!is_close(VectorTuple3f{1.f, 2.f, 3.f}, VectorTuple3f{1.f, 2.1f, 3.f}, tolerance));
+    using Mixed = MixedVectorTuple<float, std::int16_t>;
+    REQUIRE(is_close(Mixed{1.f, std::int16_t{2}}, Mixed{1.0005f, std::int16_t{2}}, tolerance));
+    REQUIRE(!is_close(Mixed{1.f, std::int16_t{2}}, Mixed{1.f, std::int16_t{3}}, tolerance));
+}
+
+TEST_CASE("Test AllClose") {
+    std::vector<float> expected(10'000);
+    for(std::size_t i = 0; i < expected.size(); ++i)
+    {
+        expected[i] = std::sin(static_cast<float>(i));
+    }
+    std::vector<float> actual = expected;
+    REQUIRE(all_close(actual, expected));
+    REQUIRE(all_close(std::span(actual).first(100), std::span(expected).first(100)));
+
+    // Mismatches in full blocks and in the last partial one, reported in order
+    for(const std::size_t i : {3u, 700u, 701u, 5000u, 9990u, 9999u})
+    {
+        actual[i] += 0.01f;
+    }
+    CloseReport report = all_close(actual, expected, {.absolute = 1e-3f}, 4);
+    REQUIRE(!report);
+    REQUIRE(report.mismatches == 6);
+    REQUIRE(report.first_mismatches == std::vector<std::size_t>{3, 700, 701, 5000});
+    REQUIRE(all_close(actual, expected, {.absolute = 0.02f}));
+    actual[20] = std::numeric_limits<float>::quiet_NaN();
+    REQUIRE(all_close(actual, expected, {.absolute = 0.02f}).first_mismatches == std::vector<std::size_t>{20});
+}
+
+TEST_CASE("Test AllClose Vectors") {
+    std::vector<Vector3f> expected(1000);
+    for(std::size_t i = 0; i < expected.size(); ++i)
+    {
+        const auto value = static_cast<float>(i);
+        expected[i] = {value, -value, value / 3.f};
+    }
+    std::vector<Vector3f> actual = expected;
+    REQUIRE(all_close(actual, expected));
+    actual[300][2] += 1.f;
+    actual[301][0] += 1e-5f;
+    actual[999][1] += 1.f;
+    // Indices of vectors, not of components
+    CloseReport report = all_close(actual, expected, {.absolute = 1e-3f});
+    REQUIRE(report.mismatches == 2);
+    REQUIRE(report.first_mismatches == std::vector<std::size_t>{300, 999});
+
+    std::vector<ContiguousVectorTuple<float, 2>> tuples(600);
+    std::vector<VectorTuple2f> layout_tuples(600);
+    REQUIRE(all_close(tuples, tuples));
+    REQUIRE(all_close(layout_tuples, layout_tuples));
+    tuples[513] = ContiguousVectorTuple<float, 2>{0.f, 1.f};
+    const auto zeros = std::vector<ContiguousVectorTuple<float, 2>>(600);
+    REQUIRE(all_close(tuples, zeros).first_mismatches == std::vector<std::size_t>{513});
+}
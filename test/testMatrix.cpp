@@ -0,0 +1,84 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/Matrix.hpp"
+
+TEST_CASE("Test Matrix Constructors And Access") {
+    constexpr Matrix<int, 2, 3> m{1, 2, 3, 4, 5, 6};
+    static_assert(m(0, 2) == 3);
+    static_assert(m(1, 0) == 4);
+    static_assert(m.row(1) == Vector3i{4, 5, 6});
+    static_assert(m.column(1) == Vector2i{2, 5});
+    static_assert(m.transposed() == Matrix<int, 3, 2>{1, 4, 2, 5, 3, 6});
+
+    REQUIRE(Matrix3f() == Matrix3f(0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f));
+    REQUIRE(Matrix3f::identity() == Matrix3f(1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f));
+}
+
+TEST_CASE("Test Matrix Arithmetic") {
+    constexpr Matrix<int, 2, 2> a{1, 2, 3, 4};
+    constexpr Matrix<int, 2, 2> b{0, 1, 1, 0};
+    static_assert(a + b == Matrix<int, 2, 2>{1, 3, 4, 4});
+    static_assert(a - b == Matrix<int, 2, 2>{1, 1, 2, 4});
+    static_assert(a * 2 == Matrix<int, 2, 2>{2, 4, 6, 8});
+    static_assert(a * b == Matrix<int, 2, 2>{2, 1, 4, 3});
+    static_assert(b * a == Matrix<int, 2, 2>{3, 4, 1, 2});
+    static_assert(a * Matrix<int, 2, 2>::identity() == a);
+
+    constexpr Matrix<int, 2, 3> m{1, 2, 3, 4, 5, 6};
+    static_assert(m * Vector3i{1, 0, -1} == Vector2i{-2, -2});
+    static_assert((a * m)(1, 2) == 3 * 3 + 4 * 6);
+}
+
+TEST_CASE("Test Matrix Affine Transforms") {
+    constexpr auto move = Matrix4f::translation(Vector3f{1.f, 2.f, 3.f});
+    constexpr auto scale = Matrix4f::scaling(Vector3f{2.f, 2.f, 2.f});
+    static_assert(move.transformPoint(Vector3f{1.f, 1.f, 1.f}) == Vector3f{2.f, 3.f, 4.f});
+    static_assert(move.transformDirection(Vector3f{1.f, 1.f, 1.f}) == Vector3f{1.f, 1.f, 1.f});
+    static_assert((move * scale).transformPoint(Vector3f{1.f, 0.f, 0.f}) == Vector3f{3.f, 2.f, 3.f});
+    static_assert((scale * move).transformPoint(Vector3f{1.f, 0.f, 0.f}) == Vector3f{4.f, 4.f, 6.f});
+    static_assert(Matrix3f::scaling(Vector3f{1.f, 2.f, 3.f}) * Vector3f{1.f, 1.f, 1.f} == Vector3f{1.f, 2.f, 3.f});
+}
+
+TEST_CASE("Test Matrix Batched Transforms") {
+    const Matrix4f affine{
+        0.5f, -1.f, 2.f, 10.f,
+        1.5f, 0.25f, -3.f, -4.f,
+        0.f, 2.f, 1.f, 0.5f,
+        0.f, 0.f, 0.f, 1.f
+    };
+    const Matrix<float, 3, 3> linear{1.f, 2.f, 3.f, -4.f, 5.f, -6.f, 0.1f, 0.2f, 0.3f};
+
+    std::vector<Vector3f> vectors;
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        vectors.push_back({f * 0.5f - 100.f, 3.f - f, f * f * 0.01f});
+    }
+
+    std::vector<Vector3f> points(vectors.size());
+    std::vector<Vector3f> directions(vectors.size());
+    std::vector<Vector3f> transformed(vectors.size());
+    transformPoints(affine, vectors, points);
+    transformDirections(affine, vectors, directions);
+    transform(linear, vectors, transformed);
+
+    const VectorArray3f array(vectors);
+    VectorArray3f array_points;
+    VectorArray3f array_directions;
+    transformPoints(affine, array, array_points);
+    transformDirections(affine, array, array_directions);
+    VectorArray3f in_place = array;
+    transform(linear, in_place, in_place);
+
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(points[i] == affine.transformPoint(vectors[i]));
+        REQUIRE(directions[i] == affine.transformDirection(vectors[i]));
+        REQUIRE(transformed[i] == linear * vectors[i]);
+        REQUIRE(array_points.get(i) == points[i]);
+        REQUIRE(array_directions.get(i) == directions[i]);
+        REQUIRE(in_place.get(i) == transformed[i]);
+    }
+}
@@ -1,7 +1,20 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "TestHelpers.hpp"
 #include "../src/OstreamRedirector.hpp"
 
 TEST_CASE("Test Ostream") {
@@ -16,3 +29,255 @@ TEST_CASE("Test Ostream") {
     ss << "c";
     REQUIRE(ss.str() == "ac");
 }
+
+TEST_CASE("Test Ostream Concurrent Capture") {
+    constexpr std::size_t THREADS = 8;
+    constexpr std::size_t LINES = 1000;
+    std::stringstream ss;
+    auto os_redir = juan::OstreamRedirector(ss, juan::OstreamRedirector::Capture::Concurrent);
+    {
+        std::vector<std::jthread> threads;
+        for(std::size_t t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&ss, t]{
+                for(std::size_t i = 0; i < LINES; ++i)
+                {
+                    // Unformatted output, operator<< would race on the shared stream width
+                    const auto line = std::to_string(t) + " " + std::to_string(i) + "\n";
+                    const auto half = static_cast<std::streamsize>(line.size() / 2);
+                    ss.write(line.data(), half);
+                    ss.write(line.data() + half, static_cast<std::streamsize>(line.size()) - half);
+                }
+                ss.write("unfinished", 10);
+            });
+        }
+    }
+    os_redir.stop();
+
+    // The unfinished lines are published by stop(), after every complete line
+    const std::string unfinished = "unfinished";
+    auto text = os_redir.get();
+    for(std::size_t t = 0; t < THREADS; ++t)
+    {
+        REQUIRE(text.ends_with(unfinished));
+        text.resize(text.size() - unfinished.size());
+    }
+
+    std::istringstream captured(text);
+    std::vector<std::size_t> next(THREADS, 0);
+    std::string line;
+    while(std::getline(captured, line))
+    {
+        std::istringstream fields(line);
+        std::size_t t = 0;
+        std::size_t i = 0;
+        REQUIRE(fields >> t >> i);
+        REQUIRE(t < THREADS);
+        REQUIRE(next[t] == i);
+        ++next[t];
+    }
+    REQUIRE(std::all_of(next.begin(), next.end(), [](auto count){ return count == LINES; }));
+
+    os_redir.clear();
+    REQUIRE(os_redir.get().empty());
+}
+
+TEST_CASE("Test Ostream Concurrent Formatted Capture") {
+    constexpr std::size_t THREADS = 4;
+    constexpr std::size_t LINES = 500;
+    std::stringstream ss;
+    auto os_redir = juan::OstreamRedirector(ss, juan::OstreamRedirector::Capture::Concurrent);
+    {
+        std::vector<std::jthread> threads;
+        for(std::size_t t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&os_redir, t]{
+                // Every thread formats differently, the stream of one must not leak into another
+                auto & stream = os_redir.threadStream();
+                stream << std::setfill(static_cast<char>('a' + t));
+                if(t % 2 == 1)
+                {
+                    stream << std::hex << std::uppercase;
+                }
+                for(std::size_t i = 0; i < LINES; ++i)
+                {
+                    stream << t << ' ' << std::setw(static_cast<int>(t + 4)) << i << '\n';
+                }
+            });
+        }
+        // Merging while the threads write hands the lines back to them
+        for(int i = 0; i < 20; ++i)
+        {
+            (void)os_redir.get();
+        }
+    }
+    os_redir.stop();
+
+    std::istringstream captured(os_redir.get());
+    std::vector<std::size_t> next(THREADS, 0);
+    std::string line;
+    while(std::getline(captured, line))
+    {
+        const auto t = static_cast<std::size_t>(line[0] - '0');
+        REQUIRE(t < THREADS);
+        std::ostringstream expected;
+        expected << std::setfill(static_cast<char>('a' + t));
+        if(t % 2 == 1)
+        {
+            expected << std::hex << std::uppercase;
+        }
+        expected << t << ' ' << std::setw(static_cast<int>(t + 4)) << next[t];
+        REQUIRE(line == expected.str());
+        ++next[t];
+    }
+    REQUIRE(std::all_of(next.begin(), next.end(), [](auto count){ return count == LINES; }));
+}
+
+TEST_CASE("Test Ostream Ring Capture") {
+    std::stringstream ss;
+    auto os_redir = juan::OstreamRedirector(ss, juan::OstreamRedirector::Capture::Ring, 8);
+    ss << "abcdef";
+    REQUIRE(os_redir.get() == "abcdef");
+
+    os_redir.consume(4);
+    ss << "ghij" << 12;
+    REQUIRE(os_redir.get() == "efghij12");
+    const auto chunks = os_redir.chunks();
+    REQUIRE(chunks[0].empty());
+    REQUIRE(chunks[1] == "efgh");
+    REQUIRE(chunks[2] == "ij12");
+
+    // Full ring without spill file: the oldest bytes are dropped
+    ss << "345";
+    REQUIRE(os_redir.get() == "hij12345");
+
+    std::string drained;
+    REQUIRE(os_redir.drain([&](std::string_view chunk){ drained += chunk; }) == 8);
+    REQUIRE(drained == "hij12345");
+    REQUIRE(os_redir.get().empty());
+
+    ss << std::string(20, 'x') << "end";
+    REQUIRE(os_redir.get() == "xxxxxend");
+}
+
+TEST_CASE("Test Ostream Ring Capture Spill") {
+    if(!juan::RingCaptureBuffer::SPILL_SUPPORTED)
+    {
+        return;
+    }
+    const TemporaryDirectory directory;
+    const auto path = directory.path / "spill";
+    // An existing file with the same name is left alone
+    std::ofstream(path) << "keep";
+    std::stringstream ss;
+    auto os_redir = juan::OstreamRedirector(ss, juan::OstreamRedirector::Capture::Ring, 16, path);
+    // The spill file is unlinked as soon as it is created
+    REQUIRE(std::distance(std::filesystem::directory_iterator(directory.path), std::filesystem::directory_iterator()) == 1);
+
+    std::string expected;
+    for(int i = 0; i < 1000; ++i)
+    {
+        ss << i << ' ';
+        expected += std::to_string(i) + ' ';
+    }
+    REQUIRE(os_redir.get() == expected);
+    REQUIRE(os_redir.chunks()[0].size() + 16 >= expected.size());
+
+    os_redir.consume(expected.size() - 4);
+    REQUIRE(os_redir.get() == "999 ");
+    ss << "more";
+    REQUIRE(os_redir.get() == "999 more");
+    os_redir.clear();
+    REQUIRE(os_redir.get().empty());
+
+    std::string kept;
+    std::ifstream(path) >> kept;
+    REQUIRE(kept == "keep");
+}
+
+TEST_CASE("Test Ostream Async Sink") {
+    std::mutex mutex;
+    std::string forwarded;
+    std::size_t writes = 0;
+    std::stringstream ss;
+    auto os_redir = juan::OstreamRedirector(ss, [&](std::string_view bytes){
+        std::scoped_lock lock(mutex);
+        forwarded += bytes;
+        ++writes;
+    }, {.block_size = 64, .max_blocks = 2});
+
+    std::string expected;
+    for(int i = 0; i < 1000; ++i)
+    {
+        ss << i << '\n';
+        expected += std::to_string(i) + '\n';
+    }
+    os_redir.flush();
+    std::scoped_lock lock(mutex);
+    REQUIRE(forwarded == expected);
+    REQUIRE(writes <= expected.size() / 64 + 1);
+    REQUIRE(os_redir.get().empty());
+}
+
+TEST_CASE("Test Ostream Async Sink Back Pressure") {
+    using Options = juan::AsyncSinkBuffer::Options;
+    using BackPressure = juan::AsyncSinkBuffer::BackPressure;
+
+    // The sink is held until the whole output has been written
+    std::mutex held;
+    std::string forwarded;
+    auto sink = [&](std::string_view bytes){
+        std::scoped_lock lock(held);
+        forwarded += bytes;
+    };
+    const std::string output(1000, 'x');
+
+    SECTION("Drop") {
+        std::unique_lock hold(held);
+        juan::AsyncSinkBuffer buffer(sink, Options{.block_size = 100, .max_blocks = 2, .back_pressure = BackPressure::Drop});
+        std::ostream(&buffer) << output << std::flush;
+        REQUIRE(buffer.dropped() > 0);
+        REQUIRE(buffer.blockCount() == 2);
+        hold.unlock();
+        buffer.flush();
+        REQUIRE(forwarded.size() + buffer.dropped() == output.size());
+    }
+
+    SECTION("Grow") {
+        std::unique_lock hold(held);
+        juan::AsyncSinkBuffer buffer(sink, Options{.block_size = 100, .max_blocks = 2, .back_pressure = BackPressure::Grow});
+        std::ostream(&buffer) << output << std::flush;
+        REQUIRE(buffer.dropped() == 0);
+        REQUIRE(buffer.blockCount() >= 9);
+        hold.unlock();
+        buffer.flush();
+        REQUIRE(forwarded == output);
+    }
+
+    SECTION("Block") {
+        juan::AsyncSinkBuffer buffer(sink, Options{.block_size = 100, .max_blocks = 2, .back_pressure = BackPressure::Block});
+        std::ostream(&buffer) << output << std::flush;
+        buffer.flush();
+        REQUIRE(buffer.dropped() == 0);
+        REQUIRE(buffer.blockCount() <= 2);
+        REQUIRE(forwarded == output);
+    }
+}
+
+#if __has_include(<unistd.h>)
+TEST_CASE("Test Ostream Async File Descriptor") {
+    std::FILE * file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    std::stringstream ss;
+    {
+        auto os_redir = juan::OstreamRedirector(ss, ::fileno(file));
+        ss << "forwarded " << 42 << std::endl;
+    }
+
+    std::rewind(file);
+    std::array<char, 64> read{};
+    const auto count = std::fread(read.data(), 1, read.size(), file);
+    REQUIRE(std::string_view(read.data(), count) == "forwarded 42\n");
+    std::fclose(file);
+}
+#endif
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <tuple>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/ecs/DenseSlotMap.hpp"
+#include "../src/ecs/ParallelForEach.hpp"
+
+TEST_CASE("Test Parallel For Each") {
+    juan::ThreadPool pool(3);
+    DenseSlotMap<int> map;
+    for(int i = 0; i < 10'000; ++i)
+    {
+        std::ignore = map.insert(i);
+    }
+
+    parallelForEach(pool, map, [](int & value){ value *= 2; }, 128);
+    for(std::size_t i = 0; i < map.size(); ++i)
+    {
+        REQUIRE(map.data()[i] == static_cast<int>(i) * 2);
+    }
+
+    parallelForEach(pool, map, [&](const auto & key, int & value){
+        value = static_cast<int>(key.index);
+    });
+    REQUIRE(map.data()[9'999] == 9'999);
+}
+
+TEST_CASE("Test Parallel Reduce") {
+    juan::ThreadPool pool(3);
+    DenseSlotMap<int> map;
+    for(int i = 1; i <= 1000; ++i)
+    {
+        std::ignore = map.insert(i);
+    }
+
+    const long sum = parallelReduce(pool, map, 0L, [](int value){ return static_cast<long>(value); }, std::plus<>(), juan::Reduction::Deterministic, 64);
+    REQUIRE(sum == 500'500);
+
+    const int maximum = parallelReduce(pool, map, 0, [](int value){ return value; }, [](int a, int b){ return std::max(a, b); }, juan::Reduction::Unordered);
+    REQUIRE(maximum == 1000);
+}
@@ -0,0 +1,90 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/QuantizedVectors.hpp"
+
+using Vector2i8 = Vector2<std::int8_t>;
+
+static_assert(sizeof(QuantizedVectors<std::int16_t, 3>::quantized_type) == 6);
+
+TEST_CASE("Test QuantizedVectors Encoding") {
+    std::vector<Vector3f> vectors(101, Vector3f{-40.f, 0.f, 0.f});
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        const float value = (static_cast<float>(i) - 50.f) * 0.731f;
+        vectors[i] = {value, std::sin(value) * 10.f, -value * 0.5f};
+    }
+
+    const QuantizedVectors<std::int16_t, 3> quantized(vectors);
+    REQUIRE(quantized.size() == vectors.size());
+    REQUIRE(quantized.scale() == 40.f / 32767.f);
+    REQUIRE(quantized.quantized().back() == Vector3<std::int16_t>{std::int16_t{-32767}, std::int16_t{0}, std::int16_t{0}});
+
+    const std::vector<Vector3f> decoded = quantized.decode();
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            REQUIRE(std::abs(decoded[i][c] - vectors[i][c]) <= quantized.scale() * 0.5001f);
+        }
+        REQUIRE(quantized.get(i) == decoded[i]);
+    }
+
+    // Stored data keeps its scale
+    const QuantizedVectors<std::int16_t, 3> copy(std::vector(quantized.quantized().begin(), quantized.quantized().end()), quantized.scale());
+    REQUIRE(copy.decode() == decoded);
+}
+
+TEST_CASE("Test QuantizedVectors Modification") {
+    QuantizedVectors<std::int8_t, 2> quantized;
+    REQUIRE(quantized.empty());
+
+    const std::vector<Vector2<float>> zeros(3);
+    quantized.encode(zeros);
+    REQUIRE(quantized.scale() == 1.f);
+    REQUIRE(quantized.decode() == zeros);
+
+    const std::vector<Vector2<float>> vectors{{1.27f, -1.27f}, {0.5f, 0.f}};
+    quantized.encode(vectors);
+    REQUIRE(quantized.quantized()[0] == Vector2i8{std::int8_t{127}, std::int8_t{-127}});
+    REQUIRE(quantized.quantized()[1] == Vector2i8{std::int8_t{50}, std::int8_t{0}});
+
+    quantized.set(1, {-0.305f, 1.f});
+    REQUIRE(quantized.quantized()[1] == Vector2i8{std::int8_t{-31}, std::int8_t{100}});
+    std::vector<Vector2<float>> decoded(2);
+    quantized.decode(decoded);
+    REQUIRE(std::abs(decoded[1][0] + 0.31f) < 1e-6f);
+}
+
+TEST_CASE("Test QuantizedVectors Non Finite") {
+    const std::vector<Vector3f> vectors{{1.f, 2.f, 3.f}, {-4.f, 5.f, 6.f}};
+    QuantizedVectors<std::int16_t, 3> quantized(vectors);
+    const auto before = quantized.decode();
+
+    // Rejected, whichever component is not finite, and the contents are kept
+    for(const float bad : {std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()})
+    {
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            std::vector<Vector3f> invalid(5, Vector3f{0.5f, 0.5f, 0.5f});
+            invalid[3][c] = bad;
+            REQUIRE_THROWS_AS(quantized.encode(invalid), std::invalid_argument);
+            REQUIRE(quantized.size() == vectors.size());
+            REQUIRE(quantized.decode() == before);
+        }
+    }
+
+    // Subnormal components do not give a null scale
+    const std::vector<Vector3f> tiny(2, Vector3f{std::numeric_limits<float>::denorm_min(), 0.f, 0.f});
+    quantized.encode(tiny);
+    REQUIRE(quantized.scale() > 0.f);
+    for(const auto & vector : quantized.decode())
+    {
+        REQUIRE(std::isfinite(vector[0]));
+    }
+}
@@ -0,0 +1,73 @@
+#include <numbers>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "../src/Quaternion.hpp"
+
+using Vector3d = Vector3<double>;
+
+namespace
+{
+    void requireClose(const Vector3d & actual, const Vector3d & expected)
+    {
+        using Catch::Matchers::WithinAbs;
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            REQUIRE_THAT(actual[i], WithinAbs(expected[i], 1e-12));
+        }
+    }
+}
+
+TEST_CASE("Test Quaternion Rotations") {
+    constexpr Quaterniond identity;
+    static_assert(identity.rotate(Vector3<double>{1., 2., 3.}) == Vector3<double>{1., 2., 3.});
+    static_assert(identity * identity == identity);
+
+    const auto quarter = Quaterniond::fromAxisAngle({0., 0., 1.}, std::numbers::pi / 2);
+    requireClose(quarter.rotate({1., 0., 0.}), {0., 1., 0.});
+    requireClose((quarter * quarter).rotate({1., 0., 0.}), {-1., 0., 0.});
+    requireClose(quarter.inverse().rotate(quarter.rotate({1., 2., 3.})), {1., 2., 3.});
+    requireClose(quarter.conjugate().rotate({0., 1., 0.}), {1., 0., 0.});
+
+    // q1 * q2 rotates by q2 first
+    const auto tilt = Quaterniond::fromAxisAngle({1., 0., 0.}, std::numbers::pi / 2);
+    requireClose((tilt * quarter).rotate({1., 0., 0.}), tilt.rotate(quarter.rotate({1., 0., 0.})));
+
+    using Catch::Matchers::WithinAbs;
+    REQUIRE_THAT(Quaterniond(1., 2., 3., 4.).normalized().norm(), WithinAbs(1., 1e-12));
+}
+
+TEST_CASE("Test Quaternion Matrices") {
+    const auto rotation = (Quaterniond::fromAxisAngle({0., 1., 0.}, 0.7) * Quaterniond::fromAxisAngle({1., 0., 0.}, -1.3)).normalized();
+    const auto matrix = rotation.toMatrix3();
+    const auto affine = Matrix4<double>::translation({1., 2., 3.}) * rotation.toMatrix4();
+    for(const Vector3d v : {Vector3d{1., 0., 0.}, Vector3d{0., 1., 0.}, Vector3d{3., -2., 5.}})
+    {
+        requireClose(matrix * v, rotation.rotate(v));
+        requireClose(affine.transformPoint(v), rotation.rotate(v) + Vector3d{1., 2., 3.});
+    }
+}
+
+TEST_CASE("Test Quaternion Batched Rotations") {
+    const auto rotation = Quaternionf::fromAxisAngle(Vector3f{0.f, 0.6f, 0.8f}, 0.3f);
+    std::vector<Vector3f> vectors;
+    for(int i = 0; i < 100; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        vectors.push_back({f, -f * 0.5f, 2.f});
+    }
+
+    std::vector<Vector3f> rotated(vectors.size());
+    rotate(rotation, vectors, rotated);
+    VectorArray3f array(vectors);
+    rotate(rotation, array, array);
+
+    const auto matrix = rotation.toMatrix3();
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(rotated[i] == matrix * vectors[i]);
+        REQUIRE(array.get(i) == rotated[i]);
+    }
+}
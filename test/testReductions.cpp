@@ -0,0 +1,181 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/Reductions.hpp"
+
+namespace
+{
+    // Points spread around (1000, -2, 0.5), so float sums lose digits
+    [[nodiscard]] std::vector<Vector3f> offsetPoints(std::size_t count) {
+        std::vector<Vector3f> result(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<float>(i);
+            result[i] = Vector3f{1000.f + std::sin(x), -2.f + 0.5f * std::cos(3.f * x), 0.5f + 0.25f * std::sin(7.f * x)};
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::array<double, 3> exactSum(const std::vector<Vector3f> & points) {
+        std::array<double, 3> result{};
+        for(const auto & point : points)
+        {
+            for(std::size_t c = 0; c < 3; ++c)
+            {
+                result[c] += static_cast<double>(point[c]);
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] double relativeError(float value, double exact) {
+        return std::abs(static_cast<double>(value) - exact) / std::abs(exact);
+    }
+}
+
+TEST_CASE("Test Vector Sum") {
+    const std::vector<Vector3i> integers{Vector3i(1, 2, 3), Vector3i(4, 5, 6), Vector3i(-5, 0, 1)};
+    REQUIRE(vectorSum(integers) == Vector3i(0, 7, 10));
+    REQUIRE(vectorSum(std::span(integers).first(0)) == Vector3i(0));
+    REQUIRE(vectorDotSum(integers, integers) == 14 + 77 + 26);
+
+    // Every summation gives the exact sum of small integers, in the lanes and in the tail
+    std::vector<Vector2f> floats(1003);
+    for(std::size_t i = 0; i < floats.size(); ++i)
+    {
+        floats[i] = Vector2f{static_cast<float>(i), 1.f};
+    }
+    const Vector2f expected{1003.f * 1002.f / 2.f, 1003.f};
+    REQUIRE(vectorSum<Summation::simple>(floats) == expected);
+    REQUIRE(vectorSum<Summation::pairwise>(floats) == expected);
+    REQUIRE(vectorSum<Summation::kahan>(floats) == expected);
+
+    std::vector<VectorTuple3f> tuples(5);
+    std::vector<ContiguousVectorTuple<float, 3>> contiguous(5);
+    std::vector<MixedVectorTuple<float, std::int16_t>> mixed(5);
+    for(std::size_t i = 0; i < 5; ++i)
+    {
+        tuples[i].get<1>() = static_cast<float>(i);
+        contiguous[i].get<2>() = static_cast<float>(i);
+        mixed[i].get<1>() = static_cast<std::int16_t>(i);
+    }
+    REQUIRE(vectorSum(tuples) == Vector3f{0.f, 10.f, 0.f});
+    REQUIRE(vectorSum<Summation::kahan>(contiguous) == Vector3f{0.f, 0.f, 10.f});
+    REQUIRE(vectorSum(mixed) == Vector2f{0.f, 10.f});
+    REQUIRE(vectorDotSum(tuples, tuples) == 30.f);
+}
+
+TEST_CASE("Test Vector Sum Accuracy") {
+    const std::vector<Vector3f> points = offsetPoints(1'000'000);
+    const auto exact = exactSum(points);
+    const Vector3f pairwise = vectorSum<Summation::pairwise>(points);
+    const Vector3f kahan = vectorSum<Summation::kahan>(points);
+    Vector3f sequential(0.f);
+    for(const auto & point : points)
+    {
+        sequential += point;
+    }
+    for(std::size_t c = 0; c < 3; ++c)
+    {
+        // Kahan is within a rounding of the exact sum
+        REQUIRE(relativeError(kahan[c], exact[c]) <= 1e-7);
+        REQUIRE(relativeError(pairwise[c], exact[c]) <= 1e-6);
+        REQUIRE(relativeError(pairwise[c], exact[c]) <= relativeError(sequential[c], exact[c]));
+    }
+}
+
+TEST_CASE("Test Vector Bounds") {
+    const std::vector<Vector2f> points{
+        Vector2f{1.f, 5.f}, Vector2f{-3.f, 2.f}, Vector2f{4.f, -1.f},
+        Vector2f{0.f, std::numeric_limits<float>::quiet_NaN()}, Vector2f{2.f, 8.f}
+    };
+    const Aabb2f bounds = vectorBounds(points);
+    REQUIRE(bounds == Aabb2f{{-3.f, -1.f}, {4.f, 8.f}});
+    REQUIRE(vectorMin(points) == bounds.min);
+    REQUIRE(vectorMax(points) == bounds.max);
+    REQUIRE(vectorBounds(std::span(points).first(0)) == Aabb2f::inverted());
+
+    const std::vector<Vector3f> many = offsetPoints(10'001);
+    Aabb3f expected = Aabb3f::inverted();
+    for(const auto & point : many)
+    {
+        expected = expected.merged(point);
+    }
+    REQUIRE(vectorBounds(many) == expected);
+}
+
+TEST_CASE("Test Vector Mean And Covariance") {
+    const std::vector<Vector2f> points{Vector2f{1.f, 1.f}, Vector2f{3.f, 5.f}, Vector2f{5.f, 3.f}, Vector2f{3.f, 3.f}};
+    REQUIRE(vectorMean(points) == Vector2f{3.f, 3.f});
+    const Matrix<float, 2, 2> covariance = vectorCovariance(points);
+    REQUIRE(covariance == Matrix<float, 2, 2>(2.f, 1.f, 1.f, 2.f));
+
+    // Far from the origin, where the one pass formula cancels
+    const std::vector<Vector3f> offset = offsetPoints(100'000);
+    const auto sum = exactSum(offset);
+    std::array<double, 3> mean;
+    for(std::size_t c = 0; c < 3; ++c)
+    {
+        mean[c] = sum[c] / static_cast<double>(offset.size());
+    }
+    std::array<double, 9> expected{};
+    for(const auto & point : offset)
+    {
+        for(std::size_t r = 0; r < 3; ++r)
+        {
+            for(std::size_t c = 0; c < 3; ++c)
+            {
+                expected[r * 3 + c] += (static_cast<double>(point[r]) - mean[r]) * (static_cast<double>(point[c]) - mean[c]);
+            }
+        }
+    }
+    const Matrix3f result = vectorCovariance<Summation::kahan>(offset);
+    for(std::size_t r = 0; r < 3; ++r)
+    {
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            const double value = expected[r * 3 + c] / static_cast<double>(offset.size());
+            REQUIRE(std::abs(static_cast<double>(result(r, c)) - value) <= 1e-5);
+        }
+    }
+}
+
+TEST_CASE("Test Parallel Vector Reductions") {
+    const std::vector<Vector3f> points = offsetPoints(100'003);
+    juan::ThreadPool pool(3);
+    juan::ThreadPool single(1);
+    constexpr std::size_t GRAIN = 4096;
+
+    // The result only depends on the grain
+    const Vector3f sum = vectorSum(pool, points, GRAIN);
+    REQUIRE(sum == vectorSum(single, points, GRAIN));
+    const auto exact = exactSum(points);
+    for(std::size_t c = 0; c < 3; ++c)
+    {
+        REQUIRE(relativeError(sum[c], exact[c]) <= 1e-6);
+        REQUIRE(relativeError(vectorSum<Summation::kahan>(pool, points, GRAIN)[c], exact[c]) <= 1e-7);
+    }
+
+    REQUIRE(vectorBounds(pool, points, GRAIN) == vectorBounds(points));
+    REQUIRE(vectorMin(pool, points, GRAIN) == vectorMin(points));
+    REQUIRE(vectorMax(pool, points, GRAIN) == vectorMax(points));
+    REQUIRE(vectorBounds(pool, std::span(points).first(0)) == Aabb3f::inverted());
+    REQUIRE(vectorDotSum(pool, points, points, GRAIN) == vectorDotSum(single, points, points, GRAIN));
+    REQUIRE(vectorMean(pool, points, GRAIN) == vectorMean(single, points, GRAIN));
+
+    const Matrix3f covariance = vectorCovariance(pool, points, GRAIN);
+    const Matrix3f serial = vectorCovariance(points);
+    for(std::size_t r = 0; r < 3; ++r)
+    {
+        for(std::size_t c = 0; c < 3; ++c)
+        {
+            REQUIRE(std::abs(covariance(r, c) - serial(r, c)) <= 1e-5f);
+        }
+    }
+}
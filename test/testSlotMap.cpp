@@ -0,0 +1,253 @@
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/ecs/SlotMap.hpp"
+
+TEST_CASE("Test SlotMap Get") {
+    SlotMap<DenseComponentMap<int>, UnorderedComponentMap<std::string>> world;
+    const auto entity = world.create();
+    world.insert(entity, 3);
+    world.insert(entity, std::string("three"));
+
+    REQUIRE(world.get<int>().get(entity) == 3);
+    REQUIRE(world.get<std::string>().get(entity) == "three");
+
+    const auto & const_world = world;
+    REQUIRE(const_world.get<int>().size() == 1);
+    REQUIRE(const_world.get<std::string>().get(entity) == "three");
+
+    world.clear();
+    REQUIRE(world.get<int>().size() == 0);
+    REQUIRE(world.get<std::string>().size() == 0);
+}
+
+TEST_CASE("Test SlotMap Clear Keeps Old Keys Stale") {
+    DenseSlotMapWorld<int, float> world;
+    std::vector<EntityKey> old_keys;
+    for(int i = 0; i < 8; ++i)
+    {
+        old_keys.push_back(world.create());
+        world.insert(old_keys.back(), i);
+    }
+    // Destroyed and created again, so the generations differ between slots
+    REQUIRE(world.destroy(old_keys[2]));
+    old_keys[2] = world.create();
+    world.insert(old_keys[2], 2);
+    world.insert(old_keys[5], 5.f);
+
+    for(int round = 0; round < 3; ++round)
+    {
+        world.clear();
+        REQUIRE(world.entityCount() == 0);
+        std::vector<EntityKey> keys;
+        for(int i = 0; i < 8; ++i)
+        {
+            keys.push_back(world.create());
+            world.insert(keys.back(), 100 + i);
+            world.insert(keys.back(), static_cast<float>(i));
+        }
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            REQUIRE(world.contains(keys[i]));
+            REQUIRE(world.get<int>().get(keys[i]) == 100 + static_cast<int>(i));
+            REQUIRE(!world.contains(old_keys[i]));
+            REQUIRE(!world.destroy(old_keys[i]));
+            REQUIRE(world.get<int>().find(old_keys[i]) == nullptr);
+            REQUIRE(world.get<float>().find(old_keys[i]) == nullptr);
+        }
+        REQUIRE(world.entityCount() == 8);
+        old_keys = keys;
+    }
+}
+
+TEST_CASE("Test SlotMap Independent Worlds") {
+    DenseSlotMapWorld<int, float> first;
+    DenseSlotMapWorld<int, float> second;
+    first.insert(first.create(), 1);
+    REQUIRE(first.get<int>().size() == 1);
+    REQUIRE(second.get<int>().size() == 0);
+    REQUIRE(second.entityCount() == 0);
+
+    SlotMap<UnorderedComponentMap<int>> third;
+    SlotMap<UnorderedComponentMap<int>> fourth;
+    const auto key = third.create();
+    third.insert(key, 5);
+    REQUIRE(third.get<int>().get(key) == 5);
+    REQUIRE(fourth.get<int>().size() == 0);
+}
+
+TEST_CASE("Test SlotMap Worlds In Parallel") {
+    constexpr std::size_t WORLD_COUNT = 4;
+    constexpr int ENTITY_COUNT = 10'000;
+    std::vector<DenseSlotMapWorld<int>> worlds(WORLD_COUNT);
+    {
+        std::vector<std::jthread> threads;
+        for(auto & world : worlds)
+        {
+            threads.emplace_back([&world]{
+                for(int i = 0; i < ENTITY_COUNT; ++i)
+                {
+                    world.insert(world.create(), i);
+                }
+            });
+        }
+    }
+    for(const auto & world : worlds)
+    {
+        REQUIRE(world.get<int>().size() == ENTITY_COUNT);
+    }
+}
+
+namespace
+{
+    struct Position
+    {
+        int x;
+    };
+
+    struct Velocity
+    {
+        int dx;
+    };
+}
+
+TEST_CASE("Test SlotMap Entities") {
+    DenseSlotMapWorld<Position, Velocity> world;
+    const auto a = world.create();
+    const auto b = world.create();
+    REQUIRE(a != b);
+    REQUIRE(world.entityCount() == 2);
+
+    world.insert(a, Position{1});
+    world.emplace<Velocity>(a, 2);
+    world.insert(b, Velocity{3});
+    REQUIRE(world.get<Position>().get(a).x == 1);
+    REQUIRE(world.get<Velocity>().get(a).dx == 2);
+    REQUIRE(!world.get<Position>().contains(b));
+
+    REQUIRE(world.destroy(a));
+    REQUIRE(!world.destroy(a));
+    REQUIRE(!world.contains(a));
+    REQUIRE(world.get<Position>().empty());
+    REQUIRE(world.get<Velocity>().size() == 1);
+
+    // The slot of a is reused with a new generation
+    const auto c = world.create();
+    REQUIRE(c.index == a.index);
+    REQUIRE(c != a);
+    REQUIRE(!world.get<Velocity>().contains(c));
+
+    world.clear();
+    REQUIRE(world.entityCount() == 0);
+    REQUIRE(!world.contains(b));
+    REQUIRE(!world.contains(c));
+    const auto d = world.create();
+    REQUIRE(d != b);
+    REQUIRE(d != c);
+}
+
+TEST_CASE("Test SlotMap Each") {
+    DenseSlotMapWorld<Position, Velocity, float> world;
+    auto & positions = world.get<Position>();
+    auto & velocities = world.get<Velocity>();
+
+    std::vector<DenseSlotMapWorld<Position, Velocity, float>::key_type> keys;
+    for(int i = 0; i < 10; ++i)
+    {
+        keys.push_back(world.create());
+        world.insert(keys.back(), Position{i});
+        world.insert(keys.back(), Velocity{i * 10});
+    }
+    // Entities 0, 2, 4... lose their velocity, entity 3 its position
+    for(std::size_t i = 0; i < keys.size(); i += 2)
+    {
+        velocities.erase(keys[i]);
+    }
+    positions.erase(keys[3]);
+
+    world.each<Position, Velocity>([](Position & position, Velocity & velocity){
+        position.x += velocity.dx;
+    });
+
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        const int x = static_cast<int>(i);
+        if(i == 3)
+            REQUIRE(!positions.contains(keys[i]));
+        else if(i % 2 == 0)
+            REQUIRE(positions.get(keys[i]).x == x);
+        else
+            REQUIRE(positions.get(keys[i]).x == x + x * 10);
+    }
+
+    std::size_t count = 0;
+    world.each<Velocity, Position>([&](const auto & key, Velocity &, Position &){
+        REQUIRE(positions.contains(key));
+        ++count;
+    });
+    REQUIRE(count == 4);
+
+    count = 0;
+    world.each<float>([&](float &){ ++count; });
+    REQUIRE(count == 0);
+}
+
+TEST_CASE("Test SlotMap Each Different Insertion Orders") {
+    DenseSlotMapWorld<Position, Velocity> world;
+    std::vector<DenseSlotMapWorld<Position, Velocity>::key_type> keys;
+    for(int i = 0; i < 8; ++i)
+    {
+        keys.push_back(world.create());
+    }
+    // Positions in order, velocities backwards and only for odd entities
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        world.insert(keys[i], Position{static_cast<int>(i)});
+    }
+    for(std::size_t i = keys.size(); i-- > 0;)
+    {
+        if(i % 2 == 1)
+        {
+            world.insert(keys[i], Velocity{static_cast<int>(i) * 100});
+        }
+    }
+    // A Velocity for an entity without a Position is not joined with anything
+    const auto lone = world.create();
+    world.insert(lone, Velocity{-1});
+
+    std::size_t count = 0;
+    world.each<Position, Velocity>([&](const auto & key, Position & position, Velocity & velocity){
+        REQUIRE(key != lone);
+        REQUIRE(velocity.dx == position.x * 100);
+        REQUIRE(position.x % 2 == 1);
+        ++count;
+    });
+    REQUIRE(count == 4);
+}
+
+TEST_CASE("Test SlotMap Each Unordered Maps") {
+    using key_type = EntityKey;
+    SlotMap<UnorderedComponentMap<Position>, UnorderedComponentMap<Velocity>> world;
+    std::vector<key_type> keys;
+    for(int i = 0; i < 5; ++i)
+    {
+        keys.push_back(world.create());
+        world.insert(keys.back(), Position{i});
+    }
+    world.insert(keys[3], Velocity{7});
+
+    int sum = 0;
+    world.each<Position, Velocity>([&](const key_type & key, Position & position, Velocity & velocity){
+        REQUIRE(key == keys[3]);
+        sum += position.x + velocity.dx;
+    });
+    REQUIRE(sum == 10);
+
+    REQUIRE(world.destroy(keys[3]));
+    REQUIRE(world.get<Velocity>().size() == 0);
+    REQUIRE(world.get<Position>().find(keys[3]) == nullptr);
+}
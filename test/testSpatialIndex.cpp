@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/KdTree.hpp"
+#include "../src/UniformGrid.hpp"
+
+namespace
+{
+    template <std::size_t SIZE>
+    std::vector<Vector<float, SIZE>> randomPoints(std::size_t count, std::mt19937 & rng, float extent = 10.f)
+    {
+        std::uniform_real_distribution<float> distribution{-extent, extent};
+        std::vector<Vector<float, SIZE>> points(count);
+        for(auto & point : points)
+        {
+            for(auto & component : point)
+            {
+                component = distribution(rng);
+            }
+        }
+        return points;
+    }
+
+    std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> indices)
+    {
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+
+    // Grid with cells of the size of the query radii
+    struct UnitGrid : UniformGrid<float, 3>
+    {
+        UnitGrid() : UniformGrid<float, 3>(1.f) {}
+    };
+
+    template <std::size_t SIZE>
+    void build(KdTree<float, SIZE> & tree, std::span<const Vector<float, SIZE>> points)
+    {
+        tree.build(points);
+    }
+
+    template <std::size_t SIZE>
+    void build(UniformGrid<float, SIZE> & grid, std::span<const Vector<float, SIZE>> points)
+    {
+        grid.update(points);
+    }
+
+    template <typename INDEX, std::size_t SIZE>
+    void requireBruteForceResults(const INDEX & index, const std::vector<Vector<float, SIZE>> & points, const std::vector<Vector<float, SIZE>> & centers, float radius, std::size_t k)
+    {
+        for(const auto & center : centers)
+        {
+            std::vector<std::uint32_t> expected;
+            std::vector<std::uint32_t> actual;
+            bruteForceNearest<float, SIZE>(points, center, k, expected);
+            index.nearest(center, k, actual);
+            REQUIRE(actual == expected);
+
+            expected.clear();
+            actual.clear();
+            bruteForceRadius<float, SIZE>(points, center, radius, expected);
+            index.radius(center, radius, actual);
+            REQUIRE(sorted(actual) == expected);
+        }
+    }
+}
+
+// Every spatial index against bruteForceNearest and bruteForceRadius
+TEMPLATE_TEST_CASE("Test Spatial Index Queries", "", (KdTree<float, 3>), UnitGrid) {
+    std::mt19937 rng{1};
+    const auto points = randomPoints<3>(3000, rng);
+    const auto centers = randomPoints<3>(40, rng, 12.f);
+
+    TestType index;
+    build(index, std::span<const Vector3f>(points));
+    REQUIRE(index.size() == points.size());
+    requireBruteForceResults(index, points, centers, 1.5f, 8);
+    // Radius and k larger than the index
+    requireBruteForceResults(index, points, centers, 40.f, 3000);
+
+    // More neighbors than points, and no neighbors
+    TestType small;
+    build(small, std::span<const Vector3f>(points).first(5));
+    std::vector<std::uint32_t> all;
+    small.nearest(centers[0], 10, all);
+    REQUIRE(sorted(all) == std::vector<std::uint32_t>{0, 1, 2, 3, 4});
+    all.clear();
+    index.nearest(centers[0], 0, all);
+    const TestType empty;
+    empty.nearest(centers[0], 3, all);
+    empty.radius(centers[0], 3.f, all);
+    REQUIRE(all.empty());
+}
+
+TEMPLATE_TEST_CASE("Test Spatial Index Nearest Ties", "", (KdTree<float, 3>), UnitGrid) {
+    // Both points are at the same distance, the lower index wins. For the grid, point 1
+    // is in the first ring exactly at its reach and point 0 one ring later.
+    const std::vector<Vector3f> points{{.5f, .5f, 1.f}, {.5f, .5f, 0.f}};
+    TestType index;
+    build(index, std::span<const Vector3f>(points));
+    requireBruteForceResults(index, points, {{.5f, .5f, .5f}}, .5f, 1);
+}
+
+TEMPLATE_TEST_CASE("Test Spatial Index Batches", "", (KdTree<float, 3>), UnitGrid) {
+    std::mt19937 rng{3};
+    const auto points = randomPoints<3>(2000, rng);
+    const auto centers = randomPoints<3>(600, rng);
+    TestType index;
+    build(index, std::span<const Vector3f>(points));
+    juan::ThreadPool pool(4);
+
+    SpatialQueryResults results;
+    SpatialQueryResults parallel_results;
+    index.nearest(centers, 4, results);
+    index.nearest(pool, centers, 4, parallel_results);
+    REQUIRE(results.size() == centers.size());
+    REQUIRE(results.indices().size() == 4 * centers.size());
+    REQUIRE(std::ranges::equal(results.indices(), parallel_results.indices()));
+    for(std::size_t i = 0; i < centers.size(); ++i)
+    {
+        std::vector<std::uint32_t> expected;
+        bruteForceNearest<float, 3>(points, centers[i], 4, expected);
+        REQUIRE(std::ranges::equal(results[i], expected));
+    }
+
+    index.radius(centers, 1.f, results);
+    index.radius(pool, centers, 1.f, parallel_results);
+    REQUIRE(parallel_results.size() == centers.size());
+    for(std::size_t i = 0; i < centers.size(); ++i)
+    {
+        std::vector<std::uint32_t> expected;
+        bruteForceRadius<float, 3>(points, centers[i], 1.f, expected);
+        REQUIRE(sorted({results[i].begin(), results[i].end()}) == expected);
+        REQUIRE(std::ranges::equal(results[i], parallel_results[i]));
+    }
+}
+
+TEST_CASE("Test KdTree Duplicates") {
+    // Many equal coordinates, on the split planes as well
+    std::vector<Vector2<float>> points;
+    for(int i = 0; i < 40; ++i)
+    {
+        for(int j = 0; j < 40; ++j)
+        {
+            points.push_back({static_cast<float>(i / 4), static_cast<float>(j / 4)});
+        }
+    }
+    const KdTree<float, 2> tree(points);
+    requireBruteForceResults(tree, points, {{3.f, 3.f}, {0.5f, 9.f}, {-4.f, 20.f}}, 1.f, 37);
+}
+
+TEST_CASE("Test UniformGrid Updates") {
+    std::mt19937 rng{5};
+    auto points = randomPoints<3>(3000, rng);
+    const auto centers = randomPoints<3>(40, rng, 12.f);
+    UniformGrid<float, 3> grid(1.f);
+    grid.update(points);
+    REQUIRE(grid.position(17) == points[17]);
+
+    // Incremental updates: small moves stay in their cell, large ones change cell
+    std::uniform_real_distribution<float> step{-0.3f, 0.3f};
+    for(int frame = 0; frame < 5; ++frame)
+    {
+        for(auto & point : points)
+        {
+            point += Vector3<float>{step(rng), step(rng), step(rng) * 20.f};
+        }
+        grid.update(points);
+        REQUIRE(grid.size() == points.size());
+    }
+    requireBruteForceResults(grid, points, centers, 2.f, 5);
+
+    // Isolated points far from each other
+    UniformGrid<float, 3> sparse(0.5f);
+    const std::vector<Vector3f> far{{-1000.f, 0.f, 0.f}, {1000.f, 0.f, 0.f}, {0.f, 0.f, 500.f}};
+    sparse.update(far);
+    requireBruteForceResults(sparse, far, centers, 1.f, 2);
+}
+
+TEST_CASE("Test UniformGrid Insertion") {
+    UniformGrid<float, 2> grid(2.f);
+    REQUIRE(grid.empty());
+    grid.insert(10, {1.f, 1.f});
+    grid.insert(3, {1.5f, 1.f});
+    grid.insert(7, {-5.f, 1.f});
+    REQUIRE(grid.size() == 3);
+    REQUIRE(grid.contains(3));
+    REQUIRE_FALSE(grid.contains(4));
+    REQUIRE_FALSE(grid.contains(100));
+
+    std::vector<std::uint32_t> result;
+    grid.nearest({0.f, 0.f}, 2, result);
+    REQUIRE(result == std::vector<std::uint32_t>{10, 3});
+
+    grid.erase(10);
+    REQUIRE_FALSE(grid.contains(10));
+    REQUIRE(grid.position(3) == Vector2<float>{1.5f, 1.f});
+    grid.update(7, {0.5f, 0.5f});
+    result.clear();
+    grid.nearest({0.f, 0.f}, 5, result);
+    REQUIRE(result == std::vector<std::uint32_t>{7, 3});
+
+    result.clear();
+    grid.radius({1.f, 1.f}, 0.5f, result);
+    REQUIRE(result == std::vector<std::uint32_t>{3});
+
+    grid.clear();
+    REQUIRE(grid.empty());
+    result.clear();
+    grid.nearest({0.f, 0.f}, 5, result);
+    grid.radius({0.f, 0.f}, 5.f, result);
+    REQUIRE(result.empty());
+}
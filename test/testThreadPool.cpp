@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/ThreadPool.hpp"
+
+TEST_CASE("Test ThreadPool Parallel For") {
+    juan::ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<int> visited(10'000, 0);
+    pool.parallelFor(visited.size(), 100, [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            ++visited[i];
+        }
+    });
+    REQUIRE(std::all_of(visited.begin(), visited.end(), [](int count){ return count == 1; }));
+
+    std::size_t calls = 0;
+    pool.parallelFor(0, 10, [&](std::size_t, std::size_t){ ++calls; });
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("Test ThreadPool Nested Parallel For") {
+    juan::ThreadPool pool(2);
+    std::atomic<std::size_t> sum{0};
+    pool.parallelFor(8, 1, [&](std::size_t, std::size_t){
+        pool.parallelFor(100, 10, [&](std::size_t begin, std::size_t end){
+            sum += end - begin;
+        });
+    });
+    REQUIRE(sum == 800);
+}
+
+TEST_CASE("Test ThreadPool Waiting Thread Sleeps") {
+    // The worker sleeps in its chunk while the calling thread waits for it, which must
+    // not burn processor time. A chunk run by the calling thread waits until the worker
+    // has one, so the calling thread cannot run both.
+    juan::ThreadPool pool(1);
+    std::atomic<bool> worker_started{false};
+    const std::clock_t start = std::clock();
+    pool.parallelFor(2, 1, [&](std::size_t, std::size_t){
+        if(pool.threadIndex() == 0)
+        {
+            worker_started = true;
+            worker_started.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        else
+        {
+            worker_started.wait(false);
+        }
+    });
+    const double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    REQUIRE(seconds < 0.1);
+}
+
+TEST_CASE("Test ThreadPool Exceptions") {
+    juan::ThreadPool pool(2);
+    REQUIRE_THROWS_AS(pool.parallelFor(100, 1, [](std::size_t begin, std::size_t){
+        if(begin == 42)
+        {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST_CASE("Test ThreadPool Reduce") {
+    std::vector<float> values(100'000);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1.f / static_cast<float>(i + 1);
+    }
+    auto partialSum = [&](std::size_t begin, std::size_t end){
+        return std::accumulate(values.begin() + static_cast<std::ptrdiff_t>(begin), values.begin() + static_cast<std::ptrdiff_t>(end), 0.f);
+    };
+
+    juan::ThreadPool one(1);
+    juan::ThreadPool four(4);
+    const float expected = one.parallelReduce(values.size(), 1000, 0.f, partialSum, std::plus<>());
+    for(int run = 0; run < 10; ++run)
+    {
+        REQUIRE(four.parallelReduce(values.size(), 1000, 0.f, partialSum, std::plus<>()) == expected);
+    }
+    const float unordered = four.parallelReduce(values.size(), 1000, 0.f, partialSum, std::plus<>(), juan::Reduction::Unordered);
+    REQUIRE(std::abs(unordered - expected) < 1e-3f);
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <type_traits>
 #include <numbers>
 
@@ -111,15 +114,150 @@ TEST_CASE("Test Vector Angle") {
     REQUIRE_THAT(v1.angle(v2), WithinRel(std::numbers::pi_v<float> / 4, .01f));
 }
 
-#include <catch2/benchmark/catch_benchmark.hpp>
+TEST_CASE("Test Vector Matches Scalar Arithmetic") {
+    // Holds for both the generic and the CPPUTILS_VECTOR_SIMD backends
+    const Vector<float, 4> a{0.1f, -2.5f, 1e-3f, 7.25f};
+    const Vector<float, 4> b{3.3f, 0.7f, -1e4f, 0.125f};
+    const Vector<float, 4> sum = a + b;
+    const Vector<float, 4> difference = a - b;
+    float dot{};
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(sum[i] == a[i] + b[i]);
+        REQUIRE(difference[i] == a[i] - b[i]);
+        dot += a[i] * b[i];
+    }
+    REQUIRE(a * b == dot);
 
-TEST_CASE("Benchmark Vector [!benchmark]") {
-    BENCHMARK("Benchmark Vector3i") {
-        constexpr Vector3f a{0.123f, 124.12f, 12.124f};
-        Vector3f b{2121.2f, 70.0f, 112.9f};
-        b.normalize();
-        b = -b;
-        auto c = b / 1.2f;
-        return a * b * c;
-    };
+    const Vector3i c{5, 1, -6};
+    const Vector3i d{-2, 9, 4};
+    REQUIRE(c + d == Vector3i{3, 10, -2});
+    REQUIRE(c - d == Vector3i{7, -8, -10});
+    REQUIRE(c * 3 == Vector3i{15, 3, -18});
+    REQUIRE(c * d == -25);
+
+    Vector3f e{1.f, 2.f, 2.f};
+    e.normalize();
+    REQUIRE(e == Vector3f{1.f / 3.f, 2.f / 3.f, 2.f / 3.f});
+    REQUIRE(Vector3f{0.f, -0.f, 0.f}.is_null());
+}
+
+TEST_CASE("Test Vector Expression Chains") {
+    const Vector3f a{1.5f, -2.f, 0.25f};
+    const Vector3f b{-3.f, 4.5f, 8.f};
+    const Vector3f c{0.1f, 0.2f, 0.3f};
+
+    // Evaluated one operation at a time
+    const Vector3f scaled = b * 1.75f;
+    const Vector3f sum = a + scaled;
+    const Vector3f expected = sum - c;
+    const Vector3f fused = a + b * 1.75f - c;
+    REQUIRE(fused == expected);
+    REQUIRE(a + b * 1.75f - c == expected);
+    REQUIRE((a + b) * c == Vector3f(a + b) * c);
+    REQUIRE(-(a - b) / 2.f == (b - a) / 2.f);
+
+    // Every step converts to the value type, like the eager operators
+    const Vector2i truncated = Vector2i{3, 5} * 0.5 + Vector2i{1, 1};
+    REQUIRE(truncated == Vector2i{2, 3});
+
+    Vector3f v = a;
+    v = v * 2.f + v;
+    REQUIRE(v == a * 3.f);
+    v += b - a;
+    v *= 2.f;
+    REQUIRE(v == (a * 3.f + (b - a)) * 2.f);
+
+    constexpr Vector2i constant = Vector2i{1, 2} * 3 - Vector2i{1, 1};
+    static_assert(constant == Vector2i{2, 5});
+}
+
+namespace
+{
+    [[nodiscard]] Vector3f makeVector(float value) {
+        return Vector3f{value, value * 2.f, -value};
+    }
+}
+
+TEST_CASE("Test Vector Expression Lifetime") {
+    // Temporaries are held by the expression, so it can be kept in an auto variable
+    const auto sum = makeVector(1.f) + makeVector(2.f);
+    const auto chain = (makeVector(1.f) - makeVector(3.f)) * 2.f + makeVector(0.5f);
+    const auto negated = -makeVector(4.f);
+    const auto scaled = 0.5f * makeVector(4.f);
+    REQUIRE(Vector3f(sum) == Vector3f{3.f, 6.f, -3.f});
+    REQUIRE(Vector3f(chain) == Vector3f{-3.5f, -7.f, 3.5f});
+    REQUIRE(Vector3f(negated) == Vector3f{-4.f, -8.f, 4.f});
+    REQUIRE(Vector3f(scaled) == Vector3f{2.f, 4.f, -2.f});
+
+    // Named vectors are still referred to, not copied
+    Vector3f a{1.f, 1.f, 1.f};
+    const auto lazy = a * 2.f;
+    a = Vector3f{2.f, 2.f, 2.f};
+    REQUIRE(Vector3f(lazy) == Vector3f{4.f, 4.f, 4.f});
+}
+
+TEST_CASE("Test Vector Expression Member Functions") {
+    using Catch::Matchers::WithinRel;
+    const Vector3f a{3.f, 0.f, 0.f};
+    const Vector3f b{0.f, 4.f, 0.f};
+    REQUIRE((a + b).length() == 5.f);
+    REQUIRE((a + b).lengthSquared() == 25.f);
+    REQUIRE((a + b).length<double>() == 5.0);
+    REQUIRE((a + b).normalized() == Vector3f(a + b).normalized());
+    REQUIRE((a - a).is_null());
+    REQUIRE(!(a - b).is_null());
+    REQUIRE_THAT((a * 2.f).angle(b), WithinRel(std::numbers::pi_v<float> / 2.f));
+    REQUIRE((a + b).angle(a + b) == 0.f);
+    REQUIRE((a + b)[1] == 4.f);
+    REQUIRE_THAT((makeVector(1.f) + makeVector(1.f)).normalized().length(), WithinRel(1.f));
+
+    constexpr Vector2i side{3, 4};
+    static_assert((side * 2).lengthSquared() == 100);
+}
+
+namespace
+{
+    // The operators against the standard algorithms over the components
+    template <std::size_t SIZE>
+    void checkSizeDispatch() {
+        Vector<float, SIZE> a;
+        Vector<float, SIZE> b;
+        for(std::size_t i = 0; i < SIZE; ++i)
+        {
+            a[i] = 0.1f * static_cast<float>(i) - 3.f;
+            b[i] = 1.f / static_cast<float>(i + 1);
+        }
+        Vector<float, SIZE> expected;
+        std::transform(a.begin(), a.end(), b.begin(), expected.begin(), std::plus<>());
+        REQUIRE(a + b == expected);
+        std::transform(a.begin(), a.end(), expected.begin(), [](float value){ return value * 1.5f; });
+        REQUIRE(a * 1.5f == expected);
+        REQUIRE(a * b == std::inner_product(a.begin(), a.end(), b.begin(), 0.f));
+
+        // The expression refers to the vector it is assigned to
+        Vector<float, SIZE> c = a;
+        c = c * 2.f + c;
+        std::transform(a.begin(), a.end(), expected.begin(), [](float value){ return value * 2.f + value; });
+        REQUIRE(c == expected);
+
+        c[SIZE - 1] += 1.f;
+        REQUIRE(c != expected);
+        REQUIRE(Vector<float, SIZE>(0.f).is_null());
+        REQUIRE(!c.is_null());
+    }
+}
+
+TEST_CASE("Test Vector Size Dispatch") {
+    // Unrolled sizes, one full block, and full blocks followed by a partial one
+    checkSizeDispatch<3>();
+    checkSizeDispatch<8>();
+    checkSizeDispatch<64>();
+    checkSizeDispatch<100>();
+    checkSizeDispatch<1024>();
+
+    constexpr Vector<int, 100> ones(1);
+    static_assert(ones * (ones + ones) == 200);
+    static_assert(ones * 2 - ones == ones);
+    static_assert(!ones.is_null());
 }
@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/VectorArray.hpp"
+
+TEST_CASE("Test VectorArray Constructors") {
+    VectorArray3i empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0);
+
+    VectorArray3i filled(5, Vector3i{1, 2, 3});
+    REQUIRE(filled.size() == 5);
+    REQUIRE(filled.get(4) == Vector3i{1, 2, 3});
+
+    std::vector<Vector3i> vectors{{1, 2, 3}, {4, 5, 6}};
+    VectorArray3i array(vectors);
+    REQUIRE(array.size() == 2);
+    REQUIRE(array.get(0) == vectors[0]);
+    REQUIRE(array.get(1) == vectors[1]);
+    REQUIRE(array.toVectors() == vectors);
+}
+
+TEST_CASE("Test VectorArray Layout") {
+    VectorArray2i array;
+    array.push_back({1, 2});
+    array.push_back({3, 4});
+    array.set(1, {5, 6});
+
+    REQUIRE(array.lane(0)[0] == 1);
+    REQUIRE(array.lane(0)[1] == 5);
+    REQUIRE(array.lane(1)[0] == 2);
+    REQUIRE(array.lane(1)[1] == 6);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.lane(1).data()) % 64 == 0);
+}
+
+TEST_CASE("Test VectorArray Binary Operators") {
+    VectorArray2i v1(std::vector<Vector2i>{{1, 2}, {6, -2}});
+    VectorArray2i v2(std::vector<Vector2i>{{-3, 4}, {0, 1}});
+
+    REQUIRE((v1 + v2).toVectors() == std::vector<Vector2i>{{-2, 6}, {6, -1}});
+    REQUIRE((v1 - v2).toVectors() == std::vector<Vector2i>{{4, -2}, {6, -3}});
+    REQUIRE((v1 * 2).toVectors() == std::vector<Vector2i>{{2, 4}, {12, -4}});
+    REQUIRE((v1 / -2).toVectors() == std::vector<Vector2i>{{0, -1}, {-3, 1}});
+
+    v1 += v2;
+    v1 -= v2;
+    REQUIRE(v1.get(1) == Vector2i{6, -2});
+}
+
+TEST_CASE("Test VectorArray Dot Product And Length") {
+    VectorArray2i v1(std::vector<Vector2i>{{1, -7}, {5, 1}});
+    VectorArray2i v2(std::vector<Vector2i>{{-9, 13}, {5, 1}});
+
+    std::vector<int> dot(2);
+    v1.dot(v2, dot);
+    REQUIRE(dot == std::vector<int>{-100, 26});
+
+    std::vector<int> squared(2);
+    v1.lengthSquared(squared);
+    REQUIRE(squared == std::vector<int>{50, 26});
+
+    std::vector<int> length(2);
+    v1.length(std::span<int>(length));
+    REQUIRE(length == std::vector<int>{7, 5});
+}
+
+TEST_CASE("Test VectorArray Matches Vector") {
+    std::vector<Vector3f> vectors;
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        vectors.push_back({f * 0.5f - 100.f, 3.f - f, f * f * 0.01f});
+    }
+    vectors.push_back({0.f, 0.f, 0.f});
+
+    VectorArray3f array(vectors);
+    array.normalize();
+    std::vector<float> length(vectors.size());
+    VectorArray3f(vectors).length(std::span<float>(length));
+
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(array.get(i) == vectors[i].normalized());
+        REQUIRE(length[i] == vectors[i].length());
+    }
+}
+
+TEST_CASE("Test VectorArray Expression Chains") {
+    std::vector<Vector3f> a;
+    std::vector<Vector3f> b;
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        a.push_back({f * 0.5f - 100.f, 3.f - f, f * f * 0.01f});
+        b.push_back({f, -f * 0.25f, 1.f / (f + 1.f)});
+    }
+    const VectorArray3f lhs(a);
+    const VectorArray3f rhs(b);
+    const Vector3f offset{1.f, 2.f, 3.f};
+
+    const VectorArray3f fused = lhs + rhs * 0.75f - offset;
+    VectorArray3f accumulated = lhs;
+    accumulated += rhs / 3.f;
+    accumulated *= 2.f;
+    for(std::size_t i = 0; i < a.size(); ++i)
+    {
+        REQUIRE(fused.get(i) == a[i] + b[i] * 0.75f - offset);
+        REQUIRE(accumulated.get(i) == (a[i] + b[i] / 3.f) * 2.f);
+    }
+
+    VectorArray3f assigned;
+    assigned = -lhs;
+    REQUIRE(assigned.size() == a.size());
+    REQUIRE(assigned.get(10) == -a[10]);
+    REQUIRE((lhs - rhs).get(20) == a[20] - b[20]);
+}
+
+TEST_CASE("Test VectorArray Expression Lifetime") {
+    const std::vector<Vector2f> values{{1.f, 2.f}, {3.f, 4.f}, {5.f, 6.f}};
+    // The temporary arrays are moved into the expression
+    const auto sum = VectorArray2f(values) + VectorArray2f(values) * 2.f;
+    const VectorArray2f result = sum;
+    REQUIRE(result.size() == values.size());
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(result.get(i) == values[i] * 3.f);
+    }
+}
@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "TestHelpers.hpp"
+#include "../src/Half.hpp"
+#include "../src/VectorFile.hpp"
+
+namespace
+{
+    void overwrite(const std::filesystem::path & path, std::size_t offset, const void * bytes, std::size_t size)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(size));
+    }
+}
+
+TEST_CASE("Test VectorFile Vectors") {
+    const TemporaryFile temporary("vectors.bin");
+    std::vector<Vector3f> vectors(1000);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        const float value = static_cast<float>(i);
+        vectors[i] = {value, -value, value * 0.5f};
+    }
+    writeVectorFile(temporary.path, vectors);
+    REQUIRE(std::filesystem::file_size(temporary.path) == sizeof(VectorFileHeader) + vectors.size() * 3 * sizeof(float));
+
+    MappedVectorFile<float, 3> file(temporary.path);
+    REQUIRE(file.size() == vectors.size());
+    REQUIRE(file.layout() == VectorFileLayout::vectors);
+    REQUIRE(file.header().version == VectorFileHeader::VERSION);
+    REQUIRE(file.components().size() == vectors.size() * 3);
+    REQUIRE(file.components()[3 * 7 + 2] == 3.5f);
+    for(std::size_t i = 0; i < vectors.size(); ++i)
+    {
+        REQUIRE(file.get(i) == vectors[i]);
+    }
+    // Vector3f is padded with CPPUTILS_VECTOR_SIMD, then only components() is available
+    [&](const auto & mapped) {
+        if constexpr (requires { mapped.vectors(); })
+        {
+            REQUIRE(std::vector<Vector3f>(mapped.vectors().begin(), mapped.vectors().end()) == vectors);
+        }
+    }(file);
+
+    // Moving keeps the mapping
+    MappedVectorFile<float, 3> moved(std::move(file));
+    REQUIRE(moved.get(999) == vectors[999]);
+
+    const TemporaryFile empty("empty.bin");
+    writeVectorFile(empty.path, std::vector<Vector<Half, 4>>{});
+    REQUIRE(MappedVectorFile<Half, 4>(empty.path).empty());
+}
+
+TEST_CASE("Test VectorFile Lanes") {
+    const TemporaryFile temporary("lanes.bin");
+    VectorArray<std::int16_t, 2> array;
+    for(std::int16_t i = 0; i < 100; ++i)
+    {
+        array.push_back({i, static_cast<std::int16_t>(-i)});
+    }
+    writeVectorFile(temporary.path, array);
+
+    const MappedVectorFile<std::int16_t, 2> file(temporary.path);
+    REQUIRE(file.layout() == VectorFileLayout::lanes);
+    REQUIRE(file.size() == 100);
+    for(std::size_t c = 0; c < 2; ++c)
+    {
+        REQUIRE(reinterpret_cast<std::uintptr_t>(file.lane(c).data()) % VectorFileHeader::DATA_ALIGNMENT == 0);
+        REQUIRE(std::vector<std::int16_t>(file.lane(c).begin(), file.lane(c).end()) == std::vector<std::int16_t>(array.lane(c).begin(), array.lane(c).end()));
+    }
+    REQUIRE(file.get(42) == array.get(42));
+}
+
+TEST_CASE("Test VectorFile Write Errors") {
+    REQUIRE_THROWS_AS(writeVectorFile("/missing/directory/vectors.bin", std::vector<Vector3f>(3)), std::ios_base::failure);
+    if(std::filesystem::exists("/dev/full"))
+    {
+        // Small enough to stay in the stream buffer until the file is closed
+        REQUIRE_THROWS_AS(writeVectorFile("/dev/full", std::vector<Vector3f>(3)), std::ios_base::failure);
+        VectorArray<float, 3> array;
+        array.push_back({1.f, 2.f, 3.f});
+        REQUIRE_THROWS_AS(writeVectorFile("/dev/full", array), std::ios_base::failure);
+    }
+}
+
+TEST_CASE("Test VectorFile Validation") {
+    const TemporaryFile temporary("invalid.bin");
+    const std::vector<Vector<double, 2>> vectors(10, Vector<double, 2>{1., 2.});
+    writeVectorFile(temporary.path, vectors);
+    REQUIRE_NOTHROW(MappedVectorFile<double, 2>(temporary.path));
+
+    // Other component types and sizes
+    REQUIRE_THROWS_AS((MappedVectorFile<float, 2>(temporary.path)), std::runtime_error);
+    REQUIRE_THROWS_AS((MappedVectorFile<std::int64_t, 2>(temporary.path)), std::runtime_error);
+    REQUIRE_THROWS_AS((MappedVectorFile<double, 3>(temporary.path)), std::runtime_error);
+    REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path / "missing")), std::system_error);
+
+    SECTION("Truncated") {
+        std::filesystem::resize_file(temporary.path, std::filesystem::file_size(temporary.path) - 1);
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+        std::filesystem::resize_file(temporary.path, 10);
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+    }
+    SECTION("Huge count") {
+        const std::uint64_t count = ~std::uint64_t{0} / 4;
+        overwrite(temporary.path, offsetof(VectorFileHeader, count), &count, sizeof(count));
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+    }
+    SECTION("Other byte order") {
+        const std::uint32_t swapped = 0x04030201u;
+        overwrite(temporary.path, offsetof(VectorFileHeader, byte_order), &swapped, sizeof(swapped));
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+    }
+    SECTION("Newer version") {
+        const std::uint32_t version = VectorFileHeader::VERSION + 1;
+        overwrite(temporary.path, offsetof(VectorFileHeader, version), &version, sizeof(version));
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+    }
+    SECTION("Not a vector file") {
+        overwrite(temporary.path, 0, "text", 4);
+        REQUIRE_THROWS_AS((MappedVectorFile<double, 2>(temporary.path)), std::runtime_error);
+    }
+}
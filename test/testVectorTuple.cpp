@@ -1,5 +1,12 @@
-#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <tuple>
 #include <numbers>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -125,15 +132,136 @@ TEST_CASE("Test VectorTuple Angle") {
     REQUIRE_THAT(v1.angle(v2), WithinRel(std::numbers::pi_v<float> / 4, .01f));
 }
 
-#include <catch2/benchmark/catch_benchmark.hpp>
+TEST_CASE("Test VectorTuple Large Size") {
+    constexpr auto ones = VectorTuplei<256>::from_val<1>();
+    constexpr auto twos = VectorTuplei<256>::from_val<2>();
+    static_assert(ones * twos == 512);
+    static_assert(ones.lengthSquared() == 256);
+    static_assert(ones + ones == twos);
+    static_assert(ones < twos);
+
+    auto v = twos;
+    v.get<255>() = 10;
+    v -= ones;
+    REQUIRE(v.get<0>() == 1);
+    REQUIRE(v.get<255>() == 9);
+    REQUIRE(v * ones == 255 + 9);
+    REQUIRE(VectorTuplef<256>(v).get<255>() == 9.f);
+    REQUIRE(-v * -1 == v);
+}
+
+TEST_CASE("Test VectorTuple Contiguous Large Size") {
+    using Vector100i = ContiguousVectorTuple<int, 100>;
+    constexpr auto ones = Vector100i::from_val<1>();
+    constexpr auto twos = Vector100i::from_val<2>();
+    static_assert(ones * twos == 200);
+    static_assert(ones + ones == twos);
+    static_assert(twos - ones == ones);
+    static_assert(-ones * 2 == -twos);
+
+    // Same values as the element by element helpers of the tuple storage
+    ContiguousVectorTuple<float, 100> a;
+    ContiguousVectorTuple<float, 100> b;
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        a.data()[i] = 0.1f * static_cast<float>(i) - 3.f;
+        b.data()[i] = 1.f / static_cast<float>(i + 1);
+    }
+    const VectorTuplef<100> tuple_a(a);
+    const VectorTuplef<100> tuple_b(b);
+    REQUIRE(VectorTuplef<100>(a + b) == tuple_a + tuple_b);
+    REQUIRE(VectorTuplef<100>(a * 1.5f) == tuple_a * 1.5f);
+    REQUIRE(VectorTuplef<100>(-a) == -tuple_a);
+    REQUIRE(a * b == tuple_a * tuple_b);
+    a += b;
+    REQUIRE(VectorTuplef<100>(a) == tuple_a + tuple_b);
+}
+
+TEST_CASE("Test VectorTuple Contiguous Storage") {
+    using Vector4f = ContiguousVectorTuple<float, 4, 16>;
+    static_assert(sizeof(Vector4f) == 4 * sizeof(float));
+    static_assert(alignof(Vector4f) == 16);
+    static_assert(alignof(ContiguousVectorTuple<float, 3>) == alignof(float));
+    static_assert(sizeof(ContiguousVectorTuple<float, 3, 16>) == 16);
+    static_assert(std::is_trivially_copyable_v<Vector4f>);
+    static_assert(std::is_standard_layout_v<Vector4f>);
+
+    Vector4f v1{1.f, 2.f, 3.f, 4.f};
+    REQUIRE(v1.data()[0] == 1.f);
+    REQUIRE(v1.data()[3] == 4.f);
+    v1.get<2>() = 5.f;
+    REQUIRE(v1.data()[2] == 5.f);
+
+    // Same results as the tuple storage
+    const VectorTuple<float, 4> t1 = v1;
+    const VectorTuple<float, 4> t2{-1.f, 0.5f, 2.f, 8.f};
+    const Vector4f v2 = t2;
+    REQUIRE(VectorTuple<float, 4>(v1 + v2) == t1 + t2);
+    REQUIRE(VectorTuple<float, 4>(v1 * 3.f - v2 / 2.f) == t1 * 3.f - t2 / 2.f);
+    REQUIRE(v1 * v2 == t1 * t2);
+    REQUIRE(v1.length() == t1.length());
+    REQUIRE(Vector4f::from_val<2.f>() == Vector4f{2.f, 2.f, 2.f, 2.f});
+    REQUIRE(ContiguousVectorTuple<int, 4>(v1) == ContiguousVectorTuple<int, 4>{1, 2, 5, 4});
+}
+
+TEST_CASE("Test VectorTuple Contiguous Spans") {
+    using Vector3i = ContiguousVectorTuple<int, 3>;
+    std::vector<Vector3i> vectors{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+
+    auto components = Vector3i::components(vectors);
+    REQUIRE(components.size() == 9);
+    for(std::size_t i = 0; i < components.size(); ++i)
+    {
+        REQUIRE(components[i] == static_cast<int>(i) + 1);
+        components[i] *= 2;
+    }
+    REQUIRE(vectors[1] == Vector3i{8, 10, 12});
+    REQUIRE(Vector3i::components(std::span<const Vector3i>()).empty());
+    static_assert(std::is_same_v<decltype(Vector3i::components(std::as_const(vectors))), std::span<const int>>);
+
+    std::vector<Vector3i> copy(vectors.size());
+    const auto bytes = std::as_bytes(std::span(vectors));
+    std::memcpy(copy.data(), bytes.data(), bytes.size());
+    REQUIRE(copy == vectors);
+}
+
+TEST_CASE("Test VectorTuple Mixed Components") {
+    using Record = MixedVectorTuple<float, std::int16_t, std::int16_t>;
+    static_assert(std::is_same_v<Record::value_type, float>);
+    static_assert(std::is_same_v<Record::component_type<1>, std::int16_t>);
+    static_assert(sizeof(Record) < sizeof(VectorTuple3f));
+    static_assert(sizeof(MixedVectorTuple<std::int16_t, std::int16_t, std::int16_t>) == sizeof(VectorTuple3f) / 2);
+
+    const Record r1{1.5f, std::int16_t{10}, std::int16_t{-3}};
+    const Record r2{0.25f, std::int16_t{32767}, std::int16_t{4}};
+
+    // Component wise results are converted back to the component types
+    const Record sum = r1 + r2;
+    REQUIRE(sum.get<0>() == 1.75f);
+    REQUIRE(sum.get<1>() == static_cast<std::int16_t>(32777));
+    REQUIRE(sum.get<2>() == 1);
+    REQUIRE((r1 * 0.5f).get<1>() == 5);
+    REQUIRE((r1 * 0.5f).get<2>() == -1);
+    REQUIRE((-r1).get<2>() == 3);
+
+    // The dot product is accumulated in the common type of the component products
+    static_assert(std::is_same_v<decltype(r1 * r2), float>);
+    REQUIRE(r1 * r2 == 1.5f * 0.25f + 10.f * 32767.f - 12.f);
+    REQUIRE(r1.lengthSquared() == 2.25f + 100.f + 9.f);
+
+    // Conversion to and from full precision vectors
+    const VectorTuple3f full = r1;
+    REQUIRE(full == VectorTuple3f{1.5f, 10.f, -3.f});
+    REQUIRE(Record(VectorTuple3f{2.f, 7.9f, -7.9f}) == Record{2.f, std::int16_t{7}, std::int16_t{-7}});
+    REQUIRE(Record::from_val<3.f>() == Record{3.f, std::int16_t{3}, std::int16_t{3}});
+}
 
-TEST_CASE("Benchmark VectorTuple [!benchmark]") {
-    BENCHMARK("Benchmark VectorTuple3i") {
-        constexpr VectorTuple3f a{0.123f, 124.12f, 12.124f};
-        VectorTuple3f b{2121.2f, 70.0f, 112.9f};
-        b.normalize();
-        b = -b;
-        auto c = b / 1.2f;
-        return a * b * c;
-    };
+TEST_CASE("Test VectorTuple Helpers Promotion") {
+    const std::tuple<std::int16_t, float> lhs{std::int16_t{300}, 1.5f};
+    const std::tuple<int, double> rhs{100000, 0.25};
+    static_assert(std::is_same_v<decltype(tupleDotProduct(lhs, rhs)), double>);
+    REQUIRE(tupleDotProduct(lhs, rhs) == 300. * 100000. + 1.5 * 0.25);
+    const auto difference = tupleElementWiseOp(rhs, lhs, std::minus<>());
+    static_assert(std::is_same_v<decltype(difference), const std::tuple<int, double>>);
+    REQUIRE(difference == std::tuple<int, double>{99700, -1.25});
 }